@@ -0,0 +1,454 @@
+/*
+ * 围棋游戏系统 - Part 1: 位棋盘局面表示实现
+ * 负责人: 251880102 胡哲
+ * 实现: 多字移位、邻域膨胀、洪泛找串、气数与提子判断、Tromp-Taylor数子
+ */
+
+#include "Part1_Bitboard.h"
+#include "Part1_Rules.h"
+#include <string.h>
+
+// 定义 BB_NO_SIMD 可强制使用标量实现
+#if !defined(BB_NO_SIMD) && defined(__AVX2__)
+#define BB_USE_AVX2 1
+#include <immintrin.h>
+#elif !defined(BB_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define BB_USE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+// 64位字的置位数
+static inline int popcount64(uint64_t v) {
+#if defined(_MSC_VER) && defined(_M_X64)
+    return (int)__popcnt64(v);
+#elif defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(v);
+#else
+    v = v - ((v >> 1) & 0x5555555555555555ULL);
+    v = (v & 0x3333333333333333ULL) + ((v >> 2) & 0x3333333333333333ULL);
+    v = (v + (v >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int)((v * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+// 编译期生成的掩码: 棋盘内的点、除去第一列(y == 0)、除去最后一列(y == 18)
+static constexpr Bitboard buildMask(int kind) {
+    Bitboard b = {};
+    for (int p = 0; p < BB_POINTS; p++) {
+        int y = p % BB_SIZE;
+        if ((kind == 1 && y == 0) || (kind == 2 && y == BB_SIZE - 1)) continue;
+        b.w[p >> 6] |= 1ULL << (p & 63);
+    }
+    return b;
+}
+
+static constexpr Bitboard maskBoard = buildMask(0);
+static constexpr Bitboard maskNotFirst = buildMask(1);
+static constexpr Bitboard maskNotLast = buildMask(2);
+
+#if defined(BB_USE_AVX2)
+
+// 256位x2 的整体左移K位(低位向高位), 跨字进位
+template <int K>
+static inline void shiftUp(__m256i lo, __m256i hi, __m256i* outLo, __m256i* outHi) {
+    __m256i zero = _mm256_setzero_si256();
+    __m256i loUp = _mm256_permute4x64_epi64(lo, _MM_SHUFFLE(2, 1, 0, 3));
+    __m256i hiUp = _mm256_permute4x64_epi64(hi, _MM_SHUFFLE(2, 1, 0, 3));
+    __m256i loCarry = _mm256_blend_epi32(loUp, zero, 0x03);
+    __m256i hiCarry = _mm256_blend_epi32(hiUp, loUp, 0x03);
+    *outLo = _mm256_or_si256(_mm256_slli_epi64(lo, K), _mm256_srli_epi64(loCarry, 64 - K));
+    *outHi = _mm256_or_si256(_mm256_slli_epi64(hi, K), _mm256_srli_epi64(hiCarry, 64 - K));
+}
+
+// 256位x2 的整体右移K位(高位向低位), 跨字进位
+template <int K>
+static inline void shiftDown(__m256i lo, __m256i hi, __m256i* outLo, __m256i* outHi) {
+    __m256i zero = _mm256_setzero_si256();
+    __m256i loDown = _mm256_permute4x64_epi64(lo, _MM_SHUFFLE(0, 3, 2, 1));
+    __m256i hiDown = _mm256_permute4x64_epi64(hi, _MM_SHUFFLE(0, 3, 2, 1));
+    __m256i loCarry = _mm256_blend_epi32(loDown, hiDown, 0xC0);
+    __m256i hiCarry = _mm256_blend_epi32(hiDown, zero, 0xC0);
+    *outLo = _mm256_or_si256(_mm256_srli_epi64(lo, K), _mm256_slli_epi64(loCarry, 64 - K));
+    *outHi = _mm256_or_si256(_mm256_srli_epi64(hi, K), _mm256_slli_epi64(hiCarry, 64 - K));
+}
+
+static inline void dilateWords(const uint64_t* in, uint64_t* out) {
+    __m256i lo = _mm256_load_si256((const __m256i*)in);
+    __m256i hi = _mm256_load_si256((const __m256i*)(in + 4));
+    __m256i aLo, aHi, bLo, bHi, cLo, cHi, dLo, dHi;
+
+    shiftUp<1>(lo, hi, &aLo, &aHi);
+    shiftDown<1>(lo, hi, &bLo, &bHi);
+    shiftUp<BB_SIZE>(lo, hi, &cLo, &cHi);
+    shiftDown<BB_SIZE>(lo, hi, &dLo, &dHi);
+
+    aLo = _mm256_and_si256(aLo, _mm256_load_si256((const __m256i*)maskNotFirst.w));
+    aHi = _mm256_and_si256(aHi, _mm256_load_si256((const __m256i*)(maskNotFirst.w + 4)));
+    bLo = _mm256_and_si256(bLo, _mm256_load_si256((const __m256i*)maskNotLast.w));
+    bHi = _mm256_and_si256(bHi, _mm256_load_si256((const __m256i*)(maskNotLast.w + 4)));
+
+    lo = _mm256_or_si256(_mm256_or_si256(lo, aLo), _mm256_or_si256(bLo, _mm256_or_si256(cLo, dLo)));
+    hi = _mm256_or_si256(_mm256_or_si256(hi, aHi), _mm256_or_si256(bHi, _mm256_or_si256(cHi, dHi)));
+    lo = _mm256_and_si256(lo, _mm256_load_si256((const __m256i*)maskBoard.w));
+    hi = _mm256_and_si256(hi, _mm256_load_si256((const __m256i*)(maskBoard.w + 4)));
+
+    _mm256_store_si256((__m256i*)out, lo);
+    _mm256_store_si256((__m256i*)(out + 4), hi);
+}
+
+static inline void andWords(const uint64_t* a, const uint64_t* b, uint64_t* out) {
+    for (int i = 0; i < BB_WORDS; i += 4) {
+        __m256i v = _mm256_and_si256(_mm256_load_si256((const __m256i*)(a + i)),
+            _mm256_load_si256((const __m256i*)(b + i)));
+        _mm256_store_si256((__m256i*)(out + i), v);
+    }
+}
+
+static inline int equalWords(const uint64_t* a, const uint64_t* b) {
+    __m256i lo = _mm256_xor_si256(_mm256_load_si256((const __m256i*)a),
+        _mm256_load_si256((const __m256i*)b));
+    __m256i hi = _mm256_xor_si256(_mm256_load_si256((const __m256i*)(a + 4)),
+        _mm256_load_si256((const __m256i*)(b + 4)));
+    __m256i d = _mm256_or_si256(lo, hi);
+    return _mm256_testz_si256(d, d);
+}
+
+static inline int andIsEmpty(const uint64_t* a, const uint64_t* b) {
+    return _mm256_testz_si256(_mm256_load_si256((const __m256i*)a), _mm256_load_si256((const __m256i*)b)) &&
+        _mm256_testz_si256(_mm256_load_si256((const __m256i*)(a + 4)), _mm256_load_si256((const __m256i*)(b + 4)));
+}
+
+#elif defined(BB_USE_SSE2)
+
+// 128位x4 的整体移位, 进位取自相邻寄存器
+static inline __m128i carryFromBelow(__m128i prev, __m128i cur) {
+    return _mm_castpd_si128(_mm_shuffle_pd(_mm_castsi128_pd(prev), _mm_castsi128_pd(cur), 1));
+}
+
+static inline void dilateWords(const uint64_t* in, uint64_t* out) {
+    __m128i r[4];
+    for (int i = 0; i < 4; i++) r[i] = _mm_load_si128((const __m128i*)(in + i * 2));
+    __m128i zero = _mm_setzero_si128();
+
+    for (int i = 0; i < 4; i++) {
+        __m128i below = carryFromBelow(i > 0 ? r[i - 1] : zero, r[i]); // [上一字, 本寄存器低字]
+        __m128i above = carryFromBelow(r[i], i < 3 ? r[i + 1] : zero); // [本寄存器高字, 下一字]
+
+        __m128i up1 = _mm_or_si128(_mm_slli_epi64(r[i], 1), _mm_srli_epi64(below, 63));
+        __m128i down1 = _mm_or_si128(_mm_srli_epi64(r[i], 1), _mm_slli_epi64(above, 63));
+        __m128i upN = _mm_or_si128(_mm_slli_epi64(r[i], BB_SIZE), _mm_srli_epi64(below, 64 - BB_SIZE));
+        __m128i downN = _mm_or_si128(_mm_srli_epi64(r[i], BB_SIZE), _mm_slli_epi64(above, 64 - BB_SIZE));
+
+        up1 = _mm_and_si128(up1, _mm_load_si128((const __m128i*)(maskNotFirst.w + i * 2)));
+        down1 = _mm_and_si128(down1, _mm_load_si128((const __m128i*)(maskNotLast.w + i * 2)));
+
+        __m128i v = _mm_or_si128(_mm_or_si128(r[i], up1), _mm_or_si128(down1, _mm_or_si128(upN, downN)));
+        v = _mm_and_si128(v, _mm_load_si128((const __m128i*)(maskBoard.w + i * 2)));
+        _mm_store_si128((__m128i*)(out + i * 2), v);
+    }
+}
+
+static inline void andWords(const uint64_t* a, const uint64_t* b, uint64_t* out) {
+    for (int i = 0; i < BB_WORDS; i += 2) {
+        __m128i v = _mm_and_si128(_mm_load_si128((const __m128i*)(a + i)),
+            _mm_load_si128((const __m128i*)(b + i)));
+        _mm_store_si128((__m128i*)(out + i), v);
+    }
+}
+
+static inline int equalWords(const uint64_t* a, const uint64_t* b) {
+    __m128i acc = _mm_setzero_si128();
+    for (int i = 0; i < BB_WORDS; i += 2) {
+        acc = _mm_or_si128(acc, _mm_xor_si128(_mm_load_si128((const __m128i*)(a + i)),
+            _mm_load_si128((const __m128i*)(b + i))));
+    }
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(acc, _mm_setzero_si128())) == 0xFFFF;
+}
+
+static inline int andIsEmpty(const uint64_t* a, const uint64_t* b) {
+    __m128i acc = _mm_setzero_si128();
+    for (int i = 0; i < BB_WORDS; i += 2) {
+        acc = _mm_or_si128(acc, _mm_and_si128(_mm_load_si128((const __m128i*)(a + i)),
+            _mm_load_si128((const __m128i*)(b + i))));
+    }
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(acc, _mm_setzero_si128())) == 0xFFFF;
+}
+
+#else
+
+// 标量回退实现
+static inline void dilateWords(const uint64_t* in, uint64_t* out) {
+    for (int i = 0; i < BB_WORDS; i++) {
+        uint64_t below = i > 0 ? in[i - 1] : 0;
+        uint64_t above = i < BB_WORDS - 1 ? in[i + 1] : 0;
+        uint64_t up1 = ((in[i] << 1) | (below >> 63)) & maskNotFirst.w[i];
+        uint64_t down1 = ((in[i] >> 1) | (above << 63)) & maskNotLast.w[i];
+        uint64_t upN = (in[i] << BB_SIZE) | (below >> (64 - BB_SIZE));
+        uint64_t downN = (in[i] >> BB_SIZE) | (above << (64 - BB_SIZE));
+        out[i] = (in[i] | up1 | down1 | upN | downN) & maskBoard.w[i];
+    }
+}
+
+static inline void andWords(const uint64_t* a, const uint64_t* b, uint64_t* out) {
+    for (int i = 0; i < BB_WORDS; i++) out[i] = a[i] & b[i];
+}
+
+static inline int equalWords(const uint64_t* a, const uint64_t* b) {
+    uint64_t d = 0;
+    for (int i = 0; i < BB_WORDS; i++) d |= a[i] ^ b[i];
+    return d == 0;
+}
+
+static inline int andIsEmpty(const uint64_t* a, const uint64_t* b) {
+    uint64_t d = 0;
+    for (int i = 0; i < BB_WORDS; i++) d |= a[i] & b[i];
+    return d == 0;
+}
+
+#endif
+
+// 当前使用的内核名称(用于性能报告)
+const char* bitboardKernelName() {
+#if defined(BB_USE_AVX2)
+    return "avx2";
+#elif defined(BB_USE_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+void bbClear(Bitboard* b) {
+    memset(b->w, 0, sizeof(b->w));
+}
+
+void bbSet(Bitboard* b, int p) {
+    b->w[p >> 6] |= 1ULL << (p & 63);
+}
+
+void bbReset(Bitboard* b, int p) {
+    b->w[p >> 6] &= ~(1ULL << (p & 63));
+}
+
+int bbTest(const Bitboard* b, int p) {
+    return (int)((b->w[p >> 6] >> (p & 63)) & 1);
+}
+
+int bbIsEmpty(const Bitboard* b) {
+    return andIsEmpty(b->w, b->w);
+}
+
+int bbPopcount(const Bitboard* b) {
+    int count = 0;
+    for (int i = 0; i < BB_WORDS; i++) count += popcount64(b->w[i]);
+    return count;
+}
+
+// 邻域膨胀: 原集合加上它上下左右的点
+void bbDilate(Bitboard* out, const Bitboard* b) {
+    dilateWords(b->w, out->w);
+}
+
+// 洪泛: 从 seed 出发在 mask 内反复膨胀直到不再变化
+void bbFloodFill(Bitboard* out, const Bitboard* seed, const Bitboard* mask) {
+    Bitboard cur, next;
+    andWords(seed->w, mask->w, cur.w);
+    for (;;) {
+        dilateWords(cur.w, next.w);
+        andWords(next.w, mask->w, next.w);
+        if (equalWords(next.w, cur.w)) break;
+        cur = next;
+    }
+    *out = cur;
+}
+
+// 棋串的气数: 膨胀后与空点求交再计数
+int bbLiberties(const Bitboard* chain, const Bitboard* empty) {
+    Bitboard libs;
+    dilateWords(chain->w, libs.w);
+    andWords(libs.w, empty->w, libs.w);
+    return bbPopcount(&libs);
+}
+
+// 串是否还有气(只需判断交集是否为空, 不必计数)
+static int chainHasLiberty(const Bitboard* chain, const Bitboard* empty) {
+    Bitboard around;
+    dilateWords(chain->w, around.w);
+    return !andIsEmpty(around.w, empty->w);
+}
+
+void bitPosInit(BitPosition* pos) {
+    bbClear(&pos->stones[1]);
+    bbClear(&pos->stones[2]);
+    pos->stones[0] = maskBoard;
+    pos->currentPlayer = 1;
+}
+
+void bitPosFromBoard(BitPosition* pos, const int board[BB_SIZE][BB_SIZE], int currentPlayer) {
+    bbClear(&pos->stones[0]);
+    bbClear(&pos->stones[1]);
+    bbClear(&pos->stones[2]);
+    for (int i = 0; i < BB_SIZE; i++) {
+        for (int j = 0; j < BB_SIZE; j++) {
+            bbSet(&pos->stones[board[i][j]], i * BB_SIZE + j);
+        }
+    }
+    pos->currentPlayer = currentPlayer;
+}
+
+void bitPosToBoard(const BitPosition* pos, int board[BB_SIZE][BB_SIZE]) {
+    for (int i = 0; i < BB_SIZE; i++) {
+        for (int j = 0; j < BB_SIZE; j++) {
+            int p = i * BB_SIZE + j;
+            board[i][j] = bbTest(&pos->stones[1], p) ? 1 : (bbTest(&pos->stones[2], p) ? 2 : 0);
+        }
+    }
+}
+
+// 一行 cells(从 y == 0 开始的 size 个字节)中等于 color 的点, 第 y 位对应第 y 列
+static inline uint32_t rowBits(const unsigned char* row, int color, uint32_t rowMask) {
+#if defined(BB_USE_AVX2)
+    __m256i v = _mm256_loadu_si256((const __m256i*)row);
+    return (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8((char)color))) & rowMask;
+#elif defined(BB_USE_SSE2)
+    __m128i c = _mm_set1_epi8((char)color);
+    uint32_t lo = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)row), c));
+    uint32_t hi = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(row + 16)), c));
+    return (lo | hi << 16) & rowMask;
+#else
+    uint32_t bits = 0;
+    for (int y = 0; y < BB_SIZE; y++) {
+        bits |= (uint32_t)(row[y] == color) << y;
+    }
+    return bits & rowMask;
+#endif
+}
+
+// 把 rowBits 的结果放到第 x 行
+static inline void orRow(Bitboard* b, int x, uint32_t bits) {
+    int p = x * BB_SIZE;
+    int shift = p & 63;
+    b->w[p >> 6] |= (uint64_t)bits << shift;
+    if (shift > 64 - BB_SIZE) {
+        b->w[(p >> 6) + 1] |= (uint64_t)bits >> (64 - shift);
+    }
+}
+
+// 直接从 GameState.cells 的带边框棋盘逐行生成(每行一次比较, 不逐点置位)
+// 小棋盘 size 路以外的点既不是棋子也不是空点, 洪泛不会越出棋盘
+// 每行按 32 字节读取, 最后一行也在 cells 数组之内
+void bitPosFromCells(BitPosition* pos, const unsigned char* cells, int size, int currentPlayer) {
+    uint32_t rowMask = (1u << size) - 1;
+    bbClear(&pos->stones[0]);
+    bbClear(&pos->stones[1]);
+    bbClear(&pos->stones[2]);
+    for (int x = 0; x < size; x++) {
+        const unsigned char* row = cells + PAD_INDEX(x, 0);
+        orRow(&pos->stones[0], x, rowBits(row, EMPTY, rowMask));
+        orRow(&pos->stones[1], x, rowBits(row, BLACK, rowMask));
+        orRow(&pos->stones[2], x, rowBits(row, WHITE, rowMask));
+    }
+    pos->currentPlayer = currentPlayer;
+}
+
+// 在(x, y)落子后会被提掉的对方棋子, 结果写入 captured
+static void findCaptures(const BitPosition* pos, int x, int y, const Bitboard* empty, Bitboard* captured) {
+    int opponent = 3 - pos->currentPlayer;
+    int dx[] = { -1, 1, 0, 0 };
+    int dy[] = { 0, 0, -1, 1 };
+
+    bbClear(captured);
+    for (int i = 0; i < 4; i++) {
+        int nx = x + dx[i];
+        int ny = y + dy[i];
+        if (nx < 0 || nx >= BB_SIZE || ny < 0 || ny >= BB_SIZE) continue;
+
+        int q = nx * BB_SIZE + ny;
+        if (!bbTest(&pos->stones[opponent], q) || bbTest(captured, q)) continue;
+
+        Bitboard seed, chain;
+        bbClear(&seed);
+        bbSet(&seed, q);
+        bbFloodFill(&chain, &seed, &pos->stones[opponent]);
+        if (!chainHasLiberty(&chain, empty)) {
+            for (int k = 0; k < BB_WORDS; k++) captured->w[k] |= chain.w[k];
+        }
+    }
+}
+
+// 判断合法落子(禁止自杀)
+int bitPosIsValidMove(const BitPosition* pos, int x, int y) {
+    if (x < 0 || x >= BB_SIZE || y < 0 || y >= BB_SIZE) return 0;
+    int p = x * BB_SIZE + y;
+    if (!bbTest(&pos->stones[0], p)) return 0;
+
+    Bitboard stone, around, empty;
+    bbClear(&stone);
+    bbSet(&stone, p);
+    empty = pos->stones[0];
+    bbReset(&empty, p);
+
+    // 有相邻空点必然合法
+    bbDilate(&around, &stone);
+    if (!andIsEmpty(around.w, empty.w)) return 1;
+
+    Bitboard captured;
+    findCaptures(pos, x, y, &empty, &captured);
+    if (!bbIsEmpty(&captured)) return 1;
+
+    Bitboard own = pos->stones[pos->currentPlayer];
+    bbSet(&own, p);
+    Bitboard chain;
+    bbFloodFill(&chain, &stone, &own);
+    return chainHasLiberty(&chain, &empty);
+}
+
+// 落子并提子, 返回提子数; 不合法时返回 -1 且局面不变
+int bitPosPlaceStone(BitPosition* pos, int x, int y) {
+    if (!bitPosIsValidMove(pos, x, y)) return -1;
+
+    int p = x * BB_SIZE + y;
+    int color = pos->currentPlayer;
+    int opponent = 3 - color;
+
+    bbReset(&pos->stones[0], p);
+    bbSet(&pos->stones[color], p);
+
+    Bitboard captured;
+    findCaptures(pos, x, y, &pos->stones[0], &captured);
+    for (int k = 0; k < BB_WORDS; k++) {
+        pos->stones[opponent].w[k] &= ~captured.w[k];
+        pos->stones[0].w[k] |= captured.w[k];
+    }
+
+    pos->currentPlayer = opponent;
+    return bbPopcount(&captured);
+}
+
+// Tromp-Taylor 归属: 各方的棋子加上只能到达本方棋子的空点
+void bitPosAreaOwner(const BitPosition* pos, Bitboard* blackArea, Bitboard* whiteArea) {
+    const Bitboard* empty = &pos->stones[0];
+    Bitboard seed, reachBlack, reachWhite;
+
+    bbDilate(&seed, &pos->stones[1]);
+    bbFloodFill(&reachBlack, &seed, empty);
+    bbDilate(&seed, &pos->stones[2]);
+    bbFloodFill(&reachWhite, &seed, empty);
+
+    for (int k = 0; k < BB_WORDS; k++) {
+        blackArea->w[k] = pos->stones[1].w[k] | (reachBlack.w[k] & ~reachWhite.w[k]);
+        whiteArea->w[k] = pos->stones[2].w[k] | (reachWhite.w[k] & ~reachBlack.w[k]);
+    }
+}
+
+// Tromp-Taylor 数子: 棋子数加上只能到达本方棋子的空点数
+void bitPosAreaScore(const BitPosition* pos, int* blackArea, int* whiteArea) {
+    Bitboard black, white;
+    bitPosAreaOwner(pos, &black, &white);
+    *blackArea = bbPopcount(&black);
+    *whiteArea = bbPopcount(&white);
+}
\ No newline at end of file
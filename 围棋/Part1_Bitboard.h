@@ -0,0 +1,51 @@
+/*
+ * 围棋游戏系统 - Part 1: 位棋盘局面表示
+ * 负责人: 251880102 胡哲
+ * 包含: 361位位棋盘、移位邻域扩张、膨胀式洪泛、合法性/提子/数子
+ * 说明: 不依赖 EasyX, 可单独在 Linux 下编译; 有 AVX2/SSE2 实现和纯标量回退
+ */
+
+#ifndef PART1_BITBOARD_H
+#define PART1_BITBOARD_H
+
+#include <stdint.h>
+
+// 位棋盘尺寸: 下标 p = x * BB_SIZE + y, 与 GameState 的棋串下标一致
+#define BB_SIZE 19
+#define BB_POINTS (BB_SIZE * BB_SIZE)
+#define BB_WORDS 8 // 361位只用前6个字, 补足8字便于按256位对齐处理
+
+// 361位位棋盘
+typedef struct {
+    alignas(32) uint64_t w[BB_WORDS];
+} Bitboard;
+
+// 位棋盘局面: stones 按颜色下标(0-空 1-黑 2-白, 与 EMPTY/BLACK/WHITE 一致)
+typedef struct {
+    Bitboard stones[3];
+    int currentPlayer;
+} BitPosition;
+
+// 位棋盘基本操作
+void bbClear(Bitboard* b);
+void bbSet(Bitboard* b, int p);
+void bbReset(Bitboard* b, int p);
+int bbTest(const Bitboard* b, int p);
+int bbIsEmpty(const Bitboard* b);
+int bbPopcount(const Bitboard* b);
+void bbDilate(Bitboard* out, const Bitboard* b);
+void bbFloodFill(Bitboard* out, const Bitboard* seed, const Bitboard* mask);
+int bbLiberties(const Bitboard* chain, const Bitboard* empty);
+
+// 位棋盘局面操作
+void bitPosInit(BitPosition* pos);
+void bitPosFromBoard(BitPosition* pos, const int board[BB_SIZE][BB_SIZE], int currentPlayer);
+void bitPosToBoard(const BitPosition* pos, int board[BB_SIZE][BB_SIZE]);
+void bitPosFromCells(BitPosition* pos, const unsigned char* cells, int size, int currentPlayer);
+int bitPosIsValidMove(const BitPosition* pos, int x, int y);
+int bitPosPlaceStone(BitPosition* pos, int x, int y);
+void bitPosAreaOwner(const BitPosition* pos, Bitboard* blackArea, Bitboard* whiteArea);
+void bitPosAreaScore(const BitPosition* pos, int* blackArea, int* whiteArea);
+const char* bitboardKernelName();
+
+#endif // PART1_BITBOARD_H
\ No newline at end of file
@@ -0,0 +1,124 @@
+/*
+ * 围棋游戏系统 - Part 1: 棋盘下标表
+ * 负责人: 251880102 胡哲
+ * 包含: 带边框一维棋盘的下标换算、邻点和斜角偏移, 以及 9/13/19 路各自的空棋盘(含 3x3 模式码)、星位、到边距离和角/边/中腹区域表
+ * 说明: 全部在编译期生成; 各种大小都按 19 路的步长存放, 盘外的点都是 OFF_BOARD 哨兵,
+ *       邻点就是固定偏移, 循环里不用判断越界
+ */
+
+#ifndef PART1_BOARDTABLES_H
+#define PART1_BOARDTABLES_H
+
+#include "Part1_Rules.h"
+
+// 区域: 两个方向都靠近边线为角, 一个方向靠近边线为边, 其余为中腹
+// 靠近边线指 19/13 路在四线以内, 9 路在三线以内
+#define REGION_CENTER 0
+#define REGION_SIDE 1
+#define REGION_CORNER 2
+
+#define STAR_POINTS 9
+
+// 上下左右四个邻点的偏移, 顺序与原先的 dx/dy 相同: (x-1), (x+1), (y-1), (y+1)
+static constexpr int neighborOffset[4] = { -PAD_SIZE, PAD_SIZE, -1, 1 };
+// 四个斜角的偏移
+static constexpr int diagonalOffset[4] = { -PAD_SIZE - 1, -PAD_SIZE + 1, PAD_SIZE - 1, PAD_SIZE + 1 };
+
+// 3x3 模式码中 8 个邻点的偏移, 按行从左上到右下(跳过中心); 第 k 个点的颜色在第 2k、2k+1 位
+// patternOffset[7 - k] == -patternOffset[k], 即 p 在其第 k 个邻点的模式码中位于第 7 - k 个
+static constexpr int patternOffset[8] = {
+    -PAD_SIZE - 1, -PAD_SIZE, -PAD_SIZE + 1, -1, 1, PAD_SIZE - 1, PAD_SIZE, PAD_SIZE + 1
+};
+
+// 下标换算, 与棋盘大小无关(小棋盘占用左上角)
+typedef struct {
+    short padOf[MAX_POINTS];              // 普通下标 x * BOARD_SIZE + y -> 带边框下标
+    short denseOf[PADDED_POINTS];         // 带边框下标 -> 普通下标, 边框上为 -1
+} BoardTables;
+
+static constexpr BoardTables buildBoardTables() {
+    BoardTables t = {};
+    for (int i = 0; i < PADDED_POINTS; i++) {
+        t.denseOf[i] = -1;
+    }
+    for (int x = 0; x < BOARD_SIZE; x++) {
+        for (int y = 0; y < BOARD_SIZE; y++) {
+            t.padOf[x * BOARD_SIZE + y] = (short)PAD_INDEX(x, y);
+            t.denseOf[PAD_INDEX(x, y)] = (short)(x * BOARD_SIZE + y);
+        }
+    }
+    return t;
+}
+
+static constexpr BoardTables boardTables = buildBoardTables();
+
+// 每种棋盘大小一份的表, 下标同上; 盘外的点 edgeDistance 为 -1
+typedef struct {
+    int size;
+    unsigned char emptyCells[PADDED_POINTS]; // 空棋盘: 盘内 EMPTY, 其余(含边框)为 OFF_BOARD
+    unsigned short emptyPatterns[PADDED_POINTS]; // 空棋盘上各点的 3x3 模式码(只有盘内的点有意义)
+    signed char edgeDistance[MAX_POINTS]; // 到最近边线的距离, 一线为 0
+    unsigned char region[MAX_POINTS];     // REGION_*
+    unsigned char isStar[MAX_POINTS];
+    int starCount;
+    short starPoints[STAR_POINTS];        // 星位的普通下标
+} SizeTables;
+
+template <int N>
+constexpr SizeTables buildSizeTables() {
+    SizeTables t = {};
+    t.size = N;
+    for (int i = 0; i < PADDED_POINTS; i++) {
+        t.emptyCells[i] = OFF_BOARD;
+    }
+    for (int p = 0; p < MAX_POINTS; p++) {
+        t.edgeDistance[p] = -1;
+    }
+
+    int near = N >= 13 ? 3 : 2; // 靠近边线的范围, 也是角上星位到边的距离
+    for (int x = 0; x < N; x++) {
+        for (int y = 0; y < N; y++) {
+            int p = x * BOARD_SIZE + y;
+            t.emptyCells[PAD_INDEX(x, y)] = EMPTY;
+
+            int edgeX = x < N - 1 - x ? x : N - 1 - x;
+            int edgeY = y < N - 1 - y ? y : N - 1 - y;
+            t.edgeDistance[p] = (signed char)(edgeX < edgeY ? edgeX : edgeY);
+            t.region[p] = (unsigned char)((edgeX <= near) + (edgeY <= near));
+
+            // 四角和天元; 19 路另有四个边星
+            int starX = edgeX == near || x == N / 2;
+            int starY = edgeY == near || y == N / 2;
+            if (starX && starY && (edgeX == edgeY || N > 13)) {
+                t.isStar[p] = 1;
+                t.starPoints[t.starCount++] = (short)p;
+            }
+        }
+    }
+
+    for (int x = 0; x < N; x++) {
+        for (int y = 0; y < N; y++) {
+            int p = PAD_INDEX(x, y);
+            int code = 0;
+            for (int k = 0; k < 8; k++) {
+                code |= t.emptyCells[p + patternOffset[k]] << (2 * k);
+            }
+            t.emptyPatterns[p] = (unsigned short)code;
+        }
+    }
+    return t;
+}
+
+template <int N>
+constexpr SizeTables sizeTables = buildSizeTables<N>();
+
+// 对应棋盘大小的表, 不支持的大小按 19 路
+static inline const SizeTables* sizeTablesFor(int size) {
+    switch (size) {
+    case 9: return &sizeTables<9>;
+    case 13: return &sizeTables<13>;
+    default: return &sizeTables<19>;
+    }
+}
+
+#endif // PART1_BOARDTABLES_H
\ No newline at end of file
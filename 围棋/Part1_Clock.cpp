@@ -0,0 +1,84 @@
+/*
+ * 围棋游戏系统 - Part 1: 对局计时实现
+ * 负责人: 251880102 胡哲
+ * 实现: 先用基本时间, 用完后进入读秒: 一手在一次读秒内下完则下一手重新计时,
+ *       超过则用掉一次读秒; 最后一次读秒也用完(或没有读秒时基本时间用完)判超时负
+ */
+
+#include "Part1_Clock.h"
+#include <chrono>
+
+// 新对局: 双方 mainSeconds 秒基本时间, periods 次 periodSeconds 秒读秒; 都为 0 时不限时
+void clockInit(GameClock* clock, int mainSeconds, int periods, int periodSeconds) {
+    if (mainSeconds < 0) mainSeconds = 0;
+    if (periods < 0 || periodSeconds <= 0) periods = 0;
+
+    clock->enabled = mainSeconds > 0 || periods > 0;
+    clock->stopped = 0;
+    clock->flagged = 0;
+    clock->periodMs = periods > 0 ? periodSeconds * 1000 : 0;
+    for (int side = BLACK; side <= WHITE; side++) {
+        clock->mainMs[side] = mainSeconds * 1000;
+        clock->periods[side] = periods;
+        clock->periodLeftMs[side] = clock->periodMs;
+    }
+}
+
+// side 方的钟走 elapsedMs 毫秒; 本次走表使 side 超时时返回 1
+int clockTick(GameClock* clock, int side, int elapsedMs) {
+    if (!clockRunning(clock) || elapsedMs <= 0) return 0;
+
+    int used = elapsedMs < clock->mainMs[side] ? elapsedMs : clock->mainMs[side];
+    clock->mainMs[side] -= used;
+    elapsedMs -= used;
+
+    while (elapsedMs > 0 && clock->periods[side] > 0) {
+        if (elapsedMs < clock->periodLeftMs[side]) {
+            clock->periodLeftMs[side] -= elapsedMs;
+            return 0;
+        }
+        // 本次读秒用完, 换下一次
+        elapsedMs -= clock->periodLeftMs[side];
+        clock->periods[side]--;
+        clock->periodLeftMs[side] = clock->periods[side] > 0 ? clock->periodMs : 0;
+    }
+    if (clock->mainMs[side] > 0 || clock->periods[side] > 0) return 0;
+
+    // 基本时间和读秒都用完
+    clock->flagged = side;
+    clock->stopped = 1;
+    return 1;
+}
+
+// side 方落子后调用: 在读秒中时下一手重新计时
+void clockPunch(GameClock* clock, int side) {
+    if (!clockRunning(clock)) return;
+    if (clock->mainMs[side] == 0 && clock->periods[side] > 0) {
+        clock->periodLeftMs[side] = clock->periodMs;
+    }
+}
+
+// 停表, 之后走表不再有效果
+void clockStop(GameClock* clock) {
+    clock->stopped = 1;
+}
+
+int clockRunning(const GameClock* clock) {
+    return clock->enabled && !clock->stopped;
+}
+
+int clockInByoYomi(const GameClock* clock, int side) {
+    return clock->enabled && clock->mainMs[side] == 0 && clock->periods[side] > 0;
+}
+
+// side 方这一手最多还能用的时间: 剩余基本时间加上本次读秒(之后的读秒次数不算)
+int clockRemainingMs(const GameClock* clock, int side) {
+    if (clock->flagged == side) return 0;
+    return clock->mainMs[side] + (clock->periods[side] > 0 ? clock->periodLeftMs[side] : 0);
+}
+
+// 单调递增的毫秒时间, 只用来求两次走表之间的间隔
+long long clockNowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+/*
+ * 围棋游戏系统 - Part 1: 对局计时
+ * 负责人: 251880102 胡哲
+ * 包含: 基本时间 + 日本式读秒的棋钟: 走子方的钟按主循环给出的经过时间走, 落子后读秒重新计时
+ * 说明: 不依赖 EasyX; 只记录时间, 不读系统时钟(clockNowMs 除外), 由调用方决定何时走表
+ */
+
+#ifndef PART1_CLOCK_H
+#define PART1_CLOCK_H
+
+#include "Part1_Rules.h"
+
+// 棋钟, 数组下标为 BLACK/WHITE
+typedef struct {
+    int enabled;          // 0 表示不限时
+    int stopped;          // 非 0 时停表(有一方超时或对局已结束)
+    int flagged;          // 超时负的一方, 0 表示没有
+    int mainMs[3];        // 剩余的基本时间
+    int periods[3];       // 剩余的读秒次数(含正在用的一次)
+    int periodLeftMs[3];  // 进入读秒后, 本次读秒剩余的时间
+    int periodMs;         // 每次读秒的时长
+} GameClock;
+
+void clockInit(GameClock* clock, int mainSeconds, int periods, int periodSeconds);
+int clockTick(GameClock* clock, int side, int elapsedMs);
+void clockPunch(GameClock* clock, int side);
+void clockStop(GameClock* clock);
+int clockRunning(const GameClock* clock);
+int clockInByoYomi(const GameClock* clock, int side);
+int clockRemainingMs(const GameClock* clock, int side);
+long long clockNowMs();
+
+#endif // PART1_CLOCK_H
\ No newline at end of file
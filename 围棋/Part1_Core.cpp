@@ -1,329 +1,325 @@
-/*
- * ΧϷϵͳ - Part 1: Ϸ߼ʵ
- * : 251880102 
- * ʵ: Ϸʼù߼жϡ߼ȡ
- */
-
-#include "Part1_Core.h"
-
- // ȫֱ
-GameState gameState;
-HistoryMove history[MAX_HISTORY];
-int historyCount = 0;
-GameConfig config;
-int gameMode = 0;
-int lastMoveX = -1, lastMoveY = -1;
-int hintX = -1, hintY = -1;
-IMAGE imgBoard, imgWhiteStone, imgBlackStone;
-int imagesLoaded = 0;
-
-// ʼϷ
-void initGame() {
-    memset(&gameState, 0, sizeof(GameState));
-    gameState.currentPlayer = BLACK;
-    gameState.blackTime = config.timeLimit * 60;
-    gameState.whiteTime = config.timeLimit * 60;
-    historyCount = 0;
-    lastMoveX = lastMoveY = -1;
-    hintX = hintY = -1;
-
-    loadConfig("config.txt");
-}
-
-// ļ
-void loadConfig(const char* filename) {
-    FILE* fp = fopen(filename, "r");
-    if (fp == NULL) {
-        // Ĭ
-        config.boardSize = BOARD_SIZE;
-        config.komi = 7.5f;
-        config.timeLimit = 30;
-        config.enableSound = 1;
-        config.enableAnimation = 1;
-        config.aiDifficulty = 2;
-        strcpy(config.playerBlackName, "ڷ");
-        strcpy(config.playerWhiteName, "׷");
-        saveConfig(filename);
-        return;
-    }
-
-    fscanf(fp, "BoardSize=%d\n", &config.boardSize);
-    fscanf(fp, "Komi=%f\n", &config.komi);
-    fscanf(fp, "TimeLimit=%d\n", &config.timeLimit);
-    fscanf(fp, "EnableSound=%d\n", &config.enableSound);
-    fscanf(fp, "EnableAnimation=%d\n", &config.enableAnimation);
-    fscanf(fp, "AIDifficulty=%d\n", &config.aiDifficulty);
-    fscanf(fp, "BlackPlayer=%[^\n]\n", config.playerBlackName);
-    fscanf(fp, "WhitePlayer=%[^\n]\n", config.playerWhiteName);
-
-    fclose(fp);
-}
-
-// ļ
-void saveConfig(const char* filename) {
-    FILE* fp = fopen(filename, "w");
-    if (fp == NULL) return;
-
-    fprintf(fp, "BoardSize=%d\n", config.boardSize);
-    fprintf(fp, "Komi=%.1f\n", config.komi);
-    fprintf(fp, "TimeLimit=%d\n", config.timeLimit);
-    fprintf(fp, "EnableSound=%d\n", config.enableSound);
-    fprintf(fp, "EnableAnimation=%d\n", config.enableAnimation);
-    fprintf(fp, "AIDifficulty=%d\n", config.aiDifficulty);
-    fprintf(fp, "BlackPlayer=%s\n", config.playerBlackName);
-    fprintf(fp, "WhitePlayer=%s\n", config.playerWhiteName);
-
-    fclose(fp);
-}
-
-// жǷݹ
-int hasLiberty(int x, int y, int color, int visited[BOARD_SIZE][BOARD_SIZE]) {
-    if (x < 0 || x >= BOARD_SIZE || y < 0 || y >= BOARD_SIZE) return 0;
-    if (visited[x][y]) return 0;
-
-    visited[x][y] = 1;
-
-    if (gameState.board[x][y] == EMPTY) return 1;
-    if (gameState.board[x][y] != color) return 0;
-
-    return hasLiberty(x - 1, y, color, visited) ||
-        hasLiberty(x + 1, y, color, visited) ||
-        hasLiberty(x, y - 1, color, visited) ||
-        hasLiberty(x, y + 1, color, visited);
-}
-
-// Ƴӣݹ
-void removeStones(int x, int y, int color) {
-    if (x < 0 || x >= BOARD_SIZE || y < 0 || y >= BOARD_SIZE) return;
-    if (gameState.board[x][y] != color) return;
-
-    gameState.board[x][y] = EMPTY;
-
-    removeStones(x - 1, y, color);
-    removeStones(x + 1, y, color);
-    removeStones(x, y - 1, color);
-    removeStones(x, y + 1, color);
-}
-
-// 鲢
-int checkCapture(int x, int y, int color) {
-    int opponent = (color == BLACK) ? WHITE : BLACK;
-    int captured = 0;
-    int dx[] = { -1, 1, 0, 0 };
-    int dy[] = { 0, 0, -1, 1 };
-
-    for (int i = 0; i < 4; i++) {
-        int nx = x + dx[i];
-        int ny = y + dy[i];
-
-        if (nx >= 0 && nx < BOARD_SIZE && ny >= 0 && ny < BOARD_SIZE) {
-            if (gameState.board[nx][ny] == opponent) {
-                int visited[BOARD_SIZE][BOARD_SIZE] = { 0 };
-                if (!hasLiberty(nx, ny, opponent, visited)) {
-                    // Ҫߵ
-                    for (int p = 0; p < BOARD_SIZE; p++) {
-                        for (int q = 0; q < BOARD_SIZE; q++) {
-                            if (visited[p][q] && gameState.board[p][q] == opponent) {
-                                captured++;
-                            }
-                        }
-                    }
-                    removeStones(nx, ny, opponent);
-                }
-            }
-        }
-    }
-
-    return captured;
-}
-
-// жϺϷ
-int isValidMove(int x, int y) {
-    if (x < 0 || x >= BOARD_SIZE || y < 0 || y >= BOARD_SIZE) return 0;
-    if (gameState.board[x][y] != EMPTY) return 0;
-
-    // ʱӼɱ
-    gameState.board[x][y] = gameState.currentPlayer;
-
-    // ȼǷܳ
-    int opponent = (gameState.currentPlayer == BLACK) ? WHITE : BLACK;
-    int dx[] = { -1, 1, 0, 0 };
-    int dy[] = { 0, 0, -1, 1 };
-
-    for (int i = 0; i < 4; i++) {
-        int nx = x + dx[i];
-        int ny = y + dy[i];
-        if (nx >= 0 && nx < BOARD_SIZE && ny >= 0 && ny < BOARD_SIZE) {
-            if (gameState.board[nx][ny] == opponent) {
-                int visited[BOARD_SIZE][BOARD_SIZE] = { 0 };
-                if (!hasLiberty(nx, ny, opponent, visited)) {
-                    gameState.board[x][y] = EMPTY;
-                    return 1; // ܳ,ɱ
-                }
-            }
-        }
-    }
-
-    // ԼǷ
-    int visited[BOARD_SIZE][BOARD_SIZE] = { 0 };
-    int valid = hasLiberty(x, y, gameState.currentPlayer, visited);
-
-    gameState.board[x][y] = EMPTY;
-    return valid;
-}
-
-// 
-void placeStone(int x, int y) {
-    if (!isValidMove(x, y)) return;
-
-    // ʷ
-    if (historyCount < MAX_HISTORY) {
-        history[historyCount].x = x;
-        history[historyCount].y = y;
-        history[historyCount].player = gameState.currentPlayer;
-        memcpy(history[historyCount].boardSnapshot, gameState.board,
-            sizeof(gameState.board));
-        history[historyCount].timestamp = time(NULL);
-        historyCount++;
-    }
-
-    gameState.board[x][y] = gameState.currentPlayer;
-    int captured = checkCapture(x, y, gameState.currentPlayer);
-
-    gameState.lastCaptureCount = captured;
-    history[historyCount - 1].capturedStones = captured;
-
-    if (gameState.currentPlayer == BLACK) {
-        gameState.blackCaptures += captured;
-    }
-    else {
-        gameState.whiteCaptures += captured;
-    }
-
-    lastMoveX = x;
-    lastMoveY = y;
-    gameState.moveCount++;
-    gameState.currentPlayer = (gameState.currentPlayer == BLACK) ? WHITE : BLACK;
-    hintX = hintY = -1;
-}
-
-// 
-void undoMove() {
-    if (historyCount == 0) {
-        MessageBox(GetHWnd(), _T("޷!"), _T("ʾ"), MB_OK);
-        return;
-    }
-
-    historyCount--;
-    memcpy(gameState.board, history[historyCount].boardSnapshot,
-        sizeof(gameState.board));
-
-    gameState.currentPlayer = history[historyCount].player;
-    gameState.moveCount--;
-
-    // ָ
-    gameState.blackCaptures = 0;
-    gameState.whiteCaptures = 0;
-    for (int i = 0; i < historyCount; i++) {
-        if (history[i].player == BLACK) {
-            gameState.blackCaptures += history[i].capturedStones;
-        }
-        else {
-            gameState.whiteCaptures += history[i].capturedStones;
-        }
-    }
-
-    if (historyCount > 0) {
-        lastMoveX = history[historyCount - 1].x;
-        lastMoveY = history[historyCount - 1].y;
-    }
-    else {
-        lastMoveX = lastMoveY = -1;
-    }
-}
-
-// Ϸ
-void saveGame(const char* filename) {
-    FILE* fp = fopen(filename, "w");
-    if (fp == NULL) {
-        MessageBox(GetHWnd(), _T("ʧ!"), _T(""), MB_OK);
-        return;
-    }
-
-    fprintf(fp, "%d %d %d %d %d\n", gameState.currentPlayer,
-        gameState.blackCaptures, gameState.whiteCaptures,
-        gameState.moveCount, historyCount);
-
-    for (int i = 0; i < BOARD_SIZE; i++) {
-        for (int j = 0; j < BOARD_SIZE; j++) {
-            fprintf(fp, "%d ", gameState.board[i][j]);
-        }
-        fprintf(fp, "\n");
-    }
-
-    for (int i = 0; i < historyCount; i++) {
-        fprintf(fp, "%d %d %d %d\n", history[i].x, history[i].y,
-            history[i].player, history[i].capturedStones);
-    }
-
-    fclose(fp);
-    MessageBox(GetHWnd(), _T("ɹ!"), _T("ʾ"), MB_OK);
-}
-
-// Ϸ
-void loadGame(const char* filename) {
-    FILE* fp = fopen(filename, "r");
-    if (fp == NULL) {
-        MessageBox(GetHWnd(), _T("δҵ浵ļ!"), _T(""), MB_OK);
-        return;
-    }
-
-    fscanf(fp, "%d %d %d %d %d", &gameState.currentPlayer,
-        &gameState.blackCaptures, &gameState.whiteCaptures,
-        &gameState.moveCount, &historyCount);
-
-    for (int i = 0; i < BOARD_SIZE; i++) {
-        for (int j = 0; j < BOARD_SIZE; j++) {
-            fscanf(fp, "%d", &gameState.board[i][j]);
-        }
-    }
-
-    for (int i = 0; i < historyCount; i++) {
-        fscanf(fp, "%d %d %d %d", &history[i].x, &history[i].y,
-            &history[i].player, &history[i].capturedStones);
-    }
-
-    if (historyCount > 0) {
-        lastMoveX = history[historyCount - 1].x;
-        lastMoveY = history[historyCount - 1].y;
-    }
-
-    fclose(fp);
-    MessageBox(GetHWnd(), _T("ɹ!"), _T("ʾ"), MB_OK);
-}
-
-// ڵĿ
-int countTerritory(int x, int y, int* owner, int visited[BOARD_SIZE][BOARD_SIZE]) {
-    if (x < 0 || x >= BOARD_SIZE || y < 0 || y >= BOARD_SIZE) return 0;
-    if (visited[x][y]) return 0;
-
-    visited[x][y] = 1;
-
-    if (gameState.board[x][y] != EMPTY) {
-        if (*owner == EMPTY) {
-            *owner = gameState.board[x][y];
-        }
-        else if (*owner != gameState.board[x][y]) {
-            *owner = -1; // ϵ
-        }
-        return 0;
-    }
-
-    int count = 1;
-    count += countTerritory(x - 1, y, owner, visited);
-    count += countTerritory(x + 1, y, owner, visited);
-    count += countTerritory(x, y - 1, owner, visited);
-    count += countTerritory(x, y + 1, owner, visited);
-
-    return count;
+/*
+ * 围棋游戏系统 - Part 1: 核心游戏逻辑实现
+ * 负责人: 251880102 忽哲
+ * 实现: 游戏初始化、配置管理、落子逻辑、气的判断、提子逻辑、存取档
+ */
+
+#include "Part1_Core.h"
+#include "Part3_EvalQueue.h" // 网络估值队列参数的默认值
+
+ // 全局变量定义
+Position game;              // 界面使用的对局, 下面几个名字是它的成员的别名
+GameState& gameState = game.state;
+HistoryMove* const history = game.history;
+int& historyCount = game.historyCount;
+int& historyTop = game.historyTop;
+GameConfig config;
+GameClock gameClock;        // 对局的棋钟, 由主循环走表
+int gameMode = 0;
+int lastMoveX = -1, lastMoveY = -1;
+int hintX = -1, hintY = -1;
+IMAGE imgBoard, imgWhiteStone, imgBlackStone;
+int imagesLoaded = 0;
+
+// 初始化游戏: 先读配置, 棋盘大小在这里定下, 之后规则和 AI 都按 gameState.size 选用对应的实现
+void initGame() {
+    loadConfig("config.txt");
+
+    posInit(&game, config.boardSize);
+    config.boardSize = gameState.size; // 不支持的大小已按 19 路处理
+    clockInit(&gameClock, config.timeLimit * 60, config.byoYomiPeriods, config.byoYomiSeconds);
+    syncClockTimes();
+    lastMoveX = lastMoveY = -1;
+    hintX = hintY = -1;
+}
+
+// 把棋钟上双方这一手还能用的时间(秒, 向上取整)记到 gameState.blackTime/whiteTime
+void syncClockTimes() {
+    gameState.blackTime = (clockRemainingMs(&gameClock, BLACK) + 999) / 1000;
+    gameState.whiteTime = (clockRemainingMs(&gameClock, WHITE) + 999) / 1000;
+}
+
+// 加载配置文件
+void loadConfig(const char* filename) {
+    FILE* fp = fopen(filename, "r");
+    if (fp == NULL) {
+        // 默认配置
+        config.boardSize = BOARD_SIZE;
+        config.komi = 7.5f;
+        config.timeLimit = 30;
+        config.byoYomiPeriods = 3;
+        config.byoYomiSeconds = 30;
+        config.enableSound = 1;
+        config.enableAnimation = 1;
+        config.aiDifficulty = 2;
+        config.evalBatchSize = EVAL_DEFAULT_BATCH;
+        config.evalMaxWaitUs = EVAL_DEFAULT_WAIT_US;
+        config.evalCacheEntries = EVAL_DEFAULT_CACHE;
+        config.aiPlayouts = 0;
+        config.aiTimeMs = 0;
+        config.aiThreads = 0;
+        config.aiPonder = 1;
+        config.showOwnership = 0;
+        config.ownershipPlayouts = 200;
+        config.networkFile[0] = '\0';
+        strcpy(config.playerBlackName, "黑方");
+        strcpy(config.playerWhiteName, "白方");
+        saveConfig(filename);
+        return;
+    }
+
+    // 旧配置文件没有的项保持默认值
+    config.byoYomiPeriods = 3;
+    config.byoYomiSeconds = 30;
+    config.evalBatchSize = EVAL_DEFAULT_BATCH;
+    config.evalMaxWaitUs = EVAL_DEFAULT_WAIT_US;
+    config.evalCacheEntries = EVAL_DEFAULT_CACHE;
+    config.aiPlayouts = 0;
+    config.aiTimeMs = 0;
+    config.aiThreads = 0;
+    config.aiPonder = 1;
+    config.showOwnership = 0;
+    config.ownershipPlayouts = 200;
+    config.networkFile[0] = '\0';
+
+    fscanf(fp, "BoardSize=%d\n", &config.boardSize);
+    fscanf(fp, "Komi=%f\n", &config.komi);
+    fscanf(fp, "TimeLimit=%d\n", &config.timeLimit);
+    fscanf(fp, "ByoYomiPeriods=%d\n", &config.byoYomiPeriods);
+    fscanf(fp, "ByoYomiSeconds=%d\n", &config.byoYomiSeconds);
+    fscanf(fp, "EnableSound=%d\n", &config.enableSound);
+    fscanf(fp, "EnableAnimation=%d\n", &config.enableAnimation);
+    fscanf(fp, "AIDifficulty=%d\n", &config.aiDifficulty);
+    fscanf(fp, "EvalBatchSize=%d\n", &config.evalBatchSize);
+    fscanf(fp, "EvalMaxWaitUs=%d\n", &config.evalMaxWaitUs);
+    fscanf(fp, "EvalCacheEntries=%d\n", &config.evalCacheEntries);
+    fscanf(fp, "BlackPlayer=%[^\n]\n", config.playerBlackName);
+    fscanf(fp, "WhitePlayer=%[^\n]\n", config.playerWhiteName);
+    fscanf(fp, "AIPlayouts=%d\n", &config.aiPlayouts);
+    fscanf(fp, "AITimeMs=%d\n", &config.aiTimeMs);
+    fscanf(fp, "AIThreads=%d\n", &config.aiThreads);
+    fscanf(fp, "AIPonder=%d\n", &config.aiPonder);
+    fscanf(fp, "ShowOwnership=%d\n", &config.showOwnership);
+    fscanf(fp, "OwnershipPlayouts=%d\n", &config.ownershipPlayouts);
+    fscanf(fp, "NetworkFile=%259[^\n]", config.networkFile); // 可以为空, 换行单独跳过
+    fscanf(fp, "\n");
+
+    fclose(fp);
+}
+
+// 保存配置文件
+void saveConfig(const char* filename) {
+    FILE* fp = fopen(filename, "w");
+    if (fp == NULL) return;
+
+    fprintf(fp, "BoardSize=%d\n", config.boardSize);
+    fprintf(fp, "Komi=%.1f\n", config.komi);
+    fprintf(fp, "TimeLimit=%d\n", config.timeLimit);
+    fprintf(fp, "ByoYomiPeriods=%d\n", config.byoYomiPeriods);
+    fprintf(fp, "ByoYomiSeconds=%d\n", config.byoYomiSeconds);
+    fprintf(fp, "EnableSound=%d\n", config.enableSound);
+    fprintf(fp, "EnableAnimation=%d\n", config.enableAnimation);
+    fprintf(fp, "AIDifficulty=%d\n", config.aiDifficulty);
+    fprintf(fp, "EvalBatchSize=%d\n", config.evalBatchSize);
+    fprintf(fp, "EvalMaxWaitUs=%d\n", config.evalMaxWaitUs);
+    fprintf(fp, "EvalCacheEntries=%d\n", config.evalCacheEntries);
+    fprintf(fp, "BlackPlayer=%s\n", config.playerBlackName);
+    fprintf(fp, "WhitePlayer=%s\n", config.playerWhiteName);
+    fprintf(fp, "AIPlayouts=%d\n", config.aiPlayouts);
+    fprintf(fp, "AITimeMs=%d\n", config.aiTimeMs);
+    fprintf(fp, "AIThreads=%d\n", config.aiThreads);
+    fprintf(fp, "AIPonder=%d\n", config.aiPonder);
+    fprintf(fp, "ShowOwnership=%d\n", config.showOwnership);
+    fprintf(fp, "OwnershipPlayouts=%d\n", config.ownershipPlayouts);
+    fprintf(fp, "NetworkFile=%s\n", config.networkFile);
+
+    fclose(fp);
+}
+
+// 根据棋盘重建全部棋串信息(载入或恢复局面后调用)
+void rebuildChains() {
+    stateRebuildChains(&gameState);
+}
+
+// 当前一方在空点(x, y)落子后的全盘哈希
+unsigned long long hashAfterMove(int x, int y, int color) {
+    return stateHashAfterMove(&gameState, x, y, color);
+}
+
+// 清空已出现局面集合
+void clearPositionHistory() {
+    posClearSeen(&game);
+}
+
+// 记录一个已出现的局面
+void recordPosition(unsigned long long hash) {
+    posRecordSeen(&game, hash);
+}
+
+// 移除一个局面(悔棋时)
+void forgetPosition(unsigned long long hash) {
+    posForgetSeen(&game, hash);
+}
+
+// 局面是否出现过
+int positionSeen(unsigned long long hash) {
+    return posSeen(&game, hash);
+}
+
+// 棋串的实际气数, 只遍历该串
+int chainLiberties(int x, int y) {
+    return stateLiberties(&gameState, x, y);
+}
+
+// 棋子所在的串是否被叫吃
+int isInAtari(int x, int y) {
+    return stateInAtari(&gameState, x, y);
+}
+
+// 在空点(x, y)下color能提掉的子数, 不改动棋盘
+int captureSizeAt(int x, int y, int color) {
+    return stateCaptureSize(&gameState, x, y, color);
+}
+
+// 移除棋子所在的整串
+void removeStones(int x, int y, int color) {
+    if (x < 0 || x >= gameState.size || y < 0 || y >= gameState.size) return;
+    if (gameState.board[x][y] != color) return;
+
+    stateRemoveChain(&gameState, x, y, NULL);
+}
+
+// 检查并提子: 提走(x, y)相邻的无气对方棋串
+int checkCapture(int x, int y, int color) {
+    return stateCaptureAround(&gameState, x, y, color, NULL);
+}
+
+// 判断合法落子: 规则判断之外再加全局同形禁止
+int isValidMove(int x, int y) {
+    return posIsLegal(&game, x, y);
+}
+
+// 最后一手的位置随棋谱更新
+static void updateLastMove() {
+    if (historyCount > 0) {
+        lastMoveX = history[historyCount - 1].x;
+        lastMoveY = history[historyCount - 1].y;
+    }
+    else {
+        lastMoveX = lastMoveY = -1;
+    }
+    hintX = hintY = -1;
+}
+
+// 落子; 落子方在读秒中时下一手重新计时
+void placeStone(int x, int y) {
+    int player = gameState.currentPlayer;
+    if (!posMakeMove(&game, x, y)) return;
+    clockPunch(&gameClock, player);
+    syncClockTimes();
+    updateLastMove();
+}
+
+// 悔棋: 拿掉落下的子, 放回被提的子
+void undoMove() {
+    if (!posUnmakeMove(&game)) {
+        MessageBox(GetHWnd(), _T("无法悔棋!"), _T("提示"), MB_OK);
+        return;
+    }
+    updateLastMove();
+}
+
+// 重做: 重新执行最近悔掉的一手
+void redoMove() {
+    if (!posRedoMove(&game)) {
+        MessageBox(GetHWnd(), _T("无法重做!"), _T("提示"), MB_OK);
+        return;
+    }
+    updateLastMove();
+}
+
+// 保存游戏
+void saveGame(const char* filename) {
+    FILE* fp = fopen(filename, "w");
+    if (fp == NULL) {
+        MessageBox(GetHWnd(), _T("保存失败!"), _T("错误"), MB_OK);
+        return;
+    }
+
+    fprintf(fp, "%d %d %d %d %d\n", gameState.currentPlayer,
+        gameState.blackCaptures, gameState.whiteCaptures,
+        gameState.moveCount, historyCount);
+
+    for (int i = 0; i < BOARD_SIZE; i++) {
+        for (int j = 0; j < BOARD_SIZE; j++) {
+            fprintf(fp, "%d ", gameState.board[i][j]);
+        }
+        fprintf(fp, "\n");
+    }
+
+    for (int i = 0; i < historyCount; i++) {
+        fprintf(fp, "%d %d %d %d\n", history[i].x, history[i].y,
+            history[i].player, history[i].capturedStones);
+    }
+    fprintf(fp, "BoardSize=%d\n", gameState.size);
+
+    fclose(fp);
+    MessageBox(GetHWnd(), _T("保存成功!"), _T("提示"), MB_OK);
+}
+
+// 载入游戏
+void loadGame(const char* filename) {
+    FILE* fp = fopen(filename, "r");
+    if (fp == NULL) {
+        MessageBox(GetHWnd(), _T("未找到存档文件!"), _T("错误"), MB_OK);
+        return;
+    }
+
+    int currentPlayer, blackCaptures, whiteCaptures, moveCount, count;
+    fscanf(fp, "%d %d %d %d %d", &currentPlayer,
+        &blackCaptures, &whiteCaptures, &moveCount, &count);
+    if (count < 0 || count > MAX_HISTORY) count = 0;
+
+    int board[BOARD_SIZE][BOARD_SIZE];
+    for (int i = 0; i < BOARD_SIZE; i++) {
+        for (int j = 0; j < BOARD_SIZE; j++) {
+            fscanf(fp, "%d", &board[i][j]);
+        }
+    }
+
+    static HistoryMove moves[MAX_HISTORY];
+    for (int i = 0; i < count; i++) {
+        fscanf(fp, "%d %d %d %d", &moves[i].x, &moves[i].y,
+            &moves[i].player, &moves[i].capturedStones);
+    }
+
+    // 棋盘大小在末尾, 旧存档没有这一项, 都是 19 路
+    int size = BOARD_SIZE;
+    if (fscanf(fp, " BoardSize=%d", &size) != 1) size = BOARD_SIZE;
+    int blackTime = gameState.blackTime;
+    int whiteTime = gameState.whiteTime;
+    posInit(&game, size);
+    gameState.blackTime = blackTime;
+    gameState.whiteTime = whiteTime;
+
+    // 按棋谱从空盘重放, 重建悔棋日志和同形集合
+    // 棋谱与存档棋盘不符时直接使用存档棋盘, 此时不能悔棋
+    if (posReplay(&game, moves, count) != count ||
+        memcmp(board, gameState.board, sizeof(board)) != 0) {
+        posSetBoard(&game, board);
+    }
+    updateLastMove();
+
+    gameState.currentPlayer = currentPlayer;
+    gameState.blackCaptures = blackCaptures;
+    gameState.whiteCaptures = whiteCaptures;
+    gameState.moveCount = moveCount;
+
+    fclose(fp);
+    MessageBox(GetHWnd(), _T("载入成功!"), _T("提示"), MB_OK);
+}
+
+// 计算地域（用于点目）
+int countTerritory(int x, int y, int* owner, int visited[BOARD_SIZE][BOARD_SIZE]) {
+    return stateCountTerritory(&gameState, x, y, owner, visited);
 }
\ No newline at end of file
@@ -1,115 +1,118 @@
-/*
- * ΧϷϵͳ - Part 1: ͷļݽṹ
- * : 251880102 
- * : ȫֶ塢ݽṹϷ߼
- */
-
-#ifndef PART1_CORE_H
-#define PART1_CORE_H
-
-#include <graphics.h>
-#include <conio.h>
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <time.h>
-#include <math.h>
-#include <io.h>
-
- // ̻
-#define BOARD_SIZE 19
-#define CELL_SIZE 30
-#define STONE_RADIUS 13
-#define BOARD_MARGIN 50
-#define WINDOW_WIDTH 1000
-#define WINDOW_HEIGHT 750
-
-// ״̬
-#define EMPTY 0
-#define BLACK 1
-#define WHITE 2
-
-// ϵͳ
-#define MAX_HISTORY 500
-#define MAX_NAME_LENGTH 50
-
-// Ϸ״̬ṹ
-typedef struct {
-    int board[BOARD_SIZE][BOARD_SIZE];
-    int currentPlayer;
-    int blackCaptures;
-    int whiteCaptures;
-    int moveCount;
-    int blackTime;  // ڷʣʱ()
-    int whiteTime;  // ׷ʣʱ()
-    int lastCaptureCount; // һ
-} GameState;
-
-// ʷ¼ṹ
-typedef struct {
-    int x;
-    int y;
-    int player;
-    int capturedStones;
-    int boardSnapshot[BOARD_SIZE][BOARD_SIZE];
-    time_t timestamp;
-} HistoryMove;
-
-// Ϸýṹ
-typedef struct {
-    int boardSize;
-    float komi;
-    int timeLimit;
-    int enableSound;
-    int enableAnimation;
-    int aiDifficulty; // 1- 2-е 3-
-    char playerBlackName[MAX_NAME_LENGTH];
-    char playerWhiteName[MAX_NAME_LENGTH];
-} GameConfig;
-
-// ȫֱ
-extern GameState gameState;
-extern HistoryMove history[MAX_HISTORY];
-extern int historyCount;
-extern GameConfig config;
-extern int gameMode;
-extern int lastMoveX, lastMoveY;
-extern int hintX, hintY;
-extern IMAGE imgBoard, imgWhiteStone, imgBlackStone;
-extern int imagesLoaded;
-
-// Part 1 ĺ
-void initGame();
-void loadConfig(const char* filename);
-void saveConfig(const char* filename);
-int isValidMove(int x, int y);
-void placeStone(int x, int y);
-int hasLiberty(int x, int y, int color, int visited[BOARD_SIZE][BOARD_SIZE]);
-void removeStones(int x, int y, int color);
-int checkCapture(int x, int y, int color);
-void undoMove();
-int countTerritory(int x, int y, int* owner, int visited[BOARD_SIZE][BOARD_SIZE]);
-void saveGame(const char* filename);
-void loadGame(const char* filename);
-
-// Part 2 ͼȾ (251880599 )
-void loadImages();
-void drawWhiteStone(int px, int py);
-void drawBlackStone(int px, int py);
-void drawStoneWithImage(int x, int y, int color);
-void drawBoard();
-void drawUI();
-
-// Part 3 AI˵ (2518801370 ׿)
-int evaluatePosition(int x, int y);
-void getAIMove(int* x, int* y);
-void calculateScore();
-void showMainMenu();
-void handleMenuClick(int x, int y);
-
-// Part 4 ƺ (251880107 ҫ)
-void handleClick(int mouseX, int mouseY);
-void handleKeyboard();
-void exportGameRecord(const char* filename);
-
+/*
+ * 围棋游戏系统 - Part 1: 核心头文件和数据结构
+ * 负责人: 251880102 胡哲
+ * 包含: 全局定义、数据结构、核心游戏逻辑函数声明
+ */
+
+#ifndef PART1_CORE_H
+#define PART1_CORE_H
+
+#include <graphics.h>
+#include <conio.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <io.h>
+
+#include "Part1_Position.h"
+#include "Part1_Clock.h"
+#include "Part2_BoardView.h" // 界面尺寸和棋盘局部重绘
+#include "Part3_Ownership.h" // 形势判断
+
+// 系统配置
+#define MAX_NAME_LENGTH 50
+#define MAX_PATH_LENGTH 260
+
+// 游戏配置结构
+typedef struct {
+    int boardSize;
+    float komi;
+    int timeLimit;        // 每方的基本时间(分钟), 与读秒都为 0 时不限时
+    int byoYomiPeriods;   // 基本时间用完后的读秒次数
+    int byoYomiSeconds;   // 每次读秒的秒数
+    int enableSound;
+    int enableAnimation;
+    int aiDifficulty; // 1-简单 2-中等 3-困难
+    int evalBatchSize;    // 网络估值每批最多的局面数, 越大吞吐越高
+    int evalMaxWaitUs;    // 网络估值请求最多等多久就开算(微秒), 越小单步延迟越低
+    int evalCacheEntries; // 网络估值缓存的条目数, 0 表示不缓存
+    int aiPlayouts;   // AI 每步模拟次数, 0 表示按难度决定
+    int aiTimeMs;     // AI 每步思考时间(毫秒), 0 表示不限
+    int aiThreads;    // AI 搜索线程数, 0 表示按CPU核数
+    int aiPonder;     // 人机对战中对手思考时 AI 是否在后台继续搜索
+    int showOwnership;     // 棋盘上是否显示形势判断(各点归属和死子)
+    int ownershipPlayouts; // 每次刷新形势判断的模拟次数
+    char networkFile[MAX_PATH_LENGTH]; // 策略价值网络的权重文件, 空表示不用网络
+    char playerBlackName[MAX_NAME_LENGTH];
+    char playerWhiteName[MAX_NAME_LENGTH];
+} GameConfig;
+
+// 全局变量声明
+extern Position game;
+extern GameState& gameState;
+extern HistoryMove* const history;
+extern int& historyCount;
+extern int& historyTop;
+extern GameConfig config;
+extern GameClock gameClock;
+extern int gameMode;
+extern int lastMoveX, lastMoveY;
+extern int hintX, hintY;
+extern IMAGE imgBoard, imgWhiteStone, imgBlackStone;
+extern int imagesLoaded;
+
+// Part 1 核心函数声明
+void initGame();
+void loadConfig(const char* filename);
+void saveConfig(const char* filename);
+void syncClockTimes();
+int isValidMove(int x, int y);
+void placeStone(int x, int y);
+void rebuildChains();
+unsigned long long zobristKey(int x, int y, int color);
+unsigned long long hashAfterMove(int x, int y, int color);
+void clearPositionHistory();
+void recordPosition(unsigned long long hash);
+void forgetPosition(unsigned long long hash);
+int positionSeen(unsigned long long hash);
+int chainLiberties(int x, int y);
+int isInAtari(int x, int y);
+int captureSizeAt(int x, int y, int color);
+void removeStones(int x, int y, int color);
+int checkCapture(int x, int y, int color);
+void undoMove();
+void redoMove();
+int countTerritory(int x, int y, int* owner, int visited[BOARD_SIZE][BOARD_SIZE]);
+void saveGame(const char* filename);
+void loadGame(const char* filename);
+
+// Part 2 图形渲染函数声明 (251880599 唐瑞添)
+void loadImages();
+void drawStoneWithImage(int x, int y, int color);
+void drawBoard();
+void drawUI();
+void invalidateBoard();
+
+// Part 3 AI与菜单函数声明 (2518801370 李卓烨)
+int evaluatePosition(int x, int y);
+void getAIMove(int* x, int* y);
+void getHintMove(int* x, int* y);
+void requestAIMove();
+void requestHint();
+void cancelAI();
+int aiThinking();
+void pollAIResult();
+void calculateScore();
+const OwnershipMap* currentOwnership(int playouts);
+void showMainMenu();
+void handleMenuClick(int x, int y);
+
+// Part 4 交互控制函数声明 (251880107 马耀宗)
+void handleClick(int mouseX, int mouseY);
+void handleKeyboard();
+void showHelp();
+void exportGameRecord(const char* filename);
+
 #endif // PART1_CORE_H
\ No newline at end of file
@@ -0,0 +1,164 @@
+/*
+ * 围棋游戏系统 - Part 1: 可复制的对局局面实现
+ * 负责人: 251880102 胡哲
+ * 实现: 全局同形集合、走子(make)、撤销(unmake)、重做、按棋谱重放
+ */
+
+#include "Part1_Position.h"
+
+// 新对局: size 路空棋盘, 黑方先行, 棋谱为空
+void posInit(Position* pos, int size) {
+    stateReset(&pos->state, size);
+    pos->historyCount = 0;
+    pos->historyTop = 0;
+    posClearSeen(pos);
+    posRecordSeen(pos, pos->state.hash);
+}
+
+// 直接摆出一个棋盘(棋谱与局面不符时使用), 清空棋谱, 不能悔棋
+void posSetBoard(Position* pos, const int board[BOARD_SIZE][BOARD_SIZE]) {
+    memcpy(pos->state.board, board, sizeof(pos->state.board));
+    stateRebuildChains(&pos->state);
+    pos->state.koPoint = -1;
+    pos->historyCount = 0;
+    pos->historyTop = 0;
+    posClearSeen(pos);
+    posRecordSeen(pos, pos->state.hash);
+}
+
+// 清空已出现局面集合
+void posClearSeen(Position* pos) {
+    memset(pos->seenUsed, 0, sizeof(pos->seenUsed));
+}
+
+// 记录一个已出现的局面
+void posRecordSeen(Position* pos, unsigned long long hash) {
+    int i = (int)(hash & (SEEN_TABLE_SIZE - 1));
+    while (pos->seenUsed[i]) {
+        if (pos->seenHashes[i] == hash) return;
+        i = (i + 1) & (SEEN_TABLE_SIZE - 1);
+    }
+    pos->seenUsed[i] = 1;
+    pos->seenHashes[i] = hash;
+}
+
+// 移除一个局面(悔棋时), 用后移删除保持探测链完整
+void posForgetSeen(Position* pos, unsigned long long hash) {
+    int i = (int)(hash & (SEEN_TABLE_SIZE - 1));
+    while (pos->seenUsed[i] && pos->seenHashes[i] != hash) {
+        i = (i + 1) & (SEEN_TABLE_SIZE - 1);
+    }
+    if (!pos->seenUsed[i]) return;
+
+    pos->seenUsed[i] = 0;
+    int j = i;
+    for (;;) {
+        j = (j + 1) & (SEEN_TABLE_SIZE - 1);
+        if (!pos->seenUsed[j]) break;
+
+        // j 处元素的理想位置不在(i, j]之间时, 搬到空出来的 i
+        int home = (int)(pos->seenHashes[j] & (SEEN_TABLE_SIZE - 1));
+        int between = (i <= j) ? (home > i && home <= j) : (home > i || home <= j);
+        if (!between) {
+            pos->seenHashes[i] = pos->seenHashes[j];
+            pos->seenUsed[i] = 1;
+            pos->seenUsed[j] = 0;
+            i = j;
+        }
+    }
+}
+
+// 局面是否出现过
+int posSeen(const Position* pos, unsigned long long hash) {
+    int i = (int)(hash & (SEEN_TABLE_SIZE - 1));
+    while (pos->seenUsed[i]) {
+        if (pos->seenHashes[i] == hash) return 1;
+        i = (i + 1) & (SEEN_TABLE_SIZE - 1);
+    }
+    return 0;
+}
+
+// 判断合法落子: 规则判断之外再加全局同形禁止
+int posIsLegal(const Position* pos, int x, int y) {
+    if (!stateIsLegal(&pos->state, x, y)) return 0;
+    if (pos->historyCount >= MAX_HISTORY) return 0; // 棋谱已满, 再下将无法悔棋
+
+    // 全局同形禁止: 落子后的局面不能与之前任何局面相同
+    return !posSeen(pos, stateHashAfterMove(&pos->state, x, y, pos->state.currentPlayer));
+}
+
+// 按记录执行一手: 落子、提子, 被提的子写入 capturedLog
+static void applyMove(Position* pos, HistoryMove* move) {
+    GameState* gs = &pos->state;
+    move->blackCapturesBefore = gs->blackCaptures;
+    move->whiteCapturesBefore = gs->whiteCaptures;
+    move->koPointBefore = gs->koPoint;
+
+    gs->currentPlayer = move->player;
+    move->capturedStones = statePlay(gs, move->x, move->y,
+        pos->capturedLog + move->captureStart);
+
+    posRecordSeen(pos, gs->hash);
+    pos->historyCount++;
+}
+
+// 当前一方在(x, y)落子并记入棋谱, 丢弃可重做的记录; 不合法时返回0
+int posMakeMove(Position* pos, int x, int y) {
+    if (!posIsLegal(pos, x, y)) return 0;
+
+    HistoryMove* move = &pos->history[pos->historyCount];
+    move->x = x;
+    move->y = y;
+    move->player = pos->state.currentPlayer;
+    move->captureStart = 0;
+    if (pos->historyCount > 0) {
+        HistoryMove* prev = &pos->history[pos->historyCount - 1];
+        move->captureStart = prev->captureStart + prev->capturedStones;
+    }
+    move->timestamp = time(NULL);
+
+    applyMove(pos, move);
+    pos->historyTop = pos->historyCount;
+    return 1;
+}
+
+// 撤销最后一手: 拿掉落下的子, 放回被提的子; 没有可撤销的返回0
+int posUnmakeMove(Position* pos) {
+    if (pos->historyCount == 0) return 0;
+
+    GameState* gs = &pos->state;
+    pos->historyCount--;
+    HistoryMove* move = &pos->history[pos->historyCount];
+
+    posForgetSeen(pos, gs->hash);
+    stateUnplay(gs, move->x, move->y, pos->capturedLog + move->captureStart, move->capturedStones, move->koPointBefore);
+
+    gs->currentPlayer = move->player;
+    gs->blackCaptures = move->blackCapturesBefore;
+    gs->whiteCaptures = move->whiteCapturesBefore;
+    gs->lastCaptureCount = pos->historyCount > 0 ? pos->history[pos->historyCount - 1].capturedStones : 0;
+    return 1;
+}
+
+// 重做最近撤销的一手; 没有可重做的返回0
+int posRedoMove(Position* pos) {
+    if (pos->historyCount >= pos->historyTop) return 0;
+
+    applyMove(pos, &pos->history[pos->historyCount]);
+    return 1;
+}
+
+// 从同样大小的空盘按棋谱重放(保留用时), 返回成功重放的手数, 遇到不合法的一手即停止
+int posReplay(Position* pos, const HistoryMove* moves, int count) {
+    int blackTime = pos->state.blackTime;
+    int whiteTime = pos->state.whiteTime;
+    posInit(pos, pos->state.size);
+    pos->state.blackTime = blackTime;
+    pos->state.whiteTime = whiteTime;
+
+    for (int i = 0; i < count && i < MAX_HISTORY; i++) {
+        pos->state.currentPlayer = moves[i].player;
+        if (!posMakeMove(pos, moves[i].x, moves[i].y)) break;
+    }
+    return pos->historyCount;
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+/*
+ * 围棋游戏系统 - Part 1: 可复制的对局局面
+ * 负责人: 251880102 胡哲
+ * 包含: Position 结构(局面 + 棋谱 + 悔棋日志 + 已出现局面集合)及其走子/撤销函数
+ * 说明: 不依赖 EasyX 和任何全局变量, 没有弹窗; Position 内全是定长数组, 可直接赋值复制,
+ *       多个 Position 可在不同线程中同时使用
+ */
+
+#ifndef PART1_POSITION_H
+#define PART1_POSITION_H
+
+#include "Part1_Rules.h"
+
+// 一局棋的完整状态
+typedef struct {
+    GameState state;
+    HistoryMove history[MAX_HISTORY];
+    int historyCount;
+    int historyTop;                 // history 中有效记录的上界(悔棋后可重做的部分)
+    short capturedLog[MAX_HISTORY]; // 各手被提棋子的位置, 每颗子最多被提一次, 总数不超过手数
+
+    // 已出现局面的哈希集合(线性探测开放寻址), 用于全局同形判断
+    unsigned long long seenHashes[SEEN_TABLE_SIZE];
+    unsigned char seenUsed[SEEN_TABLE_SIZE];
+} Position;
+
+void posInit(Position* pos, int size);
+void posSetBoard(Position* pos, const int board[BOARD_SIZE][BOARD_SIZE]);
+int posIsLegal(const Position* pos, int x, int y);
+int posMakeMove(Position* pos, int x, int y);
+int posUnmakeMove(Position* pos);
+int posRedoMove(Position* pos);
+int posReplay(Position* pos, const HistoryMove* moves, int count);
+void posClearSeen(Position* pos);
+void posRecordSeen(Position* pos, unsigned long long hash);
+void posForgetSeen(Position* pos, unsigned long long hash);
+int posSeen(const Position* pos, unsigned long long hash);
+
+#endif // PART1_POSITION_H
\ No newline at end of file
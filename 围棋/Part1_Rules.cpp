@@ -0,0 +1,525 @@
+/*
+ * 围棋游戏系统 - Part 1: 规则引擎实现
+ * 负责人: 251880102 胡哲
+ * 实现: 棋串与气的增量维护、Zobrist 哈希、合法性判断、落子提子、打劫
+ */
+
+#include "Part1_BoardTables.h"
+#include "Part1_Bitboard.h"
+
+// Zobrist 随机数表, 编译期由 splitmix64 按普通下标顺序生成, 每次运行都相同; 按带边框下标存放
+typedef struct {
+    unsigned long long key[PADDED_POINTS][3];
+} ZobristTable;
+
+static constexpr ZobristTable buildZobristTable() {
+    ZobristTable t = {};
+    unsigned long long state = 0x9E3779B97F4A7C15ULL;
+    for (int p = 0; p < MAX_POINTS; p++) {
+        for (int c = BLACK; c <= WHITE; c++) {
+            state += 0x9E3779B97F4A7C15ULL;
+            unsigned long long z = state;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            t.key[PAD_INDEX(p / BOARD_SIZE, p % BOARD_SIZE)][c] = z ^ (z >> 31);
+        }
+    }
+    return t;
+}
+
+static constexpr ZobristTable zobrist = buildZobristTable();
+
+// 某点某色棋子的 Zobrist 键
+unsigned long long zobristKey(int x, int y, int color) {
+    return zobrist.key[PAD_INDEX(x, y)][color];
+}
+
+// 给棋串增加一口伪气
+static void addLiberty(GameState* gs, int head, int lib) {
+    gs->chainLibs[head]++;
+    gs->chainLibSum[head] += lib;
+    gs->chainLibSumSq[head] += lib * lib;
+}
+
+// 给棋串减少一口伪气
+static void removeLiberty(GameState* gs, int head, int lib) {
+    gs->chainLibs[head]--;
+    gs->chainLibSum[head] -= lib;
+    gs->chainLibSumSq[head] -= lib * lib;
+}
+
+// 棋串是否只剩一口气: 所有伪气为同一点时 libs * sumSq == sum * sum
+static int chainInAtari(const GameState* gs, int head) {
+    long long libs = gs->chainLibs[head];
+    long long sum = gs->chainLibSum[head];
+    return libs > 0 && libs * gs->chainLibSumSq[head] == sum * sum;
+}
+
+// 带边框下标的点在 board 上置色, 保持两份棋盘同步, 并更新周围 8 个点的模式码
+static inline void setCell(GameState* gs, int p, int color) {
+    int d = boardTables.denseOf[p];
+    int change = gs->cells[p] ^ color;
+    gs->cells[p] = (unsigned char)color;
+    gs->board[d / BOARD_SIZE][d % BOARD_SIZE] = color;
+    for (int k = 0; k < 8; k++) {
+        gs->pattern[p + patternOffset[k]] ^= (unsigned short)(change << (2 * (7 - k)));
+    }
+}
+
+// 合并两个棋串(小串并入大串), 返回合并后的代表点
+static int mergeChains(GameState* gs, int a, int b) {
+    if (a == b) return a;
+    if (gs->chainSize[a] < gs->chainSize[b]) {
+        int t = a; a = b; b = t;
+    }
+
+    int p = b;
+    do {
+        gs->chainHead[p] = (short)a;
+        p = gs->chainNext[p];
+    } while (p != b);
+
+    short t = gs->chainNext[a];
+    gs->chainNext[a] = gs->chainNext[b];
+    gs->chainNext[b] = t;
+
+    gs->chainSize[a] += gs->chainSize[b];
+    gs->chainLibs[a] += gs->chainLibs[b];
+    gs->chainLibSum[a] += gs->chainLibSum[b];
+    gs->chainLibSumSq[a] += gs->chainLibSumSq[b];
+    return a;
+}
+
+// 提走整串棋子, 把空出的点还给相邻棋串作气, 返回提子数
+// removed 不为空时依次写入被提棋子的普通下标
+static int removeChain(GameState* gs, int head, short* removed) {
+    int count = 0;
+
+    int color = gs->cells[head];
+    int p = head;
+    do {
+        setCell(gs, p, EMPTY);
+        gs->hash ^= zobrist.key[p][color];
+        if (removed != NULL) removed[count] = boardTables.denseOf[p];
+        count++;
+        p = gs->chainNext[p];
+    } while (p != head);
+
+    p = head;
+    do {
+        for (int i = 0; i < 4; i++) {
+            int q = p + neighborOffset[i];
+            int c = gs->cells[q];
+            if (c == BLACK || c == WHITE) {
+                addLiberty(gs, gs->chainHead[q], p);
+            }
+        }
+        p = gs->chainNext[p];
+    } while (p != head);
+
+    return count;
+}
+
+// 在带边框下标 p 的空点放一颗子, 见 stateAddStone
+static void addStone(GameState* gs, int p, int color) {
+    setCell(gs, p, color);
+    gs->hash ^= zobrist.key[p][color];
+    gs->chainHead[p] = (short)p;
+    gs->chainNext[p] = (short)p;
+    gs->chainSize[p] = 1;
+    gs->chainLibs[p] = 0;
+    gs->chainLibSum[p] = 0;
+    gs->chainLibSumSq[p] = 0;
+
+    int head = p;
+    for (int i = 0; i < 4; i++) {
+        int q = p + neighborOffset[i];
+        int c = gs->cells[q];
+        if (c == EMPTY) {
+            addLiberty(gs, p, q);
+        }
+        else if (c != OFF_BOARD) {
+            removeLiberty(gs, gs->chainHead[q], p);
+        }
+    }
+
+    for (int i = 0; i < 4; i++) {
+        int q = p + neighborOffset[i];
+        if (gs->cells[q] == color) {
+            head = mergeChains(gs, head, gs->chainHead[q]);
+        }
+    }
+}
+
+// 提走带边框下标 p 相邻的无气对方棋串, 见 stateCaptureAround
+static int captureAround(GameState* gs, int p, int color, short* removed) {
+    int opponent = (color == BLACK) ? WHITE : BLACK;
+    int captured = 0;
+
+    for (int i = 0; i < 4; i++) {
+        int q = p + neighborOffset[i];
+        if (gs->cells[q] == opponent) {
+            int head = gs->chainHead[q];
+            if (gs->chainLibs[head] == 0) {
+                captured += removeChain(gs, head, removed != NULL ? removed + captured : NULL);
+            }
+        }
+    }
+
+    return captured;
+}
+
+// 清空棋盘, 黑方先行; 不支持的大小按 19 路处理
+void stateReset(GameState* gs, int size) {
+    const SizeTables* tables = sizeTablesFor(size);
+
+    memset(gs, 0, sizeof(GameState));
+    memcpy(gs->cells, tables->emptyCells, sizeof(gs->cells));
+    memcpy(gs->pattern, tables->emptyPatterns, sizeof(gs->pattern));
+    gs->size = tables->size;
+    gs->currentPlayer = BLACK;
+    gs->koPoint = -1;
+}
+
+// 在空点放一颗子并更新棋串和气, 不处理提子
+void stateAddStone(GameState* gs, int x, int y, int color) {
+    addStone(gs, PAD_INDEX(x, y), color);
+}
+
+// 摘下只与串中一颗子相邻的子: 串不会被拆开, 从链表中摘掉并退还气即可
+static void liftLeaf(GameState* gs, int p) {
+    int color = gs->cells[p];
+    int head = gs->chainHead[p];
+    int prev = p;
+    while (gs->chainNext[prev] != p) prev = gs->chainNext[prev];
+    gs->chainNext[prev] = gs->chainNext[p];
+
+    // 摘掉的是代表点时换一个代表点
+    if (head == p) {
+        head = gs->chainNext[p];
+        int q = head;
+        do {
+            gs->chainHead[q] = (short)head;
+            q = gs->chainNext[q];
+        } while (q != head);
+        gs->chainSize[head] = gs->chainSize[p];
+        gs->chainLibs[head] = gs->chainLibs[p];
+        gs->chainLibSum[head] = gs->chainLibSum[p];
+        gs->chainLibSumSq[head] = gs->chainLibSumSq[p];
+    }
+    gs->chainSize[head]--;
+
+    setCell(gs, p, EMPTY);
+    gs->hash ^= zobrist.key[p][color];
+    for (int i = 0; i < 4; i++) {
+        int q = p + neighborOffset[i];
+        int c = gs->cells[q];
+        if (c == EMPTY) {
+            removeLiberty(gs, head, q);
+        }
+        else if (c != OFF_BOARD) {
+            addLiberty(gs, gs->chainHead[q], p);
+        }
+    }
+}
+
+// 拿掉一颗子(悔棋用): 只与串中一颗子相邻时直接摘下, 否则所在棋串可能被拆开, 只重建这一串
+void stateLiftStone(GameState* gs, int x, int y) {
+    int p = PAD_INDEX(x, y);
+    int head = gs->chainHead[p];
+    int color = gs->cells[p];
+
+    int friends = 0;
+    for (int i = 0; i < 4; i++) {
+        friends += gs->cells[p + neighborOffset[i]] == color;
+    }
+    if (friends == 1) {
+        liftLeaf(gs, p);
+        return;
+    }
+
+    short rest[MAX_POINTS];
+    int count = 0;
+
+    int q = head;
+    do {
+        if (q != p) rest[count++] = (short)q;
+        q = gs->chainNext[q];
+    } while (q != head);
+
+    removeChain(gs, head, NULL);
+    for (int i = 0; i < count; i++) {
+        addStone(gs, rest[i], color);
+    }
+}
+
+// 根据棋盘重建全部棋串信息和哈希(载入或恢复局面后调用), 盘外的子被丢弃
+void stateRebuildChains(GameState* gs) {
+    int board[BOARD_SIZE][BOARD_SIZE];
+    memcpy(board, gs->board, sizeof(board));
+    memset(gs->board, 0, sizeof(gs->board));
+    memcpy(gs->cells, sizeTablesFor(gs->size)->emptyCells, sizeof(gs->cells));
+    memcpy(gs->pattern, sizeTablesFor(gs->size)->emptyPatterns, sizeof(gs->pattern));
+    gs->hash = 0;
+
+    for (int i = 0; i < gs->size; i++) {
+        for (int j = 0; j < gs->size; j++) {
+            if (board[i][j] != EMPTY) {
+                addStone(gs, PAD_INDEX(i, j), board[i][j]);
+            }
+        }
+    }
+}
+
+// 移除(x, y)所在的整串
+int stateRemoveChain(GameState* gs, int x, int y, short* removed) {
+    int p = PAD_INDEX(x, y);
+    if (gs->cells[p] == EMPTY) return 0;
+    return removeChain(gs, gs->chainHead[p], removed);
+}
+
+// 提走(x, y)相邻的无气对方棋串, removed 不为空时记录被提的子
+int stateCaptureAround(GameState* gs, int x, int y, int color, short* removed) {
+    return captureAround(gs, PAD_INDEX(x, y), color, removed);
+}
+
+// 判断合法落子: 只看四个相邻点及其所在棋串的气, 含打劫但不含全局同形
+int stateIsLegal(const GameState* gs, int x, int y) {
+    if (x < 0 || x >= gs->size || y < 0 || y >= gs->size) return 0;
+    int p = PAD_INDEX(x, y);
+    if (gs->cells[p] != EMPTY) return 0;
+    if (x * BOARD_SIZE + y == gs->koPoint) return 0;
+
+    int color = gs->currentPlayer;
+    for (int i = 0; i < 4; i++) {
+        int q = p + neighborOffset[i];
+        int c = gs->cells[q];
+        if (c == EMPTY) return 1;
+        if (c == OFF_BOARD) continue;
+
+        // 连上还有别的气的己方棋串, 或者能提子(不算自杀)
+        int atari = chainInAtari(gs, gs->chainHead[q]);
+        if ((c == color) != atari) return 1;
+    }
+
+    return 0;
+}
+
+// 当前一方在(x, y)落子(调用方保证合法), 返回提子数
+// removed 不为空时写入被提棋子的位置
+int statePlay(GameState* gs, int x, int y, short* removed) {
+    int color = gs->currentPlayer;
+    int p = PAD_INDEX(x, y);
+    short single[MAX_POINTS];
+    short* log = removed != NULL ? removed : single;
+
+    addStone(gs, p, color);
+    int captured = captureAround(gs, p, color, log);
+
+    // 单子提单子且落下的子只剩一口气: 对方不能马上回提
+    gs->koPoint = -1;
+    int head = gs->chainHead[p];
+    if (captured == 1 && gs->chainSize[head] == 1 && chainInAtari(gs, head)) {
+        gs->koPoint = log[0];
+    }
+
+    gs->lastCaptureCount = captured;
+    if (color == BLACK) {
+        gs->blackCaptures += captured;
+    }
+    else {
+        gs->whiteCaptures += captured;
+    }
+    gs->moveCount++;
+    gs->currentPlayer = (color == BLACK) ? WHITE : BLACK;
+    return captured;
+}
+
+// 撤销 statePlay: (x, y) 为刚落下的子, removed/captured 为那一手被提的子, koPoint 为落子前的打劫点
+// 不恢复 lastCaptureCount
+void stateUnplay(GameState* gs, int x, int y, const short* removed, int captured, int koPoint) {
+    int color = gs->cells[PAD_INDEX(x, y)];
+    int opponent = (color == BLACK) ? WHITE : BLACK;
+
+    stateLiftStone(gs, x, y);
+    for (int i = 0; i < captured; i++) {
+        addStone(gs, PAD_INDEX(removed[i] / BOARD_SIZE, removed[i] % BOARD_SIZE), opponent);
+    }
+
+    if (color == BLACK) {
+        gs->blackCaptures -= captured;
+    }
+    else {
+        gs->whiteCaptures -= captured;
+    }
+    gs->moveCount--;
+    gs->currentPlayer = color;
+    gs->koPoint = koPoint;
+}
+
+// 停一手
+void statePass(GameState* gs) {
+    gs->koPoint = -1;
+    gs->lastCaptureCount = 0;
+    gs->moveCount++;
+    gs->currentPlayer = (gs->currentPlayer == BLACK) ? WHITE : BLACK;
+}
+
+// 棋子所在的串是否被叫吃
+int stateInAtari(const GameState* gs, int x, int y) {
+    if (x < 0 || x >= gs->size || y < 0 || y >= gs->size) return 0;
+    int p = PAD_INDEX(x, y);
+    if (gs->cells[p] == EMPTY) return 0;
+    return chainInAtari(gs, gs->chainHead[p]);
+}
+
+// 棋子所在的串被叫吃时返回它唯一的气(x * BOARD_SIZE + y), 否则返回 -1
+int stateAtariLiberty(const GameState* gs, int x, int y) {
+    if (x < 0 || x >= gs->size || y < 0 || y >= gs->size) return -1;
+    int p = PAD_INDEX(x, y);
+    if (gs->cells[p] != BLACK && gs->cells[p] != WHITE) return -1;
+    int head = gs->chainHead[p];
+    if (!chainInAtari(gs, head)) return -1;
+    return boardTables.denseOf[gs->chainLibSum[head] / gs->chainLibs[head]];
+}
+
+// 棋串的实际气数, 只遍历该串
+int stateLiberties(const GameState* gs, int x, int y) {
+    if (x < 0 || x >= gs->size || y < 0 || y >= gs->size) return 0;
+    int p = PAD_INDEX(x, y);
+    if (gs->cells[p] == EMPTY) return 0;
+
+    int head = gs->chainHead[p];
+    if (gs->chainLibs[head] == 0) return 0;
+    if (chainInAtari(gs, head)) return 1;
+
+    unsigned char counted[PADDED_POINTS];
+    memset(counted, 0, sizeof(counted));
+    int libs = 0;
+
+    p = head;
+    do {
+        for (int i = 0; i < 4; i++) {
+            int q = p + neighborOffset[i];
+            if (gs->cells[q] == EMPTY && !counted[q]) {
+                counted[q] = 1;
+                libs++;
+            }
+        }
+        p = gs->chainNext[p];
+    } while (p != head);
+
+    return libs;
+}
+
+// 在带边框下标 p 下 color 会被提掉的对方棋串代表点, 返回串数
+static int atariHeadsAround(const GameState* gs, int p, int color, int heads[4]) {
+    int opponent = (color == BLACK) ? WHITE : BLACK;
+    int headCount = 0;
+
+    for (int i = 0; i < 4; i++) {
+        int q = p + neighborOffset[i];
+        if (gs->cells[q] != opponent) continue;
+
+        int head = gs->chainHead[q];
+        if (!chainInAtari(gs, head)) continue;
+
+        // 同一串可能从多个方向相邻, 只算一次
+        int seen = 0;
+        for (int k = 0; k < headCount; k++) {
+            if (heads[k] == head) seen = 1;
+        }
+        if (!seen) heads[headCount++] = head;
+    }
+
+    return headCount;
+}
+
+// 在空点(x, y)下 color 能提掉的子数, 不改动棋盘
+int stateCaptureSize(const GameState* gs, int x, int y, int color) {
+    int heads[4];
+    int headCount = atariHeadsAround(gs, PAD_INDEX(x, y), color, heads);
+    int captured = 0;
+    for (int k = 0; k < headCount; k++) {
+        captured += gs->chainSize[heads[k]];
+    }
+    return captured;
+}
+
+// color 在空点(x, y)落子(含提子)后的全盘哈希, 不改动棋盘
+unsigned long long stateHashAfterMove(const GameState* gs, int x, int y, int color) {
+    int opponent = (color == BLACK) ? WHITE : BLACK;
+    int heads[4];
+    int p = PAD_INDEX(x, y);
+    int headCount = atariHeadsAround(gs, p, color, heads);
+    unsigned long long hash = gs->hash ^ zobrist.key[p][color];
+
+    for (int k = 0; k < headCount; k++) {
+        int q = heads[k];
+        do {
+            hash ^= zobrist.key[q][opponent];
+            q = gs->chainNext[q];
+        } while (q != heads[k]);
+    }
+
+    return hash;
+}
+
+// 计算(x, y)所在空白区域的大小, owner 记录区域边界棋子的颜色(-1 表示两色都有)
+// 用显式栈代替递归
+int stateCountTerritory(const GameState* gs, int x, int y, int* owner, int visited[BOARD_SIZE][BOARD_SIZE]) {
+    if (x < 0 || x >= gs->size || y < 0 || y >= gs->size) return 0;
+    if (visited[x][y]) return 0;
+
+    int* seen = &visited[0][0];
+    short stack[MAX_POINTS];
+    int top = 0;
+    int count = 0;
+
+    seen[x * BOARD_SIZE + y] = 1;
+    stack[top++] = (short)PAD_INDEX(x, y);
+    while (top > 0) {
+        int p = stack[--top];
+        int c = gs->cells[p];
+        if (c != EMPTY) {
+            if (*owner == EMPTY) {
+                *owner = c;
+            }
+            else if (*owner != c) {
+                *owner = -1; // 混合地域
+            }
+            continue;
+        }
+
+        count++;
+        for (int i = 0; i < 4; i++) {
+            int q = p + neighborOffset[i];
+            if (gs->cells[q] == OFF_BOARD) continue;
+            int d = boardTables.denseOf[q];
+            if (seen[d]) continue;
+            seen[d] = 1;
+            stack[top++] = (short)q;
+        }
+    }
+
+    return count;
+}
+
+// Tromp-Taylor 数子: 每颗子算一目, 只与一方棋子相邻的空白区域归该方
+// 返回黑方减白方再减贴目的目差, count 不为 NULL 时填写明细
+// 用位棋盘从双方棋子各洪泛一次求可达空点, 不分配内存也不依赖界面, 每局模拟结束时都可以调用
+float stateAreaScore(const GameState* gs, float komi, AreaCount* count) {
+    BitPosition pos;
+    int blackArea, whiteArea;
+    bitPosFromCells(&pos, gs->cells, gs->size, gs->currentPlayer);
+    bitPosAreaScore(&pos, &blackArea, &whiteArea);
+
+    if (count != NULL) {
+        count->blackStones = bbPopcount(&pos.stones[BLACK]);
+        count->whiteStones = bbPopcount(&pos.stones[WHITE]);
+        count->blackTerritory = blackArea - count->blackStones;
+        count->whiteTerritory = whiteArea - count->whiteStones;
+        count->neutral = bbPopcount(&pos.stones[EMPTY]) - count->blackTerritory - count->whiteTerritory;
+    }
+    return (float)(blackArea - whiteArea) - komi;
+}
\ No newline at end of file
@@ -0,0 +1,105 @@
+/*
+ * 围棋游戏系统 - Part 1: 规则引擎头文件
+ * 负责人: 251880102 胡哲
+ * 包含: 棋盘常量、GameState/HistoryMove 结构、基于棋串的落子/提子/合法性函数
+ * 说明: 不依赖 EasyX, 所有函数只操作传入的 GameState, 可用于搜索和 Linux 下的无界面程序
+ */
+
+#ifndef PART1_RULES_H
+#define PART1_RULES_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+ // 棋盘基础配置: 支持 9/13/19 路, 数组都按最大的 19 路分配, 小棋盘占用左上角
+#define BOARD_SIZE 19
+#define MAX_POINTS (BOARD_SIZE * BOARD_SIZE)
+
+// 带边框的一维棋盘: 外围一圈 OFF_BOARD 哨兵, 邻点是固定偏移(见 Part1_BoardTables.h)
+#define PAD_SIZE (BOARD_SIZE + 2)
+#define PADDED_POINTS (PAD_SIZE * PAD_SIZE)
+#define PAD_INDEX(x, y) (((x) + 1) * PAD_SIZE + (y) + 1)
+
+// 棋子状态
+#define EMPTY 0
+#define BLACK 1
+#define WHITE 2
+#define OFF_BOARD 3 // 边框哨兵, 只出现在 GameState.cells 中
+
+// 系统配置
+#define MAX_HISTORY 500
+#define SEEN_TABLE_SIZE 1024 // 已出现局面哈希表容量(2的幂, 大于 MAX_HISTORY 的两倍)
+
+// 游戏状态结构
+typedef struct {
+    int board[BOARD_SIZE][BOARD_SIZE];
+    int size;       // 棋盘路数(9/13/19), 超出的行列始终为空, 在 cells 中为 OFF_BOARD
+    int currentPlayer;
+    int blackCaptures;
+    int whiteCaptures;
+    int moveCount;
+    int blackTime;  // 黑方剩余时间(秒)
+    int whiteTime;  // 白方剩余时间(秒)
+    int lastCaptureCount; // 上一手提子数
+    int koPoint;          // 打劫禁着点(x * BOARD_SIZE + y), -1 表示没有
+    unsigned long long hash; // 全盘 Zobrist 哈希(只含棋子, 不含轮走方)
+
+    // 规则函数内部使用的带边框棋盘, 与 board 同步维护, 下标为 PAD_INDEX(x, y)
+    unsigned char cells[PADDED_POINTS];
+    // 各点周围 8 个点的颜色(3x3 模式码, 位的顺序见 patternOffset), 随 cells 增量更新
+    unsigned short pattern[PADDED_POINTS];
+
+    // 棋串信息(落子/提子时增量维护, 下标与 cells 相同)
+    short chainHead[PADDED_POINTS];   // 所属棋串的代表点
+    short chainNext[PADDED_POINTS];   // 串内循环链表的下一个子
+    short chainSize[PADDED_POINTS];   // 串的棋子数(仅代表点有效)
+    short chainLibs[PADDED_POINTS];   // 伪气数: 每个(子, 相邻空点)对各计一次
+    int chainLibSum[PADDED_POINTS];   // 伪气下标之和
+    int chainLibSumSq[PADDED_POINTS]; // 伪气下标平方和, 与上两项配合O(1)判断叫吃
+} GameState;
+
+// 历史记录结构: 只记录本手的变化, 悔棋/重做按记录增量恢复
+typedef struct {
+    int x;
+    int y;
+    int player;
+    int capturedStones;
+    int captureStart;        // 被提棋子在 capturedLog 中的起始下标
+    int blackCapturesBefore; // 本手之前的黑方提子总数
+    int whiteCapturesBefore; // 本手之前的白方提子总数
+    int koPointBefore;       // 本手之前的打劫禁着点
+    time_t timestamp;
+} HistoryMove;
+
+// Tromp-Taylor 数子的明细
+typedef struct {
+    int blackStones;
+    int whiteStones;
+    int blackTerritory; // 只与黑子相邻的空点
+    int whiteTerritory; // 只与白子相邻的空点
+    int neutral;        // 双方都相邻或都不相邻的空点
+} AreaCount;
+
+// 规则函数: 只操作传入的局面
+void stateReset(GameState* gs, int size);
+void stateRebuildChains(GameState* gs);
+void stateAddStone(GameState* gs, int x, int y, int color);
+void stateLiftStone(GameState* gs, int x, int y);
+int stateRemoveChain(GameState* gs, int x, int y, short* removed);
+int stateCaptureAround(GameState* gs, int x, int y, int color, short* removed);
+int stateIsLegal(const GameState* gs, int x, int y);
+int statePlay(GameState* gs, int x, int y, short* removed);
+void stateUnplay(GameState* gs, int x, int y, const short* removed, int captured, int koPoint);
+void statePass(GameState* gs);
+int stateInAtari(const GameState* gs, int x, int y);
+int stateAtariLiberty(const GameState* gs, int x, int y);
+int stateLiberties(const GameState* gs, int x, int y);
+int stateCaptureSize(const GameState* gs, int x, int y, int color);
+unsigned long long stateHashAfterMove(const GameState* gs, int x, int y, int color);
+unsigned long long zobristKey(int x, int y, int color);
+int stateCountTerritory(const GameState* gs, int x, int y, int* owner, int visited[BOARD_SIZE][BOARD_SIZE]);
+float stateAreaScore(const GameState* gs, float komi, AreaCount* count);
+
+#endif // PART1_RULES_H
\ No newline at end of file
@@ -0,0 +1,136 @@
+/*
+ * 围棋游戏系统 - Part 2: 棋盘局部重绘
+ * 负责人: 251880599 唐翊添
+ * 实现: 比较本帧与屏幕上的内容, 只重画变化的交叉点所在区域
+ */
+
+#include "Part2_BoardView.h"
+
+ // 交叉点上的归属标记: 空点按把握分三档, 死子画对方颜色; 返回档数, 0 表示不画
+static int ownershipMark(const BoardFrame* frame, int x, int y, int* color) {
+    if (frame->ownership == NULL) return 0;
+    int p = x * BOARD_SIZE + y;
+    int stone = frame->state->board[x][y];
+    if (stone != EMPTY) {
+        if (frame->dead == NULL || !frame->dead[p]) return 0;
+        *color = stone == BLACK ? WHITE : BLACK;
+        return 3;
+    }
+
+    float o = frame->ownership[p];
+    *color = o > 0 ? BLACK : WHITE;
+    if (o < 0) o = -o;
+    return o < 0.25f ? 0 : (o < 0.5f ? 1 : (o < 0.75f ? 2 : 3));
+}
+
+// 交叉点上本帧应画的内容
+static unsigned char cellContent(const BoardFrame* frame, int x, int y) {
+    unsigned char content = (unsigned char)frame->state->board[x][y];
+    if (x == frame->lastX && y == frame->lastY) content |= VIEW_LAST_MOVE;
+    if (x == frame->hintX && y == frame->hintY) content |= VIEW_HINT;
+
+    int color;
+    int level = ownershipMark(frame, x, y, &color);
+    if (level > 0) content |= (unsigned char)(color << VIEW_OWNER_SHIFT | level << VIEW_LEVEL_SHIFT);
+    return content;
+}
+
+// 交叉点 (x, y) 的棋子和标记是否画到矩形内
+static int cellTouches(int x, int y, int left, int top, int right, int bottom) {
+    int px = BOARD_MARGIN + x * CELL_SIZE;
+    int py = BOARD_MARGIN + y * CELL_SIZE;
+    return px - BOARD_VIEW_REACH < right && px + BOARD_VIEW_REACH + 1 > left &&
+        py - BOARD_VIEW_REACH < bottom && py + BOARD_VIEW_REACH + 1 > top;
+}
+
+// 按整屏重绘时的顺序画矩形内的棋子和标记: 先按行列画棋子, 再画归属, 然后是最后一手, 最后画提示
+static void drawContents(const BoardCanvas* canvas, const BoardFrame* frame,
+    int left, int top, int right, int bottom) {
+    for (int i = 0; i < BOARD_SIZE; i++) {
+        for (int j = 0; j < BOARD_SIZE; j++) {
+            int color = frame->state->board[i][j];
+            if (color == EMPTY || !cellTouches(i, j, left, top, right, bottom)) continue;
+            int animate = frame->animation && i == frame->lastX && j == frame->lastY;
+            canvas->drawStone(canvas->context, i, j, color, animate);
+        }
+    }
+
+    if (frame->ownership != NULL) {
+        for (int i = 0; i < BOARD_SIZE; i++) {
+            for (int j = 0; j < BOARD_SIZE; j++) {
+                int color;
+                int level = ownershipMark(frame, i, j, &color);
+                if (level == 0 || !cellTouches(i, j, left, top, right, bottom)) continue;
+                canvas->drawOwnership(canvas->context, i, j, color, level);
+            }
+        }
+    }
+
+    if (frame->lastX >= 0 && frame->lastY >= 0 &&
+        cellTouches(frame->lastX, frame->lastY, left, top, right, bottom)) {
+        canvas->drawLastMove(canvas->context, frame->lastX, frame->lastY);
+    }
+    if (frame->hintX >= 0 && frame->hintY >= 0 &&
+        cellTouches(frame->hintX, frame->hintY, left, top, right, bottom)) {
+        canvas->drawHint(canvas->context, frame->hintX, frame->hintY);
+    }
+}
+
+void boardViewInit(BoardView* view) {
+    memset(view->cells, 0, sizeof(view->cells));
+    view->valid = 0;
+    view->dirtyCells = 0;
+    view->fullRedraw = 0;
+}
+
+// 屏幕被菜单等其它画面覆盖后调用, 下一帧整屏重画
+void boardViewInvalidate(BoardView* view) {
+    view->valid = 0;
+}
+
+// 画出一帧: 变化少时逐个交叉点拷回背景并在裁剪区内重画, 变化多或屏幕失效时整屏拷回重画
+void boardViewUpdate(BoardView* view, const BoardCanvas* canvas, const BoardFrame* frame) {
+    unsigned char next[BOARD_SIZE][BOARD_SIZE];
+    int dirty = 0;
+    for (int i = 0; i < BOARD_SIZE; i++) {
+        for (int j = 0; j < BOARD_SIZE; j++) {
+            next[i][j] = cellContent(frame, i, j);
+            if (next[i][j] != view->cells[i][j]) dirty++;
+        }
+    }
+
+    view->dirtyCells = dirty;
+    view->fullRedraw = !view->valid || dirty > BOARD_VIEW_FULL_LIMIT;
+
+    if (view->fullRedraw) {
+        canvas->restoreBackground(canvas->context, 0, 0, WINDOW_WIDTH, WINDOW_HEIGHT);
+        drawContents(canvas, frame, 0, 0, WINDOW_WIDTH, WINDOW_HEIGHT);
+    }
+    else {
+        // 每个区域都先拷回背景再按原顺序重画, 区域互相重叠也不影响结果
+        for (int i = 0; i < BOARD_SIZE; i++) {
+            for (int j = 0; j < BOARD_SIZE; j++) {
+                if (next[i][j] == view->cells[i][j]) continue;
+
+                int left = BOARD_MARGIN + i * CELL_SIZE - BOARD_VIEW_REACH;
+                int top = BOARD_MARGIN + j * CELL_SIZE - BOARD_VIEW_REACH;
+                int right = BOARD_MARGIN + i * CELL_SIZE + BOARD_VIEW_REACH + 1;
+                int bottom = BOARD_MARGIN + j * CELL_SIZE + BOARD_VIEW_REACH + 1;
+
+                canvas->restoreBackground(canvas->context, left, top, right, bottom);
+                canvas->setClip(canvas->context, left, top, right, bottom);
+                drawContents(canvas, frame, left, top, right, bottom);
+                canvas->clearClip(canvas->context);
+            }
+        }
+    }
+
+    memcpy(view->cells, next, sizeof(next));
+    view->valid = 1;
+}
+
+// 旧的画法: 每帧重画整屏静态部分和全部棋子(用于对比结果和计时)
+void boardViewDrawFull(const BoardCanvas* canvas, const BoardFrame* frame) {
+    canvas->drawBackground(canvas->context);
+    drawContents(canvas, frame, 0, 0, WINDOW_WIDTH, WINDOW_HEIGHT);
+}
\ No newline at end of file
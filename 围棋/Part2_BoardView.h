@@ -0,0 +1,70 @@
+/*
+ * 围棋游戏系统 - Part 2: 棋盘局部重绘
+ * 负责人: 251880599 唐翊添
+ * 包含: 界面尺寸、绘图目标接口 BoardCanvas、按交叉点记录屏幕内容的 BoardView
+ * 说明: 不依赖 EasyX; 静态部分(背景、网格、星位、坐标)由绘图目标缓存一份,
+ *       每帧只把内容有变化的交叉点附近从缓存拷回并重画其中的棋子和标记,
+ *       界面用 EasyX 实现 BoardCanvas, Linux 下用软件帧缓冲(Part2_SoftCanvas.h)测试和计时
+ */
+
+#ifndef PART2_BOARDVIEW_H
+#define PART2_BOARDVIEW_H
+
+#include "Part1_Rules.h"
+
+// 界面配置
+#define CELL_SIZE 30
+#define STONE_RADIUS 13
+#define BOARD_MARGIN 50
+#define WINDOW_WIDTH 1000
+#define WINDOW_HEIGHT 750
+
+// 一个交叉点上的棋子和标记最远画到中心外多少像素(落子动画最外圈半径 22, 线宽 1)
+#define BOARD_VIEW_REACH 24
+// 一帧中变化的交叉点超过这么多时直接整屏拷回背景重画
+#define BOARD_VIEW_FULL_LIMIT 40
+
+// 交叉点上画了什么
+#define VIEW_STONE_MASK 3 // 低两位为棋子颜色
+#define VIEW_LAST_MOVE 4  // 最后一手标记
+#define VIEW_HINT 8       // 提示标记
+#define VIEW_OWNER_SHIFT 4 // 4-5 位: 归属标记的颜色
+#define VIEW_LEVEL_SHIFT 6 // 6-7 位: 归属标记的大小(1-3), 0 表示没有
+
+// 绘图目标: 坐标都是像素, 矩形为左闭右开
+typedef struct {
+    void* context;
+    void (*drawBackground)(void* context);  // 不经缓存直接画整屏静态部分(旧的整屏重绘用)
+    void (*restoreBackground)(void* context, int left, int top, int right, int bottom); // 从缓存拷回静态部分
+    void (*setClip)(void* context, int left, int top, int right, int bottom);
+    void (*clearClip)(void* context);
+    void (*drawStone)(void* context, int x, int y, int color, int animate); // x, y 为交叉点
+    void (*drawLastMove)(void* context, int x, int y);
+    void (*drawHint)(void* context, int x, int y);
+    void (*drawOwnership)(void* context, int x, int y, int color, int level); // 归属标记, level 为 1-3
+} BoardCanvas;
+
+// 一帧要显示的内容
+typedef struct {
+    const GameState* state;
+    int lastX, lastY;  // 最后一手, -1 表示没有
+    int hintX, hintY;  // 提示位置, -1 表示没有
+    int animation;     // 最后一手是否画落子动画圈
+    const float* ownership;      // 非 NULL 时画归属: 各点 -1(白)到 1(黑), 下标 x * BOARD_SIZE + y
+    const unsigned char* dead;   // 与 ownership 一起使用, 非 0 的棋子画为死子
+} BoardFrame;
+
+// 屏幕上当前画着的内容
+typedef struct {
+    unsigned char cells[BOARD_SIZE][BOARD_SIZE];
+    int valid;          // 0 表示屏幕被别的画面覆盖过, 下一帧整屏重画
+    int dirtyCells;     // 上一帧内容有变化的交叉点数
+    int fullRedraw;     // 上一帧是否整屏重画
+} BoardView;
+
+void boardViewInit(BoardView* view);
+void boardViewInvalidate(BoardView* view);
+void boardViewUpdate(BoardView* view, const BoardCanvas* canvas, const BoardFrame* frame);
+void boardViewDrawFull(const BoardCanvas* canvas, const BoardFrame* frame);
+
+#endif // PART2_BOARDVIEW_H
\ No newline at end of file
@@ -1,315 +1,298 @@
-/*
- * ΧϷϵͳ - Part 2: ͼȾģ
- * : 251880599 
- * ʵ: ̻ơӻơUI桢Ч
- */
-
-#include "Part1_Core.h"
-
- // ͼƬԴ
-void loadImages() {
-    if (_access("board.png", 0) == 0) {
-        loadimage(&imgBoard, _T("board.png"));
-    }
-    if (_access("white_stone.png", 0) == 0) {
-        loadimage(&imgWhiteStone, _T("white_stone.png"), STONE_RADIUS * 2, STONE_RADIUS * 2);
-        imagesLoaded |= 1;
-    }
-    if (_access("black_stone.png", 0) == 0) {
-        loadimage(&imgBlackStone, _T("black_stone.png"), STONE_RADIUS * 2, STONE_RADIUS * 2);
-        imagesLoaded |= 2;
-    }
-}
-
-// ɫ
-void drawWhiteStone(int px, int py) {
-    // ײӰ
-    setfillcolor(RGB(180, 180, 180));
-    solidcircle(px + 2, py + 2, STONE_RADIUS);
-
-    // 彥
-    for (int i = STONE_RADIUS; i > 0; i--) {
-        int gray = 245 - (STONE_RADIUS - i) * 5;
-        if (gray < 200) gray = 200;
-        setfillcolor(RGB(gray, gray, gray));
-        solidcircle(px, py, i);
-    }
-
-    // ߹Ч
-    setfillcolor(RGB(255, 255, 255));
-    solidcircle(px - 4, py - 4, 5);
-    setfillcolor(RGB(250, 250, 250));
-    solidcircle(px - 3, py - 3, 3);
-
-    // Ե
-    setlinecolor(RGB(160, 160, 160));
-    setlinestyle(PS_SOLID, 2);
-    circle(px, py, STONE_RADIUS);
-}
-
-// ɫ
-void drawBlackStone(int px, int py) {
-    // ײӰ
-    setfillcolor(RGB(0, 0, 0));
-    solidcircle(px + 2, py + 2, STONE_RADIUS);
-
-    // 彥
-    for (int i = STONE_RADIUS; i > 0; i--) {
-        int gray = 30 + (STONE_RADIUS - i) * 3;
-        if (gray > 60) gray = 60;
-        setfillcolor(RGB(gray, gray, gray));
-        solidcircle(px, py, i);
-    }
-
-    // ߹Ч
-    setfillcolor(RGB(120, 120, 120));
-    solidcircle(px - 5, py - 5, 4);
-    setfillcolor(RGB(90, 90, 90));
-    solidcircle(px - 4, py - 4, 2);
-
-    // Ե߹⻡
-    setlinecolor(RGB(80, 80, 80));
-    setlinestyle(PS_SOLID, 2);
-    arc(px - STONE_RADIUS, py - STONE_RADIUS,
-        px + STONE_RADIUS, py + STONE_RADIUS, 3.5, 2.5);
-
-    // ߿
-    setlinecolor(RGB(0, 0, 0));
-    setlinestyle(PS_SOLID, 2);
-    circle(px, py, STONE_RADIUS);
-}
-
-// ʹͼƬ
-void drawStoneWithImage(int x, int y, int color) {
-    int px = BOARD_MARGIN + x * CELL_SIZE;
-    int py = BOARD_MARGIN + y * CELL_SIZE;
-
-    if (color == BLACK) {
-        if (imagesLoaded & 2) {
-            putimage(px - STONE_RADIUS, py - STONE_RADIUS, &imgBlackStone);
-        }
-        else {
-            drawBlackStone(px, py);
-        }
-    }
-    else {
-        if (imagesLoaded & 1) {
-            putimage(px - STONE_RADIUS, py - STONE_RADIUS, &imgWhiteStone);
-        }
-        else {
-            drawWhiteStone(px, py);
-        }
-    }
-
-    // ӶЧ
-    if (config.enableAnimation && x == lastMoveX && y == lastMoveY) {
-        for (int i = 0; i < 3; i++) {
-            setlinecolor(RGB(255 - i * 50, 0, 0));
-            setlinestyle(PS_SOLID, 3 - i);
-            circle(px, py, STONE_RADIUS + 5 + i * 2);
-        }
-    }
-}
-
-// 
-void drawBoard() {
-    cleardevice();
-
-    // 䱳
-    for (int y = 0; y < WINDOW_HEIGHT; y++) {
-        int r = 220 - y / 15;
-        int g = 179 - y / 20;
-        int b = 92 - y / 25;
-        if (r < 180) r = 180;
-        if (g < 140) g = 140;
-        if (b < 60) b = 60;
-        setlinecolor(RGB(r, g, b));
-        line(0, y, WINDOW_WIDTH, y);
-    }
-
-    // װ
-    setlinecolor(RGB(139, 90, 43));
-    setlinestyle(PS_SOLID, 6);
-    rectangle(BOARD_MARGIN - 15, BOARD_MARGIN - 15,
-        BOARD_MARGIN + (BOARD_SIZE - 1) * CELL_SIZE + 15,
-        BOARD_MARGIN + (BOARD_SIZE - 1) * CELL_SIZE + 15);
-
-    setlinestyle(PS_SOLID, 2);
-    rectangle(BOARD_MARGIN - 12, BOARD_MARGIN - 12,
-        BOARD_MARGIN + (BOARD_SIZE - 1) * CELL_SIZE + 12,
-        BOARD_MARGIN + (BOARD_SIZE - 1) * CELL_SIZE + 12);
-
-    // 
-    setlinecolor(RGB(0, 0, 0));
-    setlinestyle(PS_SOLID, 1);
-
-    for (int i = 0; i < BOARD_SIZE; i++) {
-        int pos = BOARD_MARGIN + i * CELL_SIZE;
-        line(BOARD_MARGIN, pos,
-            BOARD_MARGIN + (BOARD_SIZE - 1) * CELL_SIZE, pos);
-        line(pos, BOARD_MARGIN,
-            pos, BOARD_MARGIN + (BOARD_SIZE - 1) * CELL_SIZE);
-    }
-
-    // λ
-    int starPoints[9][2] = {
-        {3, 3}, {3, 9}, {3, 15},
-        {9, 3}, {9, 9}, {9, 15},
-        {15, 3}, {15, 9}, {15, 15}
-    };
-
-    for (int i = 0; i < 9; i++) {
-        int x = BOARD_MARGIN + starPoints[i][0] * CELL_SIZE;
-        int y = BOARD_MARGIN + starPoints[i][1] * CELL_SIZE;
-        setfillcolor(RGB(0, 0, 0));
-        solidcircle(x, y, 5);
-        setfillcolor(RGB(100, 100, 100));
-        solidcircle(x - 1, y - 1, 3);
-    }
-
-    // 
-    setbkmode(TRANSPARENT);
-    settextcolor(RGB(80, 50, 20));
-    settextstyle(16, 0, _T("Arial"));
-
-    for (int i = 0; i < BOARD_SIZE; i++) {
-        TCHAR label[3];
-        //  A-T (I)
-        _stprintf(label, _T("%c"), i < 8 ? 'A' + i : 'A' + i + 1);
-        outtextxy(BOARD_MARGIN + i * CELL_SIZE - 5, BOARD_MARGIN - 30, label);
-        outtextxy(BOARD_MARGIN + i * CELL_SIZE - 5,
-            BOARD_MARGIN + (BOARD_SIZE - 1) * CELL_SIZE + 18, label);
-
-        //  1-19
-        _stprintf(label, _T("%d"), BOARD_SIZE - i);
-        int offset = (BOARD_SIZE - i) >= 10 ? 30 : 25;
-        outtextxy(BOARD_MARGIN - offset, BOARD_MARGIN + i * CELL_SIZE - 8, label);
-        outtextxy(BOARD_MARGIN + (BOARD_SIZE - 1) * CELL_SIZE + 18,
-            BOARD_MARGIN + i * CELL_SIZE - 8, label);
-    }
-
-    // 
-    for (int i = 0; i < BOARD_SIZE; i++) {
-        for (int j = 0; j < BOARD_SIZE; j++) {
-            if (gameState.board[i][j] != EMPTY) {
-                drawStoneWithImage(i, j, gameState.board[i][j]);
-            }
-        }
-    }
-
-    // һ
-    if (lastMoveX >= 0 && lastMoveY >= 0) {
-        int x = BOARD_MARGIN + lastMoveX * CELL_SIZE;
-        int y = BOARD_MARGIN + lastMoveY * CELL_SIZE;
-
-        setlinecolor(RGB(255, 50, 50));
-        setlinestyle(PS_SOLID, 3);
-        circle(x, y, STONE_RADIUS + 5);
-
-        setlinecolor(RGB(255, 100, 100));
-        setlinestyle(PS_SOLID, 2);
-        circle(x, y, STONE_RADIUS + 3);
-    }
-
-    // ʾʾλ
-    if (hintX >= 0 && hintY >= 0) {
-        int x = BOARD_MARGIN + hintX * CELL_SIZE;
-        int y = BOARD_MARGIN + hintY * CELL_SIZE;
-
-        for (int i = 0; i < 2; i++) {
-            setlinecolor(RGB(0, 255 - i * 100, 0));
-            setlinestyle(PS_SOLID, 3 - i);
-            rectangle(x - 10 - i * 2, y - 10 - i * 2,
-                x + 10 + i * 2, y + 10 + i * 2);
-        }
-    }
-
-    drawUI();
-}
-
-// UIϢ
-void drawUI() {
-    int uiX = BOARD_MARGIN + BOARD_SIZE * CELL_SIZE + 40;
-
-    setbkmode(TRANSPARENT);
-
-    // 
-    setfillcolor(RGB(139, 90, 43));
-    fillroundrect(uiX - 10, 30, uiX + 190, 90, 15, 15);
-    setfillcolor(RGB(240, 200, 120));
-    fillroundrect(uiX - 8, 32, uiX + 188, 88, 12, 12);
-
-    settextcolor(RGB(139, 90, 43));
-    settextstyle(28, 0, _T(""));
-    TCHAR info[200];
-    _stprintf(info, _T("ΧϷϵͳ"));
-    outtextxy(uiX + 5, 45, info);
-
-    // Ϣ
-    settextstyle(14, 0, _T(""));
-    settextcolor(RGB(80, 50, 20));
-    _stprintf(info, _T("Ϣ:"));
-    outtextxy(uiX, 105, info);
-    settextstyle(12, 0, _T(""));
-    _stprintf(info, _T("251880102 "));
-    outtextxy(uiX + 5, 125, info);
-    _stprintf(info, _T("251880599 "));
-    outtextxy(uiX + 5, 143, info);
-    _stprintf(info, _T("2518801370 ׿"));
-    outtextxy(uiX + 5, 161, info);
-    _stprintf(info, _T("251880107 ҫ"));
-    outtextxy(uiX + 5, 179, info);
-
-    // ϷϢ
-    settextstyle(16, 0, _T(""));
-    settextcolor(RGB(0, 0, 0));
-
-    setfillcolor(RGB(200, 160, 90));
-    fillroundrect(uiX - 10, 200, uiX + 190, 340, 10, 10);
-    setfillcolor(RGB(250, 220, 170));
-    fillroundrect(uiX - 8, 202, uiX + 188, 338, 8, 8);
-
-    _stprintf(info, _T("ǰִ: %s"),
-        gameState.currentPlayer == BLACK ? _T("ڷ") : _T("׷"));
-    outtextxy(uiX + 10, 215, info);
-
-    _stprintf(info, _T(": %d"), gameState.moveCount);
-    outtextxy(uiX + 10, 245, info);
-
-    _stprintf(info, _T("ڷ: %d"), gameState.blackCaptures);
-    outtextxy(uiX + 10, 275, info);
-
-    _stprintf(info, _T("׷: %d"), gameState.whiteCaptures);
-    outtextxy(uiX + 10, 305, info);
-
-    // ưť
-    settextstyle(15, 0, _T(""));
-    setlinecolor(RGB(139, 90, 43));
-    setlinestyle(PS_SOLID, 2);
-
-    int buttonY = 360;
-    int buttonH = 38;
-    int buttonGap = 8;
-
-    const TCHAR* buttons[] = {
-        _T(" [U]"),
-        _T("Ϸ [S]"),
-        _T("Ϸ [L]"),
-        _T("AIʾ [H]"),
-        _T("Ŀ [C]"),
-        _T("ز˵ [ESC]")
-    };
-
-    for (int i = 0; i < 6; i++) {
-        int y = buttonY + i * (buttonH + buttonGap);
-
-        setfillcolor(RGB(200, 150, 80));
-        fillroundrect(uiX, y, uiX + 160, y + buttonH, 8, 8);
-        setfillcolor(RGB(240, 200, 120));
-        fillroundrect(uiX + 2, y + 2, uiX + 158, y + buttonH - 2, 6, 6);
-
-        settextcolor(RGB(80, 50, 20));
-        int textX = (i == 1 || i == 2 || i == 4) ? 20 : 30;
-        outtextxy(uiX + textX, y + 11, (TCHAR*)buttons[i]);
-    }
+/*
+ * 围棋游戏系统 - Part 2: 图形渲染模块
+ * 负责人: 251880599 唐翊添
+ * 实现: 棋盘绘制、棋子绘制、UI界面、动画效果
+ */
+
+#include "Part1_Core.h"
+#include "Part2_SoftCanvas.h"
+#include "Part1_BoardTables.h"
+
+ // 棋盘木纹图片铺满的区域(内框以内), 图片按 19 路载入, 小棋盘只取左上角
+#define BOARD_IMAGE_LEFT (BOARD_MARGIN - 12)
+#define BOARD_IMAGE_SIZE(size) (((size) - 1) * CELL_SIZE + 24)
+
+static IMAGE boardLayer;      // 缓存的静态画面: 背景、棋盘、坐标和右侧不变的界面
+static int boardLayerReady = 0;
+static int boardLayerSize = 0; // 静态画面按几路棋盘画的, 对局换了大小时重画
+static BoardView boardView;   // 屏幕上各交叉点当前画着的内容(初始为失效, 第一帧整屏绘制)
+static SpriteCache spriteCache; // 棋子和标记贴图, 有棋子图片时用图片替换程序画的棋子
+static SoftCanvas screenBuffer; // 直接读写 EasyX 显示缓冲区的绘图目标
+static BoardCanvas screenCanvas;
+
+// 加载图片资源
+void loadImages() {
+    if (_access("board.png", 0) == 0) {
+        loadimage(&imgBoard, _T("board.png"), BOARD_IMAGE_SIZE(BOARD_SIZE), BOARD_IMAGE_SIZE(BOARD_SIZE));
+        imagesLoaded |= 4;
+    }
+    if (_access("white_stone.png", 0) == 0) {
+        loadimage(&imgWhiteStone, _T("white_stone.png"), STONE_RADIUS * 2, STONE_RADIUS * 2);
+        imagesLoaded |= 1;
+    }
+    if (_access("black_stone.png", 0) == 0) {
+        loadimage(&imgBlackStone, _T("black_stone.png"), STONE_RADIUS * 2, STONE_RADIUS * 2);
+        imagesLoaded |= 2;
+    }
+}
+
+// 绘制右侧不变的界面: 标题、制作者信息和按钮
+static void drawUIFrame() {
+    int uiX = BOARD_MARGIN + BOARD_SIZE * CELL_SIZE + 40;
+
+    setbkmode(TRANSPARENT);
+
+    // 标题框
+    setfillcolor(RGB(139, 90, 43));
+    fillroundrect(uiX - 10, 30, uiX + 190, 90, 15, 15);
+    setfillcolor(RGB(240, 200, 120));
+    fillroundrect(uiX - 8, 32, uiX + 188, 88, 12, 12);
+
+    settextcolor(RGB(139, 90, 43));
+    settextstyle(28, 0, _T("楷体"));
+    TCHAR info[200];
+    _stprintf(info, _T("围棋游戏系统"));
+    outtextxy(uiX + 5, 45, info);
+
+    // 制作者信息框
+    settextstyle(14, 0, _T("宋体"));
+    settextcolor(RGB(80, 50, 20));
+    _stprintf(info, _T("制作者信息:"));
+    outtextxy(uiX, 105, info);
+    settextstyle(12, 0, _T("宋体"));
+    _stprintf(info, _T("251880102 忽哲"));
+    outtextxy(uiX + 5, 125, info);
+    _stprintf(info, _T("251880599 唐翊添"));
+    outtextxy(uiX + 5, 143, info);
+    _stprintf(info, _T("2518801370 李卓洵"));
+    outtextxy(uiX + 5, 161, info);
+    _stprintf(info, _T("251880107 马耀宗"));
+    outtextxy(uiX + 5, 179, info);
+
+    // 绘制按钮
+    settextstyle(15, 0, _T("宋体"));
+    setlinecolor(RGB(139, 90, 43));
+    setlinestyle(PS_SOLID, 2);
+
+    int buttonY = 360;
+    int buttonH = 38;
+    int buttonGap = 8;
+
+    const TCHAR* buttons[] = {
+        _T("悔棋 [U]"),
+        _T("保存游戏 [S]"),
+        _T("载入游戏 [L]"),
+        _T("AI提示 [H]"),
+        _T("计算目数 [C]"),
+        _T("返回菜单 [ESC]")
+    };
+
+    for (int i = 0; i < 6; i++) {
+        int y = buttonY + i * (buttonH + buttonGap);
+
+        setfillcolor(RGB(200, 150, 80));
+        fillroundrect(uiX, y, uiX + 160, y + buttonH, 8, 8);
+        setfillcolor(RGB(240, 200, 120));
+        fillroundrect(uiX + 2, y + 2, uiX + 158, y + buttonH - 2, 6, 6);
+
+        settextcolor(RGB(80, 50, 20));
+        int textX = (i == 1 || i == 2 || i == 4) ? 20 : 30;
+        outtextxy(uiX + textX, y + 11, (TCHAR*)buttons[i]);
+    }
+}
+
+// 绘制不随对局变化的部分: 背景、棋盘、网格、星位、坐标和右侧界面框架
+static void drawBoardLayer(int size) {
+    const SizeTables* tables = sizeTablesFor(size);
+    int boardEnd = BOARD_MARGIN + (size - 1) * CELL_SIZE;
+
+    // 渐变背景
+    for (int y = 0; y < WINDOW_HEIGHT; y++) {
+        int r = 220 - y / 15;
+        int g = 179 - y / 20;
+        int b = 92 - y / 25;
+        if (r < 180) r = 180;
+        if (g < 140) g = 140;
+        if (b < 60) b = 60;
+        setlinecolor(RGB(r, g, b));
+        line(0, y, WINDOW_WIDTH, y);
+    }
+
+    // 棋盘木纹图片
+    if (imagesLoaded & 4) {
+        putimage(BOARD_IMAGE_LEFT, BOARD_IMAGE_LEFT, BOARD_IMAGE_SIZE(size), BOARD_IMAGE_SIZE(size), &imgBoard, 0, 0);
+    }
+
+    // 棋盘外框装饰
+    setlinecolor(RGB(139, 90, 43));
+    setlinestyle(PS_SOLID, 6);
+    rectangle(BOARD_MARGIN - 15, BOARD_MARGIN - 15, boardEnd + 15, boardEnd + 15);
+
+    setlinestyle(PS_SOLID, 2);
+    rectangle(BOARD_MARGIN - 12, BOARD_MARGIN - 12, boardEnd + 12, boardEnd + 12);
+
+    // 绘制网格
+    setlinecolor(RGB(0, 0, 0));
+    setlinestyle(PS_SOLID, 1);
+
+    for (int i = 0; i < size; i++) {
+        int pos = BOARD_MARGIN + i * CELL_SIZE;
+        line(BOARD_MARGIN, pos, boardEnd, pos);
+        line(pos, BOARD_MARGIN, pos, boardEnd);
+    }
+
+    // 绘制星位
+    for (int i = 0; i < tables->starCount; i++) {
+        int x = BOARD_MARGIN + tables->starPoints[i] / BOARD_SIZE * CELL_SIZE;
+        int y = BOARD_MARGIN + tables->starPoints[i] % BOARD_SIZE * CELL_SIZE;
+        setfillcolor(RGB(0, 0, 0));
+        solidcircle(x, y, 5);
+        setfillcolor(RGB(100, 100, 100));
+        solidcircle(x - 1, y - 1, 3);
+    }
+
+    // 绘制坐标标记
+    setbkmode(TRANSPARENT);
+    settextcolor(RGB(80, 50, 20));
+    settextstyle(16, 0, _T("Arial"));
+
+    for (int i = 0; i < size; i++) {
+        TCHAR label[3];
+        // 横坐标 A-T (跳过I)
+        _stprintf(label, _T("%c"), i < 8 ? 'A' + i : 'A' + i + 1);
+        outtextxy(BOARD_MARGIN + i * CELL_SIZE - 5, BOARD_MARGIN - 30, label);
+        outtextxy(BOARD_MARGIN + i * CELL_SIZE - 5, boardEnd + 18, label);
+
+        // 纵坐标 1-19
+        _stprintf(label, _T("%d"), size - i);
+        int offset = (size - i) >= 10 ? 30 : 25;
+        outtextxy(BOARD_MARGIN - offset, BOARD_MARGIN + i * CELL_SIZE - 8, label);
+        outtextxy(boardEnd + 18, BOARD_MARGIN + i * CELL_SIZE - 8, label);
+    }
+
+    drawUIFrame();
+}
+
+// 整屏静态部分直接画在窗口上(只在整屏重绘时用到)
+static void screenDrawBackground(void* context) {
+    drawBoardLayer(boardLayerSize);
+}
+
+// 静态部分只在棋盘大小变化时画一次, 存在内存图像里; 同时准备贴图和挂在显示缓冲区上的绘图目标
+static void buildBoardLayer() {
+    boardLayerSize = gameState.size;
+    boardLayer.Resize(WINDOW_WIDTH, WINDOW_HEIGHT);
+    SetWorkingImage(&boardLayer);
+    drawBoardLayer(boardLayerSize);
+    SetWorkingImage(NULL);
+    GdiFlush(); // 之后直接读写像素, 先让 GDI 画完
+
+    spriteCacheInit(&spriteCache);
+    SpriteSet* sprites = spriteCacheGet(&spriteCache, CELL_SIZE);
+    if (imagesLoaded & 1) {
+        spriteFromImage(&sprites->sprites[SPRITE_WHITE], (unsigned int*)GetImageBuffer(&imgWhiteStone),
+            imgWhiteStone.getwidth(), imgWhiteStone.getheight());
+    }
+    if (imagesLoaded & 2) {
+        spriteFromImage(&sprites->sprites[SPRITE_BLACK], (unsigned int*)GetImageBuffer(&imgBlackStone),
+            imgBlackStone.getwidth(), imgBlackStone.getheight());
+    }
+
+    softCanvasAttach(&screenBuffer, (unsigned int*)GetImageBuffer(NULL), (unsigned int*)GetImageBuffer(&boardLayer));
+    screenBuffer.sprites = sprites;
+    softCanvasInterface(&screenBuffer, &screenCanvas);
+    screenCanvas.drawBackground = screenDrawBackground;
+    boardViewInvalidate(&boardView);
+    boardLayerReady = 1;
+}
+
+// 使用贴图绘制棋子(棋子图片带透明通道时按透明度混合)
+void drawStoneWithImage(int x, int y, int color) {
+    if (!boardLayerReady || boardLayerSize != gameState.size) buildBoardLayer();
+    screenCanvas.drawStone(screenCanvas.context, x, y, color,
+        config.enableAnimation && x == lastMoveX && y == lastMoveY);
+}
+
+// 屏幕被菜单覆盖后调用, 下次绘制棋盘时整屏重画
+void invalidateBoard() {
+    boardViewInvalidate(&boardView);
+}
+
+// 绘制棋盘: 只重画有变化的交叉点, 全部绘制完成后一次刷新到窗口
+void drawBoard() {
+    if (!boardLayerReady || boardLayerSize != gameState.size) buildBoardLayer();
+
+    BoardFrame frame;
+    frame.state = &gameState;
+    frame.lastX = lastMoveX;
+    frame.lastY = lastMoveY;
+    frame.hintX = hintX;
+    frame.hintY = hintY;
+    frame.animation = config.enableAnimation;
+    frame.ownership = NULL;
+    frame.dead = NULL;
+    if (config.showOwnership) {
+        const OwnershipMap* map = currentOwnership(config.ownershipPlayouts);
+        frame.ownership = map->ownership;
+        frame.dead = map->dead;
+    }
+
+    BeginBatchDraw();
+    GdiFlush(); // 棋盘部分直接写显示缓冲区
+    boardViewUpdate(&boardView, &screenCanvas, &frame);
+    drawUI();
+    EndBatchDraw();
+}
+
+// 绘制UI信息(随对局变化的信息框, 框是实心的, 直接覆盖上一帧)
+// 限时对局多两行双方的剩余时间, 行距相应缩小
+void drawUI() {
+    int uiX = BOARD_MARGIN + BOARD_SIZE * CELL_SIZE + 40;
+    TCHAR info[200];
+
+    setbkmode(TRANSPARENT);
+
+    // 游戏信息框
+    settextstyle(16, 0, _T("宋体"));
+    settextcolor(RGB(0, 0, 0));
+
+    setfillcolor(RGB(200, 160, 90));
+    fillroundrect(uiX - 10, 200, uiX + 190, 340, 10, 10);
+    setfillcolor(RGB(250, 220, 170));
+    fillroundrect(uiX - 8, 202, uiX + 188, 338, 8, 8);
+
+    int lineY = gameClock.enabled ? 209 : 215;
+    int lineH = gameClock.enabled ? 21 : 30;
+
+    _stprintf(info, _T("当前执子: %s%s"),
+        gameState.currentPlayer == BLACK ? _T("●黑方") : _T("○白方"),
+        aiThinking() ? _T(" 思考中") : _T(""));
+    outtextxy(uiX + 10, lineY, info);
+
+    _stprintf(info, _T("手数: %d"), gameState.moveCount);
+    outtextxy(uiX + 10, lineY + lineH, info);
+
+    _stprintf(info, _T("黑方提子: %d"), gameState.blackCaptures);
+    outtextxy(uiX + 10, lineY + lineH * 2, info);
+
+    _stprintf(info, _T("白方提子: %d"), gameState.whiteCaptures);
+    outtextxy(uiX + 10, lineY + lineH * 3, info);
+
+    // 剩余时间: 基本时间显示 分:秒, 读秒中显示本次读秒的秒数和剩余次数
+    for (int side = BLACK; gameClock.enabled && side <= WHITE; side++) {
+        const TCHAR* name = side == BLACK ? _T("黑方") : _T("白方");
+        int seconds = side == BLACK ? gameState.blackTime : gameState.whiteTime;
+        if (gameClock.flagged == side) {
+            _stprintf(info, _T("%s剩余: 超时"), name);
+        }
+        else if (clockInByoYomi(&gameClock, side)) {
+            _stprintf(info, _T("%s读秒: %d秒 ×%d"), name, seconds, gameClock.periods[side]);
+        }
+        else {
+            _stprintf(info, _T("%s剩余: %d:%02d"), name, seconds / 60, seconds % 60);
+        }
+        if (gameState.currentPlayer == side && !gameClock.stopped) settextcolor(RGB(160, 30, 20));
+        outtextxy(uiX + 10, lineY + lineH * (3 + side), info);
+        settextcolor(RGB(0, 0, 0));
+    }
 }
\ No newline at end of file
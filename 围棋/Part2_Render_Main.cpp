@@ -0,0 +1,185 @@
+/*
+ * 围棋游戏系统 - Part 2: 棋盘重绘无界面测试程序
+ * 负责人: 251880599 唐翊添
+ * 用法: go_render [对局手数] [随机种子] [棋盘路数]
+ * 在软件帧缓冲上用固定种子随机下一局棋, 每手分别用旧的整屏重绘和新的局部重绘画一帧,
+ * 逐帧比较两者的像素是否一致, 打印两种画法每帧耗时的平均值、中位数和 99 分位;
+ * 后半局同时画归属标记(按邻点颜色粗略生成, 被叫吃的棋子当作死子);
+ * 棋子分别用逐个图形绘制和贴图缓存各跑一遍, 另外打印各种格子大小的贴图生成时间和单颗棋子的绘制时间
+ */
+
+#include "Part2_SoftCanvas.h"
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+// 每帧耗时的统计
+static void printTimes(const char* name, std::vector<double>& times) {
+    std::sort(times.begin(), times.end());
+    double total = 0.0;
+    for (size_t i = 0; i < times.size(); i++) total += times[i];
+    printf("%-12s mean %8.1f us  median %8.1f us  p99 %8.1f us\n", name,
+        total / times.size(), times[times.size() / 2], times[times.size() * 99 / 100]);
+}
+
+// 测试用的归属: 空点按四邻的黑白子数, 被叫吃的棋子算死子
+static void fakeOwnership(const GameState* gs, float* ownership, unsigned char* dead) {
+    static const int dx[4] = { -1, 1, 0, 0 };
+    static const int dy[4] = { 0, 0, -1, 1 };
+    for (int x = 0; x < BOARD_SIZE; x++) {
+        for (int y = 0; y < BOARD_SIZE; y++) {
+            int p = x * BOARD_SIZE + y;
+            int balance = 0;
+            for (int d = 0; d < 4; d++) {
+                int nx = x + dx[d], ny = y + dy[d];
+                if (nx < 0 || nx >= gs->size || ny < 0 || ny >= gs->size) continue;
+                balance += gs->board[nx][ny] == BLACK ? 1 : (gs->board[nx][ny] == WHITE ? -1 : 0);
+            }
+            ownership[p] = balance / 4.0f;
+            dead[p] = gs->board[x][y] != EMPTY && stateInAtari(gs, x, y);
+        }
+    }
+}
+
+// 随机下一局, 返回与整屏重绘结果不同的帧数
+static int runReplay(const char* name, int moves, unsigned int seed, int size, const SpriteSet* sprites) {
+    SoftCanvas fullBuffer, dirtyBuffer;
+    if (!softCanvasInit(&fullBuffer, size) || !softCanvasInit(&dirtyBuffer, size)) {
+        printf("out of memory\n");
+        return 1;
+    }
+    fullBuffer.sprites = sprites;
+    dirtyBuffer.sprites = sprites;
+    BoardCanvas fullCanvas, dirtyCanvas;
+    softCanvasInterface(&fullBuffer, &fullCanvas);
+    softCanvasInterface(&dirtyBuffer, &dirtyCanvas);
+
+    BoardView view;
+    boardViewInit(&view);
+
+    GameState gs;
+    stateReset(&gs, size);
+
+    BoardFrame frame;
+    frame.state = &gs;
+    frame.lastX = -1;
+    frame.lastY = -1;
+    frame.hintX = -1;
+    frame.hintY = -1;
+    frame.animation = 1;
+    frame.ownership = NULL;
+    frame.dead = NULL;
+    float ownership[MAX_POINTS];
+    unsigned char dead[MAX_POINTS];
+
+    std::vector<double> fullTimes, dirtyTimes;
+    long long dirtyCells = 0;
+    int fullRedraws = 0, mismatches = 0, frames = 0;
+
+    for (int i = 0; i < moves; i++) {
+        int legal[MAX_POINTS];
+        int count = 0;
+        for (int p = 0; p < MAX_POINTS; p++) {
+            if (stateIsLegal(&gs, p / BOARD_SIZE, p % BOARD_SIZE)) legal[count++] = p;
+        }
+        if (count == 0) break;
+
+        seed = seed * 1103515245u + 12345u;
+        int p = legal[(seed >> 8) % count];
+        statePlay(&gs, p / BOARD_SIZE, p % BOARD_SIZE, NULL);
+        frame.lastX = p / BOARD_SIZE;
+        frame.lastY = p % BOARD_SIZE;
+
+        // 每隔几手显示一次提示, 下一手时消失
+        if (i % 7 == 3 && count > 1) {
+            int q = legal[(seed >> 16) % count];
+            frame.hintX = q / BOARD_SIZE;
+            frame.hintY = q % BOARD_SIZE;
+        }
+        else {
+            frame.hintX = -1;
+            frame.hintY = -1;
+        }
+
+        if (i >= moves / 2) {
+            fakeOwnership(&gs, ownership, dead);
+            frame.ownership = ownership;
+            frame.dead = dead;
+        }
+
+        auto t0 = std::chrono::steady_clock::now();
+        boardViewDrawFull(&fullCanvas, &frame);
+        auto t1 = std::chrono::steady_clock::now();
+        boardViewUpdate(&view, &dirtyCanvas, &frame);
+        auto t2 = std::chrono::steady_clock::now();
+
+        fullTimes.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+        dirtyTimes.push_back(std::chrono::duration<double, std::micro>(t2 - t1).count());
+        dirtyCells += view.dirtyCells;
+        fullRedraws += view.fullRedraw;
+        frames++;
+
+        if (memcmp(fullBuffer.pixels, dirtyBuffer.pixels,
+            (size_t)WINDOW_WIDTH * WINDOW_HEIGHT * sizeof(unsigned int)) != 0) {
+            mismatches++;
+        }
+    }
+
+    printf("[%s] %d frames, %.1f changed points per frame, %d full redraws, %d frames differ from full redraw\n",
+        name, frames, frames > 0 ? (double)dirtyCells / frames : 0.0, fullRedraws, mismatches);
+    if (frames > 0) {
+        printTimes("full redraw", fullTimes);
+        printTimes("dirty redraw", dirtyTimes);
+    }
+
+    softCanvasFree(&fullBuffer);
+    softCanvasFree(&dirtyBuffer);
+    return mismatches;
+}
+
+// 每颗棋子的绘制时间: 整盘摆满棋子反复画
+static double stoneNanoseconds(const SpriteSet* sprites, int rounds) {
+    SoftCanvas buffer;
+    if (!softCanvasInit(&buffer, BOARD_SIZE)) return 0.0;
+    buffer.sprites = sprites;
+    BoardCanvas canvas;
+    softCanvasInterface(&buffer, &canvas);
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (int p = 0; p < MAX_POINTS; p++) {
+            canvas.drawStone(canvas.context, p / BOARD_SIZE, p % BOARD_SIZE, (p + r) % 2 ? BLACK : WHITE, 0);
+        }
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+    softCanvasFree(&buffer);
+    return ns / ((double)rounds * MAX_POINTS);
+}
+
+static SpriteCache spriteCache;
+
+int main(int argc, char* argv[]) {
+    int moves = argc > 1 ? atoi(argv[1]) : 250;
+    unsigned int seed = argc > 2 ? (unsigned int)atoi(argv[2]) : 2024u;
+    int size = argc > 3 ? atoi(argv[3]) : BOARD_SIZE;
+    if (moves < 1) moves = 1;
+
+    // 贴图生成时间(每种格子大小只生成一次)
+    static const int cellSizes[] = { 20, 30, 40, 60 };
+    spriteCacheInit(&spriteCache);
+    for (int i = 0; i < 4; i++) {
+        auto t0 = std::chrono::steady_clock::now();
+        SpriteSet* set = spriteCacheGet(&spriteCache, cellSizes[i]);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        printf("sprite set for cell %2d: %dx%d pixels, built in %.2f ms\n",
+            cellSizes[i], set->sprites[0].size, set->sprites[0].size, ms);
+    }
+    const SpriteSet* sprites = spriteCacheGet(&spriteCache, CELL_SIZE);
+
+    printf("stone draw: procedural %.0f ns, sprite blit %.0f ns\n",
+        stoneNanoseconds(NULL, 20), stoneNanoseconds(sprites, 20));
+
+    int mismatches = runReplay("procedural", moves, seed, size, NULL);
+    mismatches += runReplay("sprites", moves, seed, size, sprites);
+    return mismatches == 0 ? 0 : 1;
+}
\ No newline at end of file
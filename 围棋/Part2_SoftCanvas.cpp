@@ -0,0 +1,270 @@
+/*
+ * 围棋游戏系统 - Part 2: 软件帧缓冲
+ * 负责人: 251880599 唐翊添
+ * 实现: 水平线段填充、实心圆、圆环、矩形框, 以及按界面画法组合出的棋盘和棋子
+ */
+
+#include "Part2_SoftCanvas.h"
+#include "Part1_BoardTables.h"
+#include <math.h>
+
+#define SOFT_RGB(r, g, b) (((unsigned int)(r) << 16) | ((unsigned int)(g) << 8) | (unsigned int)(b))
+
+ // 填充一行 [x0, x1], 超出裁剪区的部分不画
+static void fillSpan(SoftCanvas* c, int y, int x0, int x1, unsigned int color) {
+    if (y < c->clipTop || y >= c->clipBottom) return;
+    if (x0 < c->clipLeft) x0 = c->clipLeft;
+    if (x1 >= c->clipRight) x1 = c->clipRight - 1;
+    unsigned int* row = c->pixels + y * WINDOW_WIDTH;
+    for (int x = x0; x <= x1; x++) row[x] = color;
+}
+
+// 填充矩形 [left, right) x [top, bottom)
+static void fillRect(SoftCanvas* c, int left, int top, int right, int bottom, unsigned int color) {
+    for (int y = top; y < bottom; y++) fillSpan(c, y, left, right - 1, color);
+}
+
+// 到圆心距离平方不超过 limit4 / 4 的最大水平偏移, 没有则为 -1
+static int halfWidth(int dy, int limit4) {
+    int rest = limit4 - 4 * dy * dy;
+    if (rest < 0) return -1;
+    int dx = (int)sqrt(rest / 4.0);
+    while (4 * (dx + 1) * (dx + 1) <= rest) dx++;
+    while (dx > 0 && 4 * dx * dx > rest) dx--;
+    return dx;
+}
+
+// 实心圆
+static void fillCircle(SoftCanvas* c, int cx, int cy, int r, unsigned int color) {
+    int limit4 = (2 * r + 1) * (2 * r + 1);
+    for (int dy = -r; dy <= r; dy++) {
+        int dx = halfWidth(dy, limit4);
+        if (dx >= 0) fillSpan(c, cy + dy, cx - dx, cx + dx, color);
+    }
+}
+
+// 半径 r、线宽 width 的圆环
+static void strokeCircle(SoftCanvas* c, int cx, int cy, int r, int width, unsigned int color) {
+    int outer4 = (2 * r + width) * (2 * r + width);
+    int inner4 = (2 * r - width) * (2 * r - width);
+    int reach = r + (width + 1) / 2;
+    for (int dy = -reach; dy <= reach; dy++) {
+        int outer = halfWidth(dy, outer4);
+        if (outer < 0) continue;
+        int inner = 2 * r > width ? halfWidth(dy, inner4 - 1) : -1;
+        if (inner < 0) {
+            fillSpan(c, cy + dy, cx - outer, cx + outer, color);
+        }
+        else {
+            fillSpan(c, cy + dy, cx - outer, cx - inner - 1, color);
+            fillSpan(c, cy + dy, cx + inner + 1, cx + outer, color);
+        }
+    }
+}
+
+// 线宽 width 的矩形框, 线条以边为中心
+static void strokeRect(SoftCanvas* c, int left, int top, int right, int bottom, int width, unsigned int color) {
+    int a = width / 2;
+    int b = width - a;
+    fillRect(c, left - a, top - a, right + b, top + b, color);
+    fillRect(c, left - a, bottom - a, right + b, bottom + b, color);
+    fillRect(c, left - a, top - a, left + b, bottom + b, color);
+    fillRect(c, right - a, top - a, right + b, bottom + b, color);
+}
+
+static void resetClip(SoftCanvas* c) {
+    c->clipLeft = 0;
+    c->clipTop = 0;
+    c->clipRight = WINDOW_WIDTH;
+    c->clipBottom = WINDOW_HEIGHT;
+}
+
+// 静态部分: 渐变背景、双层边框、网格、星位
+static void softDrawBackground(void* context) {
+    SoftCanvas* c = (SoftCanvas*)context;
+    const SizeTables* tables = sizeTablesFor(c->boardSize);
+    int boardEnd = BOARD_MARGIN + (tables->size - 1) * CELL_SIZE;
+
+    for (int y = 0; y < WINDOW_HEIGHT; y++) {
+        int r = 220 - y / 15;
+        int g = 179 - y / 20;
+        int b = 92 - y / 25;
+        if (r < 180) r = 180;
+        if (g < 140) g = 140;
+        if (b < 60) b = 60;
+        fillSpan(c, y, 0, WINDOW_WIDTH - 1, SOFT_RGB(r, g, b));
+    }
+
+    strokeRect(c, BOARD_MARGIN - 15, BOARD_MARGIN - 15, boardEnd + 15, boardEnd + 15, 6, SOFT_RGB(139, 90, 43));
+    strokeRect(c, BOARD_MARGIN - 12, BOARD_MARGIN - 12, boardEnd + 12, boardEnd + 12, 2, SOFT_RGB(139, 90, 43));
+
+    for (int i = 0; i < tables->size; i++) {
+        int pos = BOARD_MARGIN + i * CELL_SIZE;
+        fillRect(c, BOARD_MARGIN, pos, boardEnd + 1, pos + 1, 0);
+        fillRect(c, pos, BOARD_MARGIN, pos + 1, boardEnd + 1, 0);
+    }
+
+    for (int i = 0; i < tables->starCount; i++) {
+        int x = BOARD_MARGIN + tables->starPoints[i] / BOARD_SIZE * CELL_SIZE;
+        int y = BOARD_MARGIN + tables->starPoints[i] % BOARD_SIZE * CELL_SIZE;
+        fillCircle(c, x, y, 5, 0);
+        fillCircle(c, x - 1, y - 1, 3, SOFT_RGB(100, 100, 100));
+    }
+}
+
+static void softRestoreBackground(void* context, int left, int top, int right, int bottom) {
+    SoftCanvas* c = (SoftCanvas*)context;
+    if (left < 0) left = 0;
+    if (top < 0) top = 0;
+    if (right > WINDOW_WIDTH) right = WINDOW_WIDTH;
+    if (bottom > WINDOW_HEIGHT) bottom = WINDOW_HEIGHT;
+    if (left >= right) return;
+    for (int y = top; y < bottom; y++) {
+        memcpy(c->pixels + y * WINDOW_WIDTH + left, c->layer + y * WINDOW_WIDTH + left,
+            (right - left) * sizeof(unsigned int));
+    }
+}
+
+static void softSetClip(void* context, int left, int top, int right, int bottom) {
+    SoftCanvas* c = (SoftCanvas*)context;
+    resetClip(c);
+    if (left > c->clipLeft) c->clipLeft = left;
+    if (top > c->clipTop) c->clipTop = top;
+    if (right < c->clipRight) c->clipRight = right;
+    if (bottom < c->clipBottom) c->clipBottom = bottom;
+}
+
+static void softClearClip(void* context) {
+    resetClip((SoftCanvas*)context);
+}
+
+// 把贴图画到交叉点 (x, y)
+static void blitAt(SoftCanvas* c, int kind, int x, int y) {
+    spriteBlit(c->pixels, WINDOW_WIDTH, c->clipLeft, c->clipTop, c->clipRight, c->clipBottom,
+        &c->sprites->sprites[kind], BOARD_MARGIN + x * CELL_SIZE, BOARD_MARGIN + y * CELL_SIZE);
+}
+
+// 与原来界面的立体棋子相同的层次: 阴影、渐变主体、高光、描边
+static void softDrawStone(void* context, int x, int y, int color, int animate) {
+    SoftCanvas* c = (SoftCanvas*)context;
+    int px = BOARD_MARGIN + x * CELL_SIZE;
+    int py = BOARD_MARGIN + y * CELL_SIZE;
+
+    if (c->sprites != NULL) {
+        blitAt(c, color == BLACK ? SPRITE_BLACK : SPRITE_WHITE, x, y);
+        if (animate) blitAt(c, SPRITE_MOVE_RINGS, x, y);
+        return;
+    }
+
+    if (color == BLACK) {
+        fillCircle(c, px + 2, py + 2, STONE_RADIUS, 0);
+        for (int i = STONE_RADIUS; i > 0; i--) {
+            int gray = 30 + (STONE_RADIUS - i) * 3;
+            if (gray > 60) gray = 60;
+            fillCircle(c, px, py, i, SOFT_RGB(gray, gray, gray));
+        }
+        fillCircle(c, px - 5, py - 5, 4, SOFT_RGB(120, 120, 120));
+        fillCircle(c, px - 4, py - 4, 2, SOFT_RGB(90, 90, 90));
+        strokeCircle(c, px, py, STONE_RADIUS, 2, 0);
+    }
+    else {
+        fillCircle(c, px + 2, py + 2, STONE_RADIUS, SOFT_RGB(180, 180, 180));
+        for (int i = STONE_RADIUS; i > 0; i--) {
+            int gray = 245 - (STONE_RADIUS - i) * 5;
+            if (gray < 200) gray = 200;
+            fillCircle(c, px, py, i, SOFT_RGB(gray, gray, gray));
+        }
+        fillCircle(c, px - 4, py - 4, 5, SOFT_RGB(255, 255, 255));
+        fillCircle(c, px - 3, py - 3, 3, SOFT_RGB(250, 250, 250));
+        strokeCircle(c, px, py, STONE_RADIUS, 2, SOFT_RGB(160, 160, 160));
+    }
+
+    if (animate) {
+        for (int i = 0; i < 3; i++) {
+            strokeCircle(c, px, py, STONE_RADIUS + 5 + i * 2, 3 - i, SOFT_RGB(255 - i * 50, 0, 0));
+        }
+    }
+}
+
+static void softDrawLastMove(void* context, int x, int y) {
+    SoftCanvas* c = (SoftCanvas*)context;
+    if (c->sprites != NULL) {
+        blitAt(c, SPRITE_LAST_MOVE, x, y);
+        return;
+    }
+    int px = BOARD_MARGIN + x * CELL_SIZE;
+    int py = BOARD_MARGIN + y * CELL_SIZE;
+    strokeCircle(c, px, py, STONE_RADIUS + 5, 3, SOFT_RGB(255, 50, 50));
+    strokeCircle(c, px, py, STONE_RADIUS + 3, 2, SOFT_RGB(255, 100, 100));
+}
+
+static void softDrawHint(void* context, int x, int y) {
+    SoftCanvas* c = (SoftCanvas*)context;
+    if (c->sprites != NULL) {
+        blitAt(c, SPRITE_HINT, x, y);
+        return;
+    }
+    int px = BOARD_MARGIN + x * CELL_SIZE;
+    int py = BOARD_MARGIN + y * CELL_SIZE;
+    for (int i = 0; i < 2; i++) {
+        strokeRect(c, px - 10 - i * 2, py - 10 - i * 2, px + 10 + i * 2, py + 10 + i * 2,
+            3 - i, SOFT_RGB(0, 255 - i * 100, 0));
+    }
+}
+
+// 归属标记: 实心小方块, 把握越大方块越大; 死子上画满档
+static void softDrawOwnership(void* context, int x, int y, int color, int level) {
+    SoftCanvas* c = (SoftCanvas*)context;
+    int px = BOARD_MARGIN + x * CELL_SIZE;
+    int py = BOARD_MARGIN + y * CELL_SIZE;
+    int half = 2 + level * 2;
+    fillRect(c, px - half, py - half, px + half + 1, py + half + 1,
+        color == BLACK ? SOFT_RGB(40, 40, 40) : SOFT_RGB(245, 245, 245));
+}
+
+// 分配像素并把 boardSize 路棋盘的静态部分画进缓存; 内存不足时返回 0
+int softCanvasInit(SoftCanvas* canvas, int boardSize) {
+    size_t count = (size_t)WINDOW_WIDTH * WINDOW_HEIGHT;
+    canvas->pixels = (unsigned int*)malloc(count * sizeof(unsigned int));
+    canvas->layer = (unsigned int*)malloc(count * sizeof(unsigned int));
+    if (canvas->pixels == NULL || canvas->layer == NULL) {
+        softCanvasFree(canvas);
+        return 0;
+    }
+
+    canvas->sprites = NULL;
+    canvas->boardSize = sizeTablesFor(boardSize)->size;
+    resetClip(canvas);
+    softDrawBackground(canvas);
+    memcpy(canvas->layer, canvas->pixels, count * sizeof(unsigned int));
+    return 1;
+}
+
+// 画在别处分配的像素上(如 EasyX 的显示缓冲区), layer 中应已画好静态部分; 不要对其调用 softCanvasFree
+void softCanvasAttach(SoftCanvas* canvas, unsigned int* pixels, unsigned int* layer) {
+    canvas->pixels = pixels;
+    canvas->layer = layer;
+    canvas->sprites = NULL;
+    canvas->boardSize = BOARD_SIZE;
+    resetClip(canvas);
+}
+
+void softCanvasFree(SoftCanvas* canvas) {
+    free(canvas->pixels);
+    free(canvas->layer);
+    canvas->pixels = NULL;
+    canvas->layer = NULL;
+}
+
+// 填写指向 canvas 的绘图目标
+void softCanvasInterface(SoftCanvas* canvas, BoardCanvas* out) {
+    out->context = canvas;
+    out->drawBackground = softDrawBackground;
+    out->restoreBackground = softRestoreBackground;
+    out->setClip = softSetClip;
+    out->clearClip = softClearClip;
+    out->drawStone = softDrawStone;
+    out->drawLastMove = softDrawLastMove;
+    out->drawHint = softDrawHint;
+    out->drawOwnership = softDrawOwnership;
+}
\ No newline at end of file
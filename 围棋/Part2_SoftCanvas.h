@@ -0,0 +1,28 @@
+/*
+ * 围棋游戏系统 - Part 2: 软件帧缓冲
+ * 负责人: 251880599 唐翊添
+ * 包含: 在内存像素数组上实现 BoardCanvas, 用于在 Linux 下无界面地检查和计时局部重绘
+ * 说明: 按 EasyX 界面的画法画渐变背景、边框、网格、星位、立体棋子和各种标记(含形势判断的归属方块);
+ *       没有字体, 坐标文字和右侧界面略去;
+ *       设置了 sprites 时棋子和标记改为透明混合贴图, 界面中也用这种方式直接画在 EasyX 显示缓冲区上
+ */
+
+#ifndef PART2_SOFTCANVAS_H
+#define PART2_SOFTCANVAS_H
+
+#include "Part2_Sprite.h"
+
+typedef struct {
+    unsigned int* pixels;  // WINDOW_WIDTH * WINDOW_HEIGHT 个 0x00RRGGBB
+    unsigned int* layer;   // 缓存的静态部分
+    const SpriteSet* sprites; // 非 NULL 时用贴图画棋子和标记, 否则逐个图形画
+    int boardSize;         // 网格和星位按几路棋盘画
+    int clipLeft, clipTop, clipRight, clipBottom;
+} SoftCanvas;
+
+int softCanvasInit(SoftCanvas* canvas, int boardSize);
+void softCanvasAttach(SoftCanvas* canvas, unsigned int* pixels, unsigned int* layer);
+void softCanvasFree(SoftCanvas* canvas);
+void softCanvasInterface(SoftCanvas* canvas, BoardCanvas* out);
+
+#endif // PART2_SOFTCANVAS_H
\ No newline at end of file
@@ -0,0 +1,305 @@
+/*
+ * 围棋游戏系统 - Part 2: 棋子贴图缓存
+ * 负责人: 251880599 唐翊添
+ * 实现: 按界面原来的画法(阴影、渐变主体、高光、描边、标记圈)一次画出各种贴图, 贴图时按透明度混合
+ */
+
+#include "Part2_Sprite.h"
+#include <math.h>
+
+#define SPRITE_SUBSAMPLES 4 // 每个像素每边的超采样数
+
+// 贴图上的一个图形
+#define SHAPE_DISC 0  // 实心圆
+#define SHAPE_RING 1  // 圆环
+#define SHAPE_FRAME 2 // 方框
+#define SHAPE_BODY 3  // 颜色随半径渐变的实心圆
+
+typedef struct {
+    int kind;
+    float cx, cy;     // 相对贴图中心的偏移(像素)
+    float radius;     // 圆的半径, 方框为半边长
+    float width;      // 圆环和方框的线宽
+    float red, green, blue;
+    float grayEdge, grayStep, grayLimit; // SHAPE_BODY: 边缘灰度、向内每像素的变化、变化的上下限
+} SpriteShape;
+
+// 点 (x, y) 是否在图形内, 在则给出颜色
+static int shapeSample(const SpriteShape* shape, float x, float y, float* r, float* g, float* b) {
+    float dx = x - shape->cx;
+    float dy = y - shape->cy;
+    float d2 = dx * dx + dy * dy;
+
+    switch (shape->kind) {
+    case SHAPE_DISC:
+        if (d2 > shape->radius * shape->radius) return 0;
+        break;
+    case SHAPE_RING: {
+        float outer = shape->radius + shape->width / 2;
+        float inner = shape->radius - shape->width / 2;
+        if (d2 > outer * outer || d2 < inner * inner) return 0;
+        break;
+    }
+    case SHAPE_FRAME: {
+        float ax = fabsf(dx), ay = fabsf(dy);
+        float outer = shape->radius + shape->width / 2;
+        float inner = shape->radius - shape->width / 2;
+        if (ax > outer || ay > outer || (ax < inner && ay < inner)) return 0;
+        break;
+    }
+    case SHAPE_BODY: {
+        if (d2 > shape->radius * shape->radius) return 0;
+        float gray = shape->grayEdge + (shape->radius - sqrtf(d2)) * shape->grayStep;
+        if (shape->grayStep > 0 ? gray > shape->grayLimit : gray < shape->grayLimit) gray = shape->grayLimit;
+        *r = *g = *b = gray;
+        return 1;
+    }
+    }
+    *r = shape->red;
+    *g = shape->green;
+    *b = shape->blue;
+    return 1;
+}
+
+// 把图形按覆盖率叠加到浮点画布上(预乘透明度, 每像素 r g b a)
+static void paintShape(float* canvas, int size, const SpriteShape* shape) {
+    float center = size / 2 + 0.5f;
+    float step = 1.0f / SPRITE_SUBSAMPLES;
+    float reach = shape->radius + shape->width / 2 + 2.0f;
+    if (shape->kind == SHAPE_FRAME) reach *= 1.42f;
+
+    for (int py = 0; py < size; py++) {
+        for (int px = 0; px < size; px++) {
+            float x0 = px - center, y0 = py - center;
+            if (fabsf(x0 - shape->cx) > reach + 1 || fabsf(y0 - shape->cy) > reach + 1) continue;
+
+            float sumR = 0, sumG = 0, sumB = 0;
+            int hits = 0;
+            for (int sy = 0; sy < SPRITE_SUBSAMPLES; sy++) {
+                for (int sx = 0; sx < SPRITE_SUBSAMPLES; sx++) {
+                    float r, g, b;
+                    if (shapeSample(shape, x0 + (sx + 0.5f) * step, y0 + (sy + 0.5f) * step, &r, &g, &b)) {
+                        sumR += r;
+                        sumG += g;
+                        sumB += b;
+                        hits++;
+                    }
+                }
+            }
+            if (hits == 0) continue;
+
+            float coverage = (float)hits / (SPRITE_SUBSAMPLES * SPRITE_SUBSAMPLES);
+            float keep = 1.0f - coverage;
+            float* p = canvas + (py * size + px) * 4;
+            p[0] = sumR / hits * coverage + p[0] * keep;
+            p[1] = sumG / hits * coverage + p[1] * keep;
+            p[2] = sumB / hits * coverage + p[2] * keep;
+            p[3] = coverage + p[3] * keep;
+        }
+    }
+}
+
+static SpriteShape makeShape(int kind, float cx, float cy, float radius, float width, int r, int g, int b) {
+    SpriteShape shape;
+    shape.kind = kind;
+    shape.cx = cx;
+    shape.cy = cy;
+    shape.radius = radius;
+    shape.width = width;
+    shape.red = (float)r;
+    shape.green = (float)g;
+    shape.blue = (float)b;
+    shape.grayEdge = shape.grayStep = shape.grayLimit = 0;
+    return shape;
+}
+
+static SpriteShape makeBody(float radius, float edge, float step, float limit) {
+    SpriteShape shape = makeShape(SHAPE_BODY, 0, 0, radius, 0, 0, 0, 0);
+    shape.grayEdge = edge;
+    shape.grayStep = step;
+    shape.grayLimit = limit;
+    return shape;
+}
+
+// 按种类画出一张贴图; s 为相对默认格子的缩放, 圆的半径加 0.5 与按像素画的圆大小一致
+static void paintSprite(float* canvas, int size, int kind, float s) {
+    float radius = STONE_RADIUS * s;
+    SpriteShape shapes[5];
+    int count = 0;
+
+    switch (kind) {
+    case SPRITE_BLACK:
+        shapes[count++] = makeShape(SHAPE_DISC, 2 * s, 2 * s, radius + 0.5f, 0, 0, 0, 0);
+        shapes[count++] = makeBody(radius + 0.5f, 30, 3 / s, 60);
+        shapes[count++] = makeShape(SHAPE_DISC, -5 * s, -5 * s, 4 * s + 0.5f, 0, 120, 120, 120);
+        shapes[count++] = makeShape(SHAPE_DISC, -4 * s, -4 * s, 2 * s + 0.5f, 0, 90, 90, 90);
+        shapes[count++] = makeShape(SHAPE_RING, 0, 0, radius, 2 * s, 0, 0, 0);
+        break;
+    case SPRITE_WHITE:
+        shapes[count++] = makeShape(SHAPE_DISC, 2 * s, 2 * s, radius + 0.5f, 0, 180, 180, 180);
+        shapes[count++] = makeBody(radius + 0.5f, 245, -5 / s, 200);
+        shapes[count++] = makeShape(SHAPE_DISC, -4 * s, -4 * s, 5 * s + 0.5f, 0, 255, 255, 255);
+        shapes[count++] = makeShape(SHAPE_DISC, -3 * s, -3 * s, 3 * s + 0.5f, 0, 250, 250, 250);
+        shapes[count++] = makeShape(SHAPE_RING, 0, 0, radius, 2 * s, 160, 160, 160);
+        break;
+    case SPRITE_MOVE_RINGS:
+        for (int i = 0; i < 3; i++) {
+            shapes[count++] = makeShape(SHAPE_RING, 0, 0, radius + (5 + i * 2) * s, (3 - i) * s, 255 - i * 50, 0, 0);
+        }
+        break;
+    case SPRITE_LAST_MOVE:
+        shapes[count++] = makeShape(SHAPE_RING, 0, 0, radius + 5 * s, 3 * s, 255, 50, 50);
+        shapes[count++] = makeShape(SHAPE_RING, 0, 0, radius + 3 * s, 2 * s, 255, 100, 100);
+        break;
+    case SPRITE_HINT:
+        for (int i = 0; i < 2; i++) {
+            shapes[count++] = makeShape(SHAPE_FRAME, 0, 0, (10 + i * 2) * s, (3 - i) * s, 0, 255 - i * 100, 0);
+        }
+        break;
+    }
+    for (int i = 0; i < count; i++) paintShape(canvas, size, &shapes[i]);
+}
+
+static unsigned int toByte(float v) {
+    int b = (int)(v + 0.5f);
+    return (unsigned int)(b < 0 ? 0 : b > 255 ? 255 : b);
+}
+
+// 记录各行不透明部分的范围, 贴图时跳过两边透明的像素
+static void findSpans(StoneSprite* sprite) {
+    for (int y = 0; y < sprite->size; y++) {
+        const unsigned int* row = sprite->pixels + y * sprite->size;
+        int left = 0, right = sprite->size;
+        while (left < right && (row[left] >> 24) == 0) left++;
+        while (right > left && (row[right - 1] >> 24) == 0) right--;
+        sprite->spanLeft[y] = (short)left;
+        sprite->spanRight[y] = (short)right;
+    }
+}
+
+// 画出一种格子大小下的全部贴图
+void spriteSetBuild(SpriteSet* set, int cellSize) {
+    if (cellSize < 8) cellSize = 8;
+    if (cellSize > SPRITE_MAX_CELL) cellSize = SPRITE_MAX_CELL;
+
+    float s = (float)cellSize / CELL_SIZE;
+    int half = (cellSize * BOARD_VIEW_REACH + CELL_SIZE - 1) / CELL_SIZE;
+    int size = 2 * half + 1;
+    float* canvas = (float*)malloc(sizeof(float) * 4 * size * size);
+    set->cellSize = cellSize;
+
+    for (int kind = 0; kind < SPRITE_KINDS; kind++) {
+        StoneSprite* sprite = &set->sprites[kind];
+        sprite->size = size;
+        if (canvas == NULL) {
+            memset(sprite->pixels, 0, sizeof(sprite->pixels));
+            findSpans(sprite);
+            continue;
+        }
+
+        memset(canvas, 0, sizeof(float) * 4 * size * size);
+        paintSprite(canvas, size, kind, s);
+        for (int i = 0; i < size * size; i++) {
+            const float* p = canvas + i * 4;
+            sprite->pixels[i] = (toByte(p[3] * 255) << 24) | (toByte(p[0]) << 16) | (toByte(p[1]) << 8) | toByte(p[2]);
+        }
+        findSpans(sprite);
+    }
+    free(canvas);
+}
+
+void spriteCacheInit(SpriteCache* cache) {
+    cache->count = 0;
+    cache->next = 0;
+}
+
+// 取某种格子大小的贴图, 第一次用到时画出; 缓存满时替换最早画的一组
+SpriteSet* spriteCacheGet(SpriteCache* cache, int cellSize) {
+    for (int i = 0; i < cache->count; i++) {
+        if (cache->sets[i].cellSize == cellSize) return &cache->sets[i];
+    }
+
+    int slot;
+    if (cache->count < SPRITE_CACHE_SETS) {
+        slot = cache->count++;
+    }
+    else {
+        slot = cache->next;
+        cache->next = (cache->next + 1) % SPRITE_CACHE_SETS;
+    }
+    spriteSetBuild(&cache->sets[slot], cellSize);
+    cache->sets[slot].cellSize = cellSize;
+    return &cache->sets[slot];
+}
+
+// 用图片(0xAARRGGBB, 未预乘)替换贴图内容, 图片中心对准贴图中心;
+// 图片没有透明通道(全为 0)时按不透明处理
+void spriteFromImage(StoneSprite* sprite, const unsigned int* argb, int width, int height) {
+    int hasAlpha = 0;
+    for (int i = 0; i < width * height; i++) {
+        if (argb[i] >> 24) {
+            hasAlpha = 1;
+            break;
+        }
+    }
+
+    memset(sprite->pixels, 0, sizeof(sprite->pixels));
+    int left = sprite->size / 2 - width / 2;
+    int top = sprite->size / 2 - height / 2;
+    for (int y = 0; y < height; y++) {
+        int sy = top + y;
+        if (sy < 0 || sy >= sprite->size) continue;
+        for (int x = 0; x < width; x++) {
+            int sx = left + x;
+            if (sx < 0 || sx >= sprite->size) continue;
+
+            unsigned int c = argb[y * width + x];
+            unsigned int a = hasAlpha ? c >> 24 : 255;
+            unsigned int r = ((c >> 16) & 0xFF) * a / 255;
+            unsigned int g = ((c >> 8) & 0xFF) * a / 255;
+            unsigned int b = (c & 0xFF) * a / 255;
+            sprite->pixels[sy * sprite->size + sx] = (a << 24) | (r << 16) | (g << 8) | b;
+        }
+    }
+    findSpans(sprite);
+}
+
+// 把贴图中心贴到 (cx, cy), 只写裁剪区内的像素: 目标 = 贴图 + 目标 * (255 - a) / 255
+void spriteBlit(unsigned int* dst, int stride, int clipLeft, int clipTop, int clipRight, int clipBottom,
+    const StoneSprite* sprite, int cx, int cy) {
+    int size = sprite->size;
+    int left = cx - size / 2;
+    int top = cy - size / 2;
+    int x0 = left > clipLeft ? left : clipLeft;
+    int y0 = top > clipTop ? top : clipTop;
+    int x1 = left + size < clipRight ? left + size : clipRight;
+    int y1 = top + size < clipBottom ? top + size : clipBottom;
+
+    for (int y = y0; y < y1; y++) {
+        int from = left + sprite->spanLeft[y - top];
+        int to = left + sprite->spanRight[y - top];
+        if (from < x0) from = x0;
+        if (to > x1) to = x1;
+
+        const unsigned int* src = sprite->pixels + (y - top) * size + (from - left);
+        unsigned int* row = dst + y * stride;
+        for (int x = from; x < to; x++, src++) {
+            unsigned int s = *src;
+            unsigned int a = s >> 24;
+            if (a == 0) continue;
+            if (a == 255) {
+                row[x] = s & 0xFFFFFF;
+                continue;
+            }
+
+            // 红蓝两个通道一起乘, 再用 (t + 128 + (t + 128) / 256) / 256 近似除以 255
+            unsigned int d = row[x];
+            unsigned int keep = 255 - a;
+            unsigned int rb = (d & 0xFF00FF) * keep + 0x800080;
+            unsigned int g = (d & 0x00FF00) * keep + 0x008000;
+            rb = ((rb + ((rb >> 8) & 0xFF00FF)) >> 8) & 0xFF00FF;
+            g = ((g + ((g >> 8) & 0x00FF00)) >> 8) & 0x00FF00;
+            row[x] = (s & 0xFFFFFF) + rb + g;
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+/*
+ * 围棋游戏系统 - Part 2: 棋子贴图缓存
+ * 负责人: 251880599 唐翊添
+ * 包含: 预先画好的带透明度的棋子和标记贴图、按格子大小缓存的贴图组、透明混合贴图
+ * 说明: 不依赖 EasyX; 像素格式与 EasyX 显示缓冲区相同(0xAARRGGBB), 颜色已预乘透明度;
+ *       贴图用 4x4 超采样抗锯齿, 中心像素对准交叉点
+ */
+
+#ifndef PART2_SPRITE_H
+#define PART2_SPRITE_H
+
+#include "Part2_BoardView.h"
+
+// 贴图种类
+#define SPRITE_BLACK 0      // 黑子(含阴影)
+#define SPRITE_WHITE 1      // 白子(含阴影)
+#define SPRITE_MOVE_RINGS 2 // 落子动画的三道红圈
+#define SPRITE_LAST_MOVE 3  // 最后一手标记
+#define SPRITE_HINT 4       // 提示方框
+#define SPRITE_KINDS 5
+
+#define SPRITE_MAX_CELL 60      // 支持的最大格子边长
+#define SPRITE_MAX_SIZE 97      // 最大格子下的贴图边长 2 * 48 + 1
+#define SPRITE_CACHE_SETS 4     // 缓存几种格子大小
+
+typedef struct {
+    int size;   // 边长(奇数), 中心在 (size / 2, size / 2)
+    unsigned int pixels[SPRITE_MAX_SIZE * SPRITE_MAX_SIZE];
+    short spanLeft[SPRITE_MAX_SIZE];  // 各行不透明部分的范围 [spanLeft, spanRight), 全透明的行两者相等
+    short spanRight[SPRITE_MAX_SIZE];
+} StoneSprite;
+
+// 一种格子大小下的全部贴图
+typedef struct {
+    int cellSize;
+    StoneSprite sprites[SPRITE_KINDS];
+} SpriteSet;
+
+typedef struct {
+    SpriteSet sets[SPRITE_CACHE_SETS];
+    int count;
+    int next;   // 缓存满时下一个被替换的位置
+} SpriteCache;
+
+void spriteSetBuild(SpriteSet* set, int cellSize);
+void spriteCacheInit(SpriteCache* cache);
+SpriteSet* spriteCacheGet(SpriteCache* cache, int cellSize);
+void spriteFromImage(StoneSprite* sprite, const unsigned int* argb, int width, int height);
+void spriteBlit(unsigned int* dst, int stride, int clipLeft, int clipTop, int clipRight, int clipBottom,
+    const StoneSprite* sprite, int cx, int cy);
+
+#endif // PART2_SPRITE_H
\ No newline at end of file
@@ -0,0 +1,100 @@
+/*
+ * 围棋游戏系统 - Part 3: 后台 AI 计算实现
+ * 负责人: 2518801370 李卓洵
+ * 实现: 每个请求启动一个工作线程; 取消时置标志并等待线程退出(搜索每次模拟前检查标志)
+ *       搜索树在请求之间保留, 新的搜索自动复用其中与当前局面相同的子树
+ */
+
+#include "Part3_AIWorker.h"
+#include "Part3_Heuristic.h"
+#include <thread>
+
+static std::thread* worker = NULL;    // 正在计算或已算完尚未取走结果的线程
+static MctsTree* searchTree = NULL;   // 落子和后台思考共用的搜索树
+static std::atomic<int> cancelFlag(0);
+static std::atomic<int> resultReady(0);
+static Position jobPosition;          // 请求时的局面副本, 只由工作线程读取
+static AIRequest jobRequest;
+static AIResult jobResult;
+
+// 工作线程入口
+static void runJob() {
+    AIResult result;
+    result.task = jobRequest.task;
+    result.x = result.y = -1;
+    memset(&result.search, 0, sizeof(result.search));
+
+    if (jobRequest.task == AI_TASK_MOVE || jobRequest.task == AI_TASK_PONDER) {
+        MctsParams params = jobRequest.params;
+        params.rootPosition = &jobPosition;
+        params.cancel = &cancelFlag;
+        params.ponder = jobRequest.task == AI_TASK_PONDER;
+        mctsSearchTree(searchTree, &jobPosition.state, &params, &result.search);
+        result.x = result.search.bestX;
+        result.y = result.search.bestY;
+    }
+    else if (jobRequest.task == AI_TASK_HINT) {
+        heuristicBestMove(&jobPosition, jobRequest.difficulty, &result.x, &result.y);
+    }
+
+    if (!cancelFlag.load()) {
+        jobResult = result;
+        resultReady.store(1, std::memory_order_release);
+    }
+}
+
+// 等待线程退出并释放
+static void joinWorker() {
+    if (worker == NULL) return;
+    worker->join();
+    delete worker;
+    worker = NULL;
+}
+
+// 开始一个新任务, 正在进行的任务先被取消
+void aiWorkerStart(const Position* pos, const AIRequest* request) {
+    aiWorkerCancel();
+
+    if (searchTree == NULL) searchTree = mctsTreeCreate();
+    jobPosition = *pos;
+    jobRequest = *request;
+    cancelFlag.store(0);
+    resultReady.store(0);
+    worker = new std::thread(runJob);
+}
+
+// 取消当前任务并丢弃其结果, 返回时工作线程已经退出
+void aiWorkerCancel() {
+    if (worker == NULL) return;
+    cancelFlag.store(1);
+    joinWorker();
+    resultReady.store(0);
+}
+
+// 是否有落子或提示任务正在计算(后台思考不算)
+int aiWorkerBusy() {
+    return worker != NULL && !resultReady.load(std::memory_order_acquire) &&
+        jobRequest.task != AI_TASK_PONDER;
+}
+
+// 是否正在对手时间里后台思考
+int aiWorkerPondering() {
+    return worker != NULL && !resultReady.load(std::memory_order_acquire) &&
+        jobRequest.task == AI_TASK_PONDER;
+}
+
+// 后台思考时直接读取当前树中访问最多的着法, 根节点访问不足 minVisits 时返回0
+int aiWorkerPeekMove(int minVisits, int* x, int* y) {
+    if (!aiWorkerPondering()) return 0;
+    return mctsTreeBestMove(searchTree, minVisits, x, y, NULL);
+}
+
+// 取走已完成任务的结果, 没有结果时返回0
+int aiWorkerPoll(AIResult* result) {
+    if (worker == NULL || !resultReady.load(std::memory_order_acquire)) return 0;
+
+    joinWorker();
+    resultReady.store(0);
+    *result = jobResult;
+    return 1;
+}
\ No newline at end of file
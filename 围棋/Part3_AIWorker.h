@@ -0,0 +1,41 @@
+/*
+ * 围棋游戏系统 - Part 3: 后台 AI 计算
+ * 负责人: 2518801370 李卓洵
+ * 包含: 在工作线程中计算 AI 落子/提示的 请求-取消-取结果 接口
+ * 说明: 请求时复制一份局面, 计算期间界面线程可以继续修改全局对局;
+ *       落子和后台思考共用一棵搜索树, 对手落子后保留对应子树继续搜索;
+ *       所有函数只能在界面线程中调用
+ */
+
+#ifndef PART3_AIWORKER_H
+#define PART3_AIWORKER_H
+
+#include "Part3_MCTS.h"
+
+// 任务类型
+#define AI_TASK_NONE 0
+#define AI_TASK_MOVE 1 // 树搜索落子
+#define AI_TASK_HINT 2 // 启发式提示
+#define AI_TASK_PONDER 3 // 对手思考时在后台继续搜索, 直到被取消
+
+typedef struct {
+    int task;
+    MctsParams params; // AI_TASK_MOVE 使用, cancel 和 rootPosition 由工作线程填写
+    int difficulty;    // AI_TASK_HINT 使用
+} AIRequest;
+
+typedef struct {
+    int task;
+    int x;             // 都为 -1 表示没有可下的点
+    int y;
+    MctsResult search; // AI_TASK_MOVE 的搜索统计
+} AIResult;
+
+void aiWorkerStart(const Position* pos, const AIRequest* request);
+void aiWorkerCancel();
+int aiWorkerBusy();
+int aiWorkerPondering();
+int aiWorkerPeekMove(int minVisits, int* x, int* y);
+int aiWorkerPoll(AIResult* result);
+
+#endif // PART3_AIWORKER_H
\ No newline at end of file
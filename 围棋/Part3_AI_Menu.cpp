@@ -1,322 +1,316 @@
-/*
- * ΧϷϵͳ - Part 3: AI˵ģ
- * : 2518801370 ׿
- * ʵ: AI㷨˵˵Ʒϵͳ
- */
-
-#include "Part1_Core.h"
-
- // λüֵ
-int evaluatePosition(int x, int y) {
-    int score = 0;
-    int color = gameState.currentPlayer;
-
-    // λüֵ
-    int centerX = BOARD_SIZE / 2;
-    int centerY = BOARD_SIZE / 2;
-    int distToCenter = abs(x - centerX) + abs(y - centerY);
-
-    // ǲֵ
-    if ((x <= 3 || x >= 15) && (y <= 3 || y >= 15)) {
-        score += 25;
-    }
-    // ߲֮
-    else if (x <= 3 || x >= 15 || y <= 3 || y >= 15) {
-        score += 15;
-    }
-    // и
-    else {
-        score += 10 - distToCenter / 2;
-    }
-
-    // λӷ
-    int starPoints[9][2] = {
-        {3, 3}, {3, 9}, {3, 15},
-        {9, 3}, {9, 9}, {9, 15},
-        {15, 3}, {15, 9}, {15, 15}
-    };
-    for (int i = 0; i < 9; i++) {
-        if (x == starPoints[i][0] && y == starPoints[i][1]) {
-            score += 10;
-            break;
-        }
-    }
-
-    // Χ
-    int dx[] = { -1, 1, 0, 0, -1, -1, 1, 1 };
-    int dy[] = { 0, 0, -1, 1, -1, 1, -1, 1 };
-
-    int friendCount = 0;
-    int enemyCount = 0;
-    int opponent = (color == BLACK) ? WHITE : BLACK;
-
-    for (int i = 0; i < 8; i++) {
-        int nx = x + dx[i];
-        int ny = y + dy[i];
-        if (nx >= 0 && nx < BOARD_SIZE && ny >= 0 && ny < BOARD_SIZE) {
-            if (gameState.board[nx][ny] == color) {
-                friendCount++;
-                score += 5;
-            }
-            else if (gameState.board[nx][ny] == opponent) {
-                enemyCount++;
-                score += 3;
-            }
-        }
-    }
-
-    // Ƿܳ
-    gameState.board[x][y] = color;
-    for (int i = 0; i < 4; i++) {
-        int nx = x + dx[i];
-        int ny = y + dy[i];
-        if (nx >= 0 && nx < BOARD_SIZE && ny >= 0 && ny < BOARD_SIZE) {
-            if (gameState.board[nx][ny] == opponent) {
-                int visited[BOARD_SIZE][BOARD_SIZE] = { 0 };
-                if (!hasLiberty(nx, ny, opponent, visited)) {
-                    // ܳԵ
-                    int captureCount = 0;
-                    for (int p = 0; p < BOARD_SIZE; p++) {
-                        for (int q = 0; q < BOARD_SIZE; q++) {
-                            if (visited[p][q]) captureCount++;
-                        }
-                    }
-                    score += 40 * captureCount; // Ӵӷ
-                }
-            }
-        }
-    }
-
-    // Լ
-    int libertyCount = 0;
-    for (int i = 0; i < 4; i++) {
-        int nx = x + dx[i];
-        int ny = y + dy[i];
-        if (nx >= 0 && nx < BOARD_SIZE && ny >= 0 && ny < BOARD_SIZE) {
-            if (gameState.board[nx][ny] == EMPTY) {
-                libertyCount++;
-            }
-        }
-    }
-    score += libertyCount * 3;
-
-    gameState.board[x][y] = EMPTY;
-
-    // Ѷȵ
-    if (config.aiDifficulty == 1) {
-        score += rand() % 20; // ģʽ
-    }
-    else if (config.aiDifficulty == 3) {
-        // ģʽǸ
-        score += (friendCount - enemyCount) * 2;
-    }
-
-    return score;
-}
-
-// AI
-void getAIMove(int* x, int* y) {
-    int bestScore = -1;
-    int candidates[BOARD_SIZE * BOARD_SIZE][3];
-    int candidateCount = 0;
-
-    // кϷλ
-    for (int i = 0; i < BOARD_SIZE; i++) {
-        for (int j = 0; j < BOARD_SIZE; j++) {
-            if (isValidMove(i, j)) {
-                int score = evaluatePosition(i, j);
-                candidates[candidateCount][0] = i;
-                candidates[candidateCount][1] = j;
-                candidates[candidateCount][2] = score;
-                candidateCount++;
-
-                if (score > bestScore) {
-                    bestScore = score;
-                }
-            }
-        }
-    }
-
-    // Žѡ
-    if (candidateCount > 0) {
-        int threshold = bestScore - (10 - config.aiDifficulty * 3);
-        int goodMoves[BOARD_SIZE * BOARD_SIZE][2];
-        int goodCount = 0;
-
-        for (int i = 0; i < candidateCount; i++) {
-            if (candidates[i][2] >= threshold) {
-                goodMoves[goodCount][0] = candidates[i][0];
-                goodMoves[goodCount][1] = candidates[i][1];
-                goodCount++;
-            }
-        }
-
-        if (goodCount > 0) {
-            int choice = rand() % goodCount;
-            *x = goodMoves[choice][0];
-            *y = goodMoves[choice][1];
-        }
-        else {
-            *x = candidates[0][0];
-            *y = candidates[0][1];
-        }
-    }
-    else {
-        *x = *y = -1;
-    }
-}
-
-// Ŀ
-void calculateScore() {
-    int blackStones = 0, whiteStones = 0;
-    int blackTerritory = 0, whiteTerritory = 0;
-
-    // ͳ
-    for (int i = 0; i < BOARD_SIZE; i++) {
-        for (int j = 0; j < BOARD_SIZE; j++) {
-            if (gameState.board[i][j] == BLACK) {
-                blackStones++;
-            }
-            else if (gameState.board[i][j] == WHITE) {
-                whiteStones++;
-            }
-        }
-    }
-
-    // 򵥵ĵͳ
-    int visited[BOARD_SIZE][BOARD_SIZE] = { 0 };
-    for (int i = 0; i < BOARD_SIZE; i++) {
-        for (int j = 0; j < BOARD_SIZE; j++) {
-            if (gameState.board[i][j] == EMPTY && !visited[i][j]) {
-                int owner = EMPTY;
-                int territory = countTerritory(i, j, &owner, visited);
-                if (owner == BLACK) {
-                    blackTerritory += territory;
-                }
-                else if (owner == WHITE) {
-                    whiteTerritory += territory;
-                }
-            }
-        }
-    }
-
-    float blackScore = (float)(blackStones + blackTerritory) + gameState.blackCaptures;
-    float whiteScore = (float)(whiteStones + whiteTerritory) + gameState.whiteCaptures + config.komi;
-
-    TCHAR msg[400];
-    _stprintf(msg, _T("Ŀͳ:\n\nڷ: %d + %d + %d = %.1fĿ\n׷: %d + %d + %d + %.1fĿ = %.1fĿ\n\n%sʤ %.1fĿ"),
-        blackStones, blackTerritory, gameState.blackCaptures, blackScore,
-        whiteStones, whiteTerritory, gameState.whiteCaptures, config.komi, whiteScore,
-        blackScore > whiteScore ? _T("ڷ") : _T("׷"),
-        (float)fabs(blackScore - whiteScore));
-
-    MessageBox(GetHWnd(), msg, _T("Ծֽ"), MB_OK);
-}
-
-// ˵
-void showMainMenu() {
-    cleardevice();
-
-    // 䱳
-    for (int y = 0; y < WINDOW_HEIGHT; y++) {
-        int r = 220 - y / 15;
-        int g = 179 - y / 20;
-        int b = 92 - y / 25;
-        if (r < 180) r = 180;
-        if (g < 140) g = 140;
-        if (b < 60) b = 60;
-        setlinecolor(RGB(r, g, b));
-        line(0, y, WINDOW_WIDTH, y);
-    }
-
-    setbkmode(TRANSPARENT);
-    settextcolor(RGB(139, 90, 43));
-
-    // 
-    settextstyle(50, 0, _T(""));
-    TCHAR title[] = _T("Χ   Ϸ");
-    outtextxy(320, 80, title);
-
-    settextstyle(16, 0, _T(""));
-
-    // ˵ť
-    setlinecolor(RGB(139, 90, 43));
-    setlinestyle(PS_SOLID, 3);
-
-    int buttonX = 340;
-    int buttonW = 220;
-    int startY = 200;
-    int buttonH = 50;
-    int gap = 20;
-
-    const TCHAR* menuItems[] = {
-        _T("˶ս [1]"),
-        _T("˻ս [2]"),
-        _T("Ϸ [3]"),
-        _T("Ϸ˵ [4]"),
-        _T("˳ [ESC]")
-    };
-
-    for (int i = 0; i < 5; i++) {
-        int y = startY + i * (buttonH + gap);
-
-        setfillcolor(RGB(200, 150, 80));
-        fillroundrect(buttonX, y, buttonX + buttonW, y + buttonH, 10, 10);
-        setfillcolor(RGB(240, 200, 120));
-        fillroundrect(buttonX + 2, y + 2, buttonX + buttonW - 2, y + buttonH - 2, 8, 8);
-
-        settextcolor(RGB(80, 50, 20));
-        int textX = buttonX + (buttonW - textwidth((TCHAR*)menuItems[i])) / 2;
-        outtextxy(textX, y + 15, (TCHAR*)menuItems[i]);
-    }
-
-    // Ϣ
-    settextstyle(13, 0, _T(""));
-    settextcolor(RGB(100, 60, 20));
-    outtextxy(320, 600, _T(": ѧ"));
-    outtextxy(280, 620, _T("251880102     251880599 "));
-    outtextxy(280, 640, _T("2518801370 ׿  251880107 ҫ"));
-}
-
-// ˵
-void handleMenuClick(int x, int y) {
-    int buttonX = 340;
-    int buttonW = 220;
-    int startY = 200;
-    int buttonH = 50;
-    int gap = 20;
-
-    if (x >= buttonX && x <= buttonX + buttonW) {
-        for (int i = 0; i < 5; i++) {
-            int btnY = startY + i * (buttonH + gap);
-            if (y >= btnY && y <= btnY + buttonH) {
-                switch (i) {
-                case 0: // ˶ս
-                    gameMode = 1;
-                    initGame();
-                    drawBoard();
-                    break;
-                case 1: // ˻ս
-                    gameMode = 2;
-                    initGame();
-                    drawBoard();
-                    break;
-                case 2: // Ϸ
-                    loadGame("savegame.txt");
-                    gameMode = 1;
-                    drawBoard();
-                    break;
-                case 3: // Ϸ˵
-                    MessageBox(GetHWnd(),
-                        _T("Χ:\n\n1. ڰ˫ڽ\n2. Χӻᱻ\n3. ɱ(ܳԵԷ)\n4. ȫͬνֹ()\n5. հĿ+ʤ\n6. ׷7.5ĿĿ\n\nݼ:\nU- S- L-\nH-ʾ C- ESC-˵\n\nѶ: config.txt޸AIDifficulty\n1- 2-е 3-"),
-                        _T("Ϸ˵"), MB_OK);
-                    break;
-                case 4: // ˳
-                    exit(0);
-                    break;
-                }
-                break;
-            }
-        }
-    }
+/*
+ * 围棋游戏系统 - Part 3: AI与菜单模块
+ * 负责人: 2518801370 李卓洵
+ * 实现: AI算法、主菜单、菜单交互、计分系统
+ */
+
+#include "Part1_Core.h"
+#include "Part3_MCTS.h"
+#include "Part3_Heuristic.h"
+#include "Part3_AIWorker.h"
+
+ // 评估位置价值(整盘分数见 heuristicMap, 这里只取一个点)
+int evaluatePosition(int x, int y) {
+    int scores[MAX_POINTS];
+    heuristicMap(&gameState, config.aiDifficulty, scores);
+    int score = scores[x * BOARD_SIZE + y];
+
+    if (config.aiDifficulty == 1) {
+        score += rand() % 20; // 简单模式增加随机性
+    }
+    return score;
+}
+
+// AI提示: 一次算出整盘启发式分数, 取合法点中最高的
+void getHintMove(int* x, int* y) {
+    heuristicBestMove(&game, config.aiDifficulty, x, y);
+}
+
+// config.txt 中 NetworkFile 给出的策略价值网络, 第一次用到时载入; 没有配置、载入失败或路数不符时不用网络
+static const Network* searchNetwork() {
+    static Network* network = NULL;
+    static int loaded = 0;
+    if (!loaded && config.networkFile[0] != '\0') {
+        network = networkLoad(config.networkFile);
+        loaded = 1;
+    }
+    if (network == NULL || network->size != gameState.size) return NULL;
+    return network;
+}
+
+// 搜索线程共用的网络估值队列, 批大小、等待时间和缓存大小取 config.txt 中 Eval* 各项
+static EvalQueue* searchQueue(const Network* network) {
+    static EvalQueue* queue = NULL;
+    if (queue == NULL) {
+        queue = evalQueueCreate(network, config.evalBatchSize, config.evalMaxWaitUs, config.evalCacheEntries);
+    }
+    return queue;
+}
+
+// 按难度和配置文件填写搜索参数
+static void buildSearchParams(MctsParams* params) {
+    mctsDefaultParams(params);
+    // 模拟次数按难度决定, config.txt 中 AIPlayouts/AITimeMs 非 0 时优先
+    params->maxPlayouts = config.aiPlayouts > 0 ? config.aiPlayouts : mctsLevelPlayouts(config.aiDifficulty);
+    params->maxTimeMs = config.aiTimeMs;
+    if (config.aiPlayouts <= 0 && config.aiTimeMs > 0) {
+        params->maxPlayouts = 0; // 只给了时间时按时间搜索
+    }
+    params->komi = config.komi;
+    params->seed = (unsigned int)rand() * 2654435761u + (unsigned int)time(NULL);
+    params->threads = config.aiThreads;
+    params->network = searchNetwork();
+    params->evalQueue = params->network != NULL ? searchQueue(params->network) : NULL;
+    if (params->evalQueue != NULL && config.aiThreads <= 0) {
+        params->threads = config.evalBatchSize; // 线程大多在等估值, 线程数与批大小相同批才能攒满
+    }
+    params->rootPosition = &game; // 根节点同时检查全局同形和历史容量
+}
+
+static double searchIterationMs = 0.0; // 最近一次 AI 落子的搜索中每个线程做一次模拟的用时, 分配时间时留出
+
+// 对局限时且没有在 config.txt 中指定每步时间时, 思考时间按 AI 一方的剩余用时分配:
+// 中盘和对杀多的局面多用, 最佳着法明显领先时提前结束, 最长也留出余量, 不会超时;
+// 难度按各难度模拟次数的比例缩短用时
+static void applyClockBudget(MctsParams* params) {
+    int side = gameState.currentPlayer;
+    if (!clockRunning(&gameClock) || config.aiTimeMs > 0) return;
+
+    int softMs, hardMs;
+    float effort = mctsPlanTime(&gameState, gameClock.mainMs[side], gameClock.periods[side],
+        gameClock.periodLeftMs[side], searchIterationMs, &softMs, &hardMs);
+    float level = (float)mctsLevelPlayouts(config.aiDifficulty) / mctsLevelPlayouts(3);
+    params->maxTimeMs = (int)(hardMs * level) > MCTS_MIN_THINK_MS ? (int)(hardMs * level) : MCTS_MIN_THINK_MS;
+    params->softTimeMs = (int)(softMs * level) > MCTS_MIN_THINK_MS ? (int)(softMs * level) : MCTS_MIN_THINK_MS;
+    params->maxPlayouts = config.aiPlayouts > 0 ? (int)(config.aiPlayouts * effort) : 0;
+}
+
+// AI落子: 蒙特卡洛树搜索(阻塞, 界面中使用 requestAIMove)
+void getAIMove(int* x, int* y) {
+    MctsParams params;
+    buildSearchParams(&params);
+
+    MctsResult result;
+    mctsSearch(&gameState, &params, &result);
+    *x = result.bestX;
+    *y = result.bestY;
+}
+
+// 在后台开始计算 AI 落子, 结果由 pollAIResult 取回
+void requestAIMove() {
+    AIRequest request;
+    request.task = AI_TASK_MOVE;
+    buildSearchParams(&request.params);
+    applyClockBudget(&request.params);
+    request.difficulty = config.aiDifficulty;
+    aiWorkerStart(&game, &request);
+}
+
+// 对手(人)思考时在后台继续搜索当前局面, 对手落子后 AI 复用对应子树
+static void startPondering() {
+    if (!config.aiPonder || gameMode != 2 || gameState.currentPlayer != BLACK) return;
+
+    AIRequest request;
+    request.task = AI_TASK_PONDER;
+    buildSearchParams(&request.params);
+    request.difficulty = config.aiDifficulty;
+    aiWorkerStart(&game, &request);
+}
+
+// 在后台计算提示; AI 正在思考时忽略
+// 后台思考中直接取搜索树的结果(访问太少时用启发式), 不打断思考
+void requestHint() {
+    if (aiWorkerPondering()) {
+        if (!aiWorkerPeekMove(MCTS_HINT_MIN_VISITS, &hintX, &hintY)) {
+            getHintMove(&hintX, &hintY);
+        }
+        drawBoard();
+        return;
+    }
+    if (aiWorkerBusy()) return;
+
+    AIRequest request;
+    request.task = AI_TASK_HINT;
+    buildSearchParams(&request.params);
+    request.difficulty = config.aiDifficulty;
+    aiWorkerStart(&game, &request);
+}
+
+// 取消后台计算(悔棋、载入、返回菜单等改变局面的操作之前调用)
+void cancelAI() {
+    aiWorkerCancel();
+}
+
+// AI 是否正在后台计算
+int aiThinking() {
+    return aiWorkerBusy();
+}
+
+// 主循环中轮询: 后台结果到达时落子或显示提示并重绘
+void pollAIResult() {
+    AIResult result;
+    if (!aiWorkerPoll(&result)) return;
+    if (result.task == AI_TASK_PONDER) return; // 节点池用满, 后台思考自行结束
+
+    if (result.task == AI_TASK_MOVE) {
+        if (result.search.playouts > 0) {
+            searchIterationMs = result.search.elapsedMs * result.search.threads / result.search.playouts;
+        }
+        if (gameMode == 2 && result.x >= 0 && result.y >= 0) {
+            placeStone(result.x, result.y);
+            startPondering();
+        }
+        else if (gameMode == 2) {
+            clockStop(&gameClock); // AI 停一手: 界面没有停一手, 对局到此结束, 停表
+        }
+    }
+    else if (result.task == AI_TASK_HINT) {
+        hintX = result.x;
+        hintY = result.y;
+    }
+    drawBoard();
+}
+
+#define SCORE_ESTIMATE_PLAYOUTS 1000 // 数目时形势判断至少累计的模拟次数
+
+static OwnershipMap ownershipMap;
+static unsigned long long ownershipHash = 0;
+static int ownershipMoves = -1;
+
+// 当前局面的形势判断: 局面变了就再做 playouts 次模拟(变化不大时保留旧样本),
+// 没变时只在样本不足 playouts 次时补足
+const OwnershipMap* currentOwnership(int playouts) {
+    int changed = ownershipMoves != gameState.moveCount || ownershipHash != gameState.hash;
+    int missing = changed ? playouts : playouts - (int)ownershipMap.weight;
+    if (missing > 0) {
+        unsigned int seed = (unsigned int)rand() * 2654435761u + (unsigned int)gameState.moveCount;
+        ownershipUpdate(&ownershipMap, &gameState, config.komi, missing, config.aiThreads, seed);
+        ownershipMoves = gameState.moveCount;
+        ownershipHash = gameState.hash;
+    }
+    return &ownershipMap;
+}
+
+// 计算目数: 随机对局估计各点归属并去掉死子后数目, 同时给出胜率和按盘面直接数子(Tromp-Taylor)的结果
+void calculateScore() {
+    const OwnershipMap* map = currentOwnership(SCORE_ESTIMATE_PLAYOUTS);
+    float areaMargin = stateAreaScore(&gameState, config.komi, NULL);
+
+    TCHAR msg[600];
+    _stprintf(msg, _T("形势判断(有效样本 %d 局):\n\n死子: 黑 %d 白 %d\n去掉死子数目(含贴目 %.1f): %s领先 %.1f目\n")
+        _T("随机对局终局目差: 黑方 %+.1f ± %.1f\n黑方胜率: %.0f%%\n\n按盘面直接数子: %s胜 %.1f目"),
+        (int)map->weight, map->deadBlack, map->deadWhite, config.komi,
+        map->score > 0 ? _T("黑方") : _T("白方"), (float)fabs(map->score),
+        map->scoreMean, map->scoreStdDev, map->blackWinRate * 100.0f,
+        areaMargin > 0 ? _T("黑方") : _T("白方"), (float)fabs(areaMargin));
+
+    MessageBox(GetHWnd(), msg, _T("对局结果"), MB_OK);
+}
+
+// 主菜单
+void showMainMenu() {
+    cancelAI(); // 返回菜单时停止后台思考
+    invalidateBoard(); // 菜单覆盖了棋盘, 回到对局时整屏重画
+    cleardevice();
+
+    // 渐变背景
+    for (int y = 0; y < WINDOW_HEIGHT; y++) {
+        int r = 220 - y / 15;
+        int g = 179 - y / 20;
+        int b = 92 - y / 25;
+        if (r < 180) r = 180;
+        if (g < 140) g = 140;
+        if (b < 60) b = 60;
+        setlinecolor(RGB(r, g, b));
+        line(0, y, WINDOW_WIDTH, y);
+    }
+
+    setbkmode(TRANSPARENT);
+    settextcolor(RGB(139, 90, 43));
+
+    // 标题
+    settextstyle(50, 0, _T("楷体"));
+    TCHAR title[] = _T("围 棋 游 戏");
+    outtextxy(320, 80, title);
+
+    settextstyle(16, 0, _T("宋体"));
+
+    // 菜单按钮
+    setlinecolor(RGB(139, 90, 43));
+    setlinestyle(PS_SOLID, 3);
+
+    int buttonX = 340;
+    int buttonW = 220;
+    int startY = 200;
+    int buttonH = 50;
+    int gap = 20;
+
+    const TCHAR* menuItems[] = {
+        _T("人人对战 [1]"),
+        _T("人机对战 [2]"),
+        _T("载入游戏 [3]"),
+        _T("游戏说明 [4]"),
+        _T("退出 [ESC]")
+    };
+
+    for (int i = 0; i < 5; i++) {
+        int y = startY + i * (buttonH + gap);
+
+        setfillcolor(RGB(200, 150, 80));
+        fillroundrect(buttonX, y, buttonX + buttonW, y + buttonH, 10, 10);
+        setfillcolor(RGB(240, 200, 120));
+        fillroundrect(buttonX + 2, y + 2, buttonX + buttonW - 2, y + buttonH - 2, 8, 8);
+
+        settextcolor(RGB(80, 50, 20));
+        int textX = buttonX + (buttonW - textwidth((TCHAR*)menuItems[i])) / 2;
+        outtextxy(textX, y + 15, (TCHAR*)menuItems[i]);
+    }
+
+    // 制作者信息
+    settextstyle(13, 0, _T("宋体"));
+    settextcolor(RGB(100, 60, 20));
+    outtextxy(320, 600, _T("制作者: 技术科学试验班"));
+    outtextxy(280, 620, _T("251880102 忽哲    251880599 唐翊添"));
+    outtextxy(280, 640, _T("2518801370 李卓洵  251880107 马耀宗"));
+}
+
+// 处理菜单点击
+void handleMenuClick(int x, int y) {
+    int buttonX = 340;
+    int buttonW = 220;
+    int startY = 200;
+    int buttonH = 50;
+    int gap = 20;
+
+    if (x >= buttonX && x <= buttonX + buttonW) {
+        for (int i = 0; i < 5; i++) {
+            int btnY = startY + i * (buttonH + gap);
+            if (y >= btnY && y <= btnY + buttonH) {
+                switch (i) {
+                case 0: // 人人对战
+                    gameMode = 1;
+                    initGame();
+                    drawBoard();
+                    break;
+                case 1: // 人机对战
+                    gameMode = 2;
+                    initGame();
+                    drawBoard();
+                    break;
+                case 2: // 载入游戏
+                    loadGame("savegame.txt");
+                    gameMode = 1;
+                    drawBoard();
+                    break;
+                case 3: // 游戏说明
+                    showHelp();
+                    break;
+                case 4: // 退出
+                    exit(0);
+                    break;
+                }
+                break;
+            }
+        }
+    }
 }
\ No newline at end of file
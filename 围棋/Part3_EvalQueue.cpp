@@ -0,0 +1,272 @@
+/*
+ * 围棋游戏系统 - Part 3: 网络估值批量队列实现
+ * 负责人: 2518801370 李卓洵
+ * 实现: 提交线程查缓存并编码输入特征, 未命中的请求排队; 估值线程在攒满一批或最早的请求等够
+ *       最长等待时间时取出一批, 同一批里相同的局面只算一次, 算完写缓存并逐个回调
+ *       缓存直接映射, 以局面哈希(含轮走方、劫和最近几手)为键, 与队列共用一把锁
+ */
+
+#include "Part3_EvalQueue.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+typedef std::chrono::steady_clock EvalClock;
+
+// 排队中的请求
+typedef struct {
+    unsigned long long key;
+    EvalCallback callback;
+    void* context;
+    EvalClock::time_point submitted;
+    std::vector<float> planes; // featuresEncode 的输出
+} EvalPending;
+
+typedef struct {
+    unsigned long long key;
+    float value;
+    int valid;
+} EvalCacheEntry;
+
+struct EvalQueue {
+    const Network* net;
+    int maxBatch;
+    int maxWaitUs;
+    int outputs;                  // 每个局面的策略输出数 size*size+1
+    std::mutex mutex;
+    std::condition_variable wake; // 有新请求或要退出时通知估值线程
+    std::deque<EvalPending> pending;
+    int stopping;
+    std::thread worker;
+
+    std::vector<EvalCacheEntry> cache;
+    std::vector<float> cachePolicy; // [条目][outputs]
+    unsigned int cacheMask;
+
+    long long requests;
+    long long cacheHits;
+    long long merged;
+    long long evaluated;
+    long long batches;
+    double waitUs;                // 排队请求的等待时间合计
+};
+
+// 缓存键: 棋子的 Zobrist 哈希再混入轮走方、劫争禁着点和最近几手(它们也是网络的输入)
+static unsigned long long positionKey(const GameState* gs, const short* recent) {
+    unsigned long long key = gs->hash;
+    if (gs->currentPlayer == WHITE) key ^= 0x9E3779B97F4A7C15ull;
+    if (gs->koPoint >= 0) key ^= (unsigned long long)(gs->koPoint + 1) * 0xC2B2AE3D27D4EB4Full;
+    for (int k = 0; recent != NULL && k < FEATURE_HISTORY; k++) {
+        key = (key ^ (unsigned long long)(recent[k] + 2)) * 0x100000001B3ull;
+    }
+    return key;
+}
+
+// 查缓存, 命中时复制结果; 调用时持有锁
+static int cacheLookup(EvalQueue* queue, unsigned long long key, float* policy, float* value) {
+    if (queue->cache.empty()) return 0;
+    const EvalCacheEntry* entry = &queue->cache[key & queue->cacheMask];
+    if (!entry->valid || entry->key != key) return 0;
+    memcpy(policy, &queue->cachePolicy[(size_t)(key & queue->cacheMask) * queue->outputs], sizeof(float) * queue->outputs);
+    *value = entry->value;
+    return 1;
+}
+
+// 写缓存(直接覆盖原有条目); 调用时持有锁
+static void cacheStore(EvalQueue* queue, unsigned long long key, const float* policy, float value) {
+    if (queue->cache.empty()) return;
+    EvalCacheEntry* entry = &queue->cache[key & queue->cacheMask];
+    entry->key = key;
+    entry->value = value;
+    entry->valid = 1;
+    memcpy(&queue->cachePolicy[(size_t)(key & queue->cacheMask) * queue->outputs], policy, sizeof(float) * queue->outputs);
+}
+
+// 估值线程: 等到攒满一批或最早的请求等够时间, 计算这一批并回调, 退出前把剩下的请求都算完
+static void evalWorker(EvalQueue* queue) {
+    int planeSize = FEATURE_PLANES * queue->net->size * queue->net->size;
+    std::vector<EvalPending> batch;
+    std::vector<int> source(queue->maxBatch); // 每个请求的结果在本批计算中的下标
+    std::vector<float> input((size_t)queue->maxBatch * planeSize);
+    std::vector<float> policy((size_t)queue->maxBatch * queue->outputs);
+    std::vector<float> value(queue->maxBatch);
+
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    for (;;) {
+        queue->wake.wait(lock, [queue] { return queue->stopping || !queue->pending.empty(); });
+        if (queue->pending.empty()) break; // 要退出且没有请求了
+
+        EvalClock::time_point deadline = queue->pending.front().submitted + std::chrono::microseconds(queue->maxWaitUs);
+        while (!queue->stopping && (int)queue->pending.size() < queue->maxBatch && EvalClock::now() < deadline) {
+            queue->wake.wait_until(lock, deadline);
+        }
+
+        batch.clear();
+        while (!queue->pending.empty() && (int)batch.size() < queue->maxBatch) {
+            batch.push_back(std::move(queue->pending.front()));
+            queue->pending.pop_front();
+        }
+        lock.unlock();
+
+        // 同一批中相同的局面只算一次
+        int count = 0;
+        for (int i = 0; i < (int)batch.size(); i++) {
+            source[i] = -1;
+            for (int k = 0; k < i; k++) {
+                if (batch[k].key == batch[i].key) {
+                    source[i] = source[k];
+                    break;
+                }
+            }
+            if (source[i] >= 0) continue;
+            memcpy(&input[(size_t)count * planeSize], batch[i].planes.data(), sizeof(float) * planeSize);
+            source[i] = count++;
+        }
+        networkEvaluate(queue->net, input.data(), count, policy.data(), value.data());
+
+        EvalClock::time_point done = EvalClock::now();
+        double waitUs = 0.0;
+        for (int i = 0; i < (int)batch.size(); i++) {
+            const float* p = &policy[(size_t)source[i] * queue->outputs];
+            batch[i].callback(batch[i].context, p, value[source[i]]);
+            waitUs += std::chrono::duration<double, std::micro>(done - batch[i].submitted).count();
+        }
+
+        lock.lock();
+        for (int i = 0; i < (int)batch.size(); i++) {
+            cacheStore(queue, batch[i].key, &policy[(size_t)source[i] * queue->outputs], value[source[i]]);
+        }
+        queue->evaluated += count;
+        queue->merged += (long long)batch.size() - count;
+        queue->batches++;
+        queue->waitUs += waitUs;
+    }
+}
+
+// 创建队列并启动估值线程; maxBatch 为每批的局面数上限, maxWaitUs 为请求最多等多久就开算(微秒),
+// cacheEntries 为缓存的条目数(向下取到 2 的幂, 0 表示不缓存)
+EvalQueue* evalQueueCreate(const Network* net, int maxBatch, int maxWaitUs, int cacheEntries) {
+    if (net == NULL) return NULL;
+    EvalQueue* queue = new EvalQueue();
+    queue->net = net;
+    queue->maxBatch = maxBatch < 1 ? 1 : (maxBatch > EVAL_MAX_BATCH ? EVAL_MAX_BATCH : maxBatch);
+    queue->maxWaitUs = maxWaitUs < 0 ? 0 : maxWaitUs;
+    queue->outputs = net->size * net->size + 1;
+    queue->stopping = 0;
+
+    queue->cacheMask = 0;
+    if (cacheEntries > 0) {
+        unsigned int entries = 1;
+        while (entries * 2 <= (unsigned int)cacheEntries && entries < (1u << 24)) entries *= 2;
+        queue->cache.assign(entries, EvalCacheEntry());
+        queue->cachePolicy.assign((size_t)entries * queue->outputs, 0.0f);
+        queue->cacheMask = entries - 1;
+    }
+    evalQueueResetStats(queue);
+    queue->worker = std::thread(evalWorker, queue);
+    return queue;
+}
+
+// 算完已提交的请求后停止估值线程并释放
+void evalQueueDestroy(EvalQueue* queue) {
+    if (queue == NULL) return;
+    {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        queue->stopping = 1;
+    }
+    queue->wake.notify_one();
+    queue->worker.join();
+    delete queue;
+}
+
+const Network* evalQueueNetwork(const EvalQueue* queue) {
+    return queue->net;
+}
+
+// 提交一个局面, recent 为最近几手(见 featuresEncode, 可为 NULL); 缓存命中时立即在本线程回调, 否则排队等估值线程回调
+void evalQueueSubmit(EvalQueue* queue, const GameState* gs, const short* recent, EvalCallback callback, void* context) {
+    unsigned long long key = positionKey(gs, recent);
+    float hitPolicy[MAX_POINTS + 1];
+    float hitValue;
+    int hit;
+    {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        queue->requests++;
+        hit = cacheLookup(queue, key, hitPolicy, &hitValue);
+        if (hit) queue->cacheHits++;
+    }
+    if (hit) {
+        callback(context, hitPolicy, hitValue);
+        return;
+    }
+
+    EvalPending request;
+    request.key = key;
+    request.callback = callback;
+    request.context = context;
+    request.planes.resize(FEATURE_PLANES * queue->net->size * queue->net->size);
+    featuresEncode(gs, recent, 0, request.planes.data()); // 编码在提交线程中并行完成
+    request.submitted = EvalClock::now();
+
+    size_t waiting;
+    {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        queue->pending.push_back(std::move(request));
+        waiting = queue->pending.size();
+    }
+    // 第一个请求让估值线程开始计时, 攒满一批时让它立即开算
+    if (waiting == 1 || (int)waiting >= queue->maxBatch) queue->wake.notify_one();
+}
+
+// evalQueueEvaluate 等待中的调用方
+typedef struct {
+    float* policy;
+    float* value;
+    int outputs;
+    std::promise<void> done;
+} EvalWaiter;
+
+static void fulfilWaiter(void* context, const float* policy, float value) {
+    EvalWaiter* waiter = (EvalWaiter*)context;
+    if (waiter->policy != NULL) memcpy(waiter->policy, policy, sizeof(float) * waiter->outputs);
+    *waiter->value = value;
+    waiter->done.set_value();
+}
+
+// 提交一个局面并等待结果; recent、policy(可为 NULL)和 value 的含义同 networkEvaluateState
+void evalQueueEvaluate(EvalQueue* queue, const GameState* gs, const short* recent, float* policy, float* value) {
+    EvalWaiter waiter;
+    waiter.policy = policy;
+    waiter.value = value;
+    waiter.outputs = queue->outputs;
+    std::future<void> result = waiter.done.get_future();
+    evalQueueSubmit(queue, gs, recent, fulfilWaiter, &waiter);
+    result.wait();
+}
+
+void evalQueueStats(EvalQueue* queue, EvalQueueStats* stats) {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    stats->requests = queue->requests;
+    stats->cacheHits = queue->cacheHits;
+    stats->merged = queue->merged;
+    stats->evaluated = queue->evaluated;
+    stats->batches = queue->batches;
+    stats->averageBatch = queue->batches > 0 ? (double)queue->evaluated / queue->batches : 0.0;
+    stats->averageFill = stats->averageBatch / queue->maxBatch;
+    long long queued = queue->evaluated + queue->merged;
+    stats->averageWaitUs = queued > 0 ? queue->waitUs / queued : 0.0;
+}
+
+void evalQueueResetStats(EvalQueue* queue) {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    queue->requests = 0;
+    queue->cacheHits = 0;
+    queue->merged = 0;
+    queue->evaluated = 0;
+    queue->batches = 0;
+    queue->waitUs = 0.0;
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+/*
+ * 围棋游戏系统 - Part 3: 网络估值批量队列
+ * 负责人: 2518801370 李卓洵
+ * 包含: 多个搜索线程共用的估值服务: 把各线程提交的叶节点局面攒成一批, 由一个估值线程一次算完,
+ *       结果通过回调(或 evalQueueEvaluate 内部的 future)交还; 按局面哈希缓存结果, 重复的叶节点不再计算
+ * 说明: 不依赖 EasyX; 批大小上限和最长等待时间在 config.txt 中调节,
+ *       批越大吞吐越高, 等待越长单个局面的延迟越大
+ */
+
+#ifndef PART3_EVALQUEUE_H
+#define PART3_EVALQUEUE_H
+
+#include "Part3_Network.h"
+
+#define EVAL_MAX_BATCH 256
+#define EVAL_DEFAULT_BATCH 16      // config.txt 中 EvalBatchSize 的默认值
+#define EVAL_DEFAULT_WAIT_US 500   // EvalMaxWaitUs 的默认值
+#define EVAL_DEFAULT_CACHE 8192    // EvalCacheEntries 的默认值
+
+// 估值完成时在估值线程(缓存命中时在提交线程)中调用; policy 按 x * size + y 排列, 最后一项为停一手
+typedef void (*EvalCallback)(void* context, const float* policy, float value);
+
+typedef struct {
+    long long requests;     // 提交的局面数
+    long long cacheHits;    // 直接由缓存给出结果的
+    long long merged;       // 与同一批中相同局面合并的
+    long long evaluated;    // 网络实际计算的局面数
+    long long batches;
+    double averageBatch;    // 平均每批计算的局面数
+    double averageFill;     // averageBatch / 批大小上限
+    double averageWaitUs;   // 排队的请求从提交到拿到结果的平均时间(不含缓存命中)
+} EvalQueueStats;
+
+typedef struct EvalQueue EvalQueue;
+
+EvalQueue* evalQueueCreate(const Network* net, int maxBatch, int maxWaitUs, int cacheEntries);
+void evalQueueDestroy(EvalQueue* queue);
+const Network* evalQueueNetwork(const EvalQueue* queue);
+void evalQueueSubmit(EvalQueue* queue, const GameState* gs, const short* recent, EvalCallback callback, void* context);
+void evalQueueEvaluate(EvalQueue* queue, const GameState* gs, const short* recent, float* policy, float* value);
+void evalQueueStats(EvalQueue* queue, EvalQueueStats* stats);
+void evalQueueResetStats(EvalQueue* queue);
+
+#endif // PART3_EVALQUEUE_H
\ No newline at end of file
@@ -0,0 +1,138 @@
+/*
+ * 围棋游戏系统 - Part 3: 输入特征编码实现
+ * 负责人: 2518801370 李卓洵
+ * 平面(都从走子方看, 每个平面 size*size 个 float, 点 (x, y) 在第 x * size + y 个, 对称变换后的位置见 featuresTransform):
+ *   0 己方子  1 对方子  2 空点
+ *   3~6  己方棋串的气为 1/2/3/4 及以上
+ *   7~10 对方棋串的气为 1/2/3/4 及以上
+ *   11~14 最近第 1~4 手的落点(停一手或没有时该平面全 0)
+ *   15 劫争禁着点  16 黑方走时全 1  17 全 1(标出棋盘范围, 卷积补的边是 0)
+ * 对称变换 symmetry 为 0~7: 位 2 先沿主对角线翻转, 位 0 再上下翻转, 位 1 再左右翻转
+ */
+
+#include "Part3_Features.h"
+#include "Part1_BoardTables.h"
+
+#define PLANE_OWN 0
+#define PLANE_EMPTY 2
+#define PLANE_LIBERTIES 3
+#define PLANE_RECENT 11
+#define PLANE_KO 15
+#define PLANE_BLACK 16
+#define PLANE_ONES 17
+
+// 点 (x, y) 在对称变换后的位置 x' * size + y'
+static inline int transformPoint(int symmetry, int x, int y, int size) {
+    if (symmetry & 4) {
+        int t = x; x = y; y = t;
+    }
+    if (symmetry & 1) x = size - 1 - x;
+    if (symmetry & 2) y = size - 1 - y;
+    return x * size + y;
+}
+
+// 第 point(x * size + y) 点在对称变换后的位置
+int featuresTransform(int symmetry, int point, int size) {
+    return transformPoint(symmetry, point / size, point % size, size);
+}
+
+// 棋串的真实气数, 数到 4 口为止; mark 中标记为 stamp 的空点已经数过
+static int countLiberties(const GameState* gs, int head, unsigned short* mark, unsigned short stamp) {
+    int libs = 0;
+    int p = head;
+    do {
+        for (int i = 0; i < 4; i++) {
+            int q = p + neighborOffset[i];
+            if (gs->cells[q] == EMPTY && mark[q] != stamp) {
+                mark[q] = stamp;
+                if (++libs >= 4) return 4;
+            }
+        }
+        p = gs->chainNext[p];
+    } while (p != head);
+    return libs;
+}
+
+// 把 gs 编码到 out(FEATURE_PLANES * size * size 个 float); recent 为最近的 FEATURE_HISTORY 手
+// (x * BOARD_SIZE + y, 最近的在前, -1 表示停一手或没有), 可为 NULL
+void featuresEncode(const GameState* gs, const short* recent, int symmetry, float* out) {
+    int n = gs->size;
+    int points = n * n;
+    int own = gs->currentPlayer;
+    memset(out, 0, sizeof(float) * FEATURE_PLANES * points);
+
+    float* ones = out + PLANE_ONES * points;
+    for (int i = 0; i < points; i++) ones[i] = 1.0f;
+    if (own == BLACK) memcpy(out + PLANE_BLACK * points, ones, sizeof(float) * points);
+
+    // 每串的气数在遇到它的第一个子时数一次, 记在代表点上
+    unsigned char libsOf[PADDED_POINTS];
+    unsigned short mark[PADDED_POINTS];
+    memset(libsOf, 0, sizeof(libsOf));
+    memset(mark, 0, sizeof(mark));
+    unsigned short stamp = 0;
+
+    for (int x = 0; x < n; x++) {
+        for (int y = 0; y < n; y++) {
+            int d = transformPoint(symmetry, x, y, n);
+            int p = PAD_INDEX(x, y);
+            int c = gs->cells[p];
+            if (c == EMPTY) {
+                out[PLANE_EMPTY * points + d] = 1.0f;
+                continue;
+            }
+            int side = c == own ? 0 : 1;
+            int head = gs->chainHead[p];
+            if (libsOf[head] == 0) libsOf[head] = (unsigned char)countLiberties(gs, head, mark, ++stamp);
+            out[(PLANE_OWN + side) * points + d] = 1.0f;
+            out[(PLANE_LIBERTIES + side * 4 + libsOf[head] - 1) * points + d] = 1.0f;
+        }
+    }
+
+    for (int k = 0; recent != NULL && k < FEATURE_HISTORY; k++) {
+        if (recent[k] < 0) continue;
+        out[(PLANE_RECENT + k) * points + transformPoint(symmetry, recent[k] / BOARD_SIZE, recent[k] % BOARD_SIZE, n)] = 1.0f;
+    }
+    if (gs->koPoint >= 0) {
+        out[PLANE_KO * points + transformPoint(symmetry, gs->koPoint / BOARD_SIZE, gs->koPoint % BOARD_SIZE, n)] = 1.0f;
+    }
+}
+
+// 成批编码到连续的张量 [count][FEATURE_PLANES][size * size], 各局面路数须相同;
+// recent 和 symmetries 可为 NULL(都没有最近几手 / 都不变换)
+void featuresEncodeBatch(const GameState* const* states, const short* const* recent, const int* symmetries,
+    int count, float* out) {
+    if (count <= 0) return;
+    size_t stride = (size_t)FEATURE_PLANES * states[0]->size * states[0]->size;
+    for (int i = 0; i < count; i++) {
+        featuresEncode(states[i], recent != NULL ? recent[i] : NULL, symmetries != NULL ? symmetries[i] : 0,
+            out + i * stride);
+    }
+}
+
+// 从棋谱取最近的 FEATURE_HISTORY 手, 不够的填 -1
+void featuresRecentMoves(const Position* pos, short recent[FEATURE_HISTORY]) {
+    for (int k = 0; k < FEATURE_HISTORY; k++) {
+        int i = pos->historyCount - 1 - k;
+        recent[k] = i >= 0 ? (short)(pos->history[i].x * BOARD_SIZE + pos->history[i].y) : -1;
+    }
+}
+
+// 分配 count 个 size 路局面的输入张量, 按 FEATURE_ALIGN 对齐, 用 featuresFree 释放
+float* featuresAlloc(int count, int size) {
+    size_t bytes = sizeof(float) * FEATURE_PLANES * size * size * (count > 0 ? count : 1);
+    bytes = (bytes + FEATURE_ALIGN - 1) / FEATURE_ALIGN * FEATURE_ALIGN;
+#if defined(_MSC_VER)
+    return (float*)_aligned_malloc(bytes, FEATURE_ALIGN);
+#else
+    return (float*)aligned_alloc(FEATURE_ALIGN, bytes);
+#endif
+}
+
+void featuresFree(float* buffer) {
+#if defined(_MSC_VER)
+    _aligned_free(buffer);
+#else
+    free(buffer);
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,27 @@
+/*
+ * 围棋游戏系统 - Part 3: 输入特征编码
+ * 负责人: 2518801370 李卓洵
+ * 包含: 把局面和最近几手编码成策略价值网络的输入平面, 单个局面和成批两种接口, 可同时做 D8 对称变换
+ * 说明: 不依赖 EasyX; 只扫一遍棋盘, 棋串的气数每串只数一次; 输出写进调用方给出的缓冲区
+ *       (用 featuresAlloc 分配时按 FEATURE_ALIGN 对齐), 搜索时的估值和自对弈数据共用这一种编码
+ */
+
+#ifndef PART3_FEATURES_H
+#define PART3_FEATURES_H
+
+#include "Part1_Position.h"
+
+#define FEATURE_HISTORY 4   // 编码最近几手的落点
+#define FEATURE_PLANES 18   // 平面数, 各平面的含义见 Part3_Features.cpp
+#define FEATURE_ALIGN 64    // featuresAlloc 返回的缓冲区按此对齐(一条缓存行, 也是 AVX-512 的宽度)
+#define FEATURE_SYMMETRIES 8
+
+void featuresEncode(const GameState* gs, const short* recent, int symmetry, float* out);
+void featuresEncodeBatch(const GameState* const* states, const short* const* recent, const int* symmetries,
+    int count, float* out);
+void featuresRecentMoves(const Position* pos, short recent[FEATURE_HISTORY]);
+int featuresTransform(int symmetry, int point, int size);
+float* featuresAlloc(int count, int size);
+void featuresFree(float* buffer);
+
+#endif // PART3_FEATURES_H
\ No newline at end of file
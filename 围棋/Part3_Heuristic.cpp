@@ -0,0 +1,266 @@
+/*
+ * 围棋游戏系统 - Part 3: 整盘启发式评分实现
+ * 负责人: 2518801370 李卓洵
+ * 实现: 把棋盘拆成己方/对方/空点三个带边框的平面, 邻居计数用平移相加(卷积)一次算完整盘,
+ *       吃子加分直接取自叫吃棋串的最后一口气, 征子和救子的加减分来自 Part3_Tactics 的读秒;
+ *       选点时先用 Part3_LifeDeath 找被围住的棋块的死活急所
+ */
+
+#include "Part3_Heuristic.h"
+#include "Part1_BoardTables.h"
+#include "Part3_Tactics.h"
+#include "Part3_LifeDeath.h"
+#include <stdint.h>
+
+// 与位棋盘相同, 定义 BB_NO_SIMD 可强制使用标量实现
+#if !defined(BB_NO_SIMD) && defined(__AVX2__)
+#define HEUR_USE_AVX2 1
+#include <immintrin.h>
+#elif !defined(BB_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define HEUR_USE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// 平面与 GameState.cells 一样加一圈边框, 邻居下标就是固定偏移, 内层循环没有边界判断
+#define PLANE_STRIDE PAD_SIZE
+#define PLANE_CELLS PADDED_POINTS
+#define PLANE_FIRST (PLANE_STRIDE + 1)
+#define PLANE_END(n) (PAD_INDEX((n) - 1, (n) - 1) + 1) // n 路棋盘最后一个交叉点之后
+#define PLANE_ALLOC (PLANE_CELLS + 32) // 末尾留出整向量读写的余量
+
+// 与局面无关的位置分: 角 25, 边 15, 中腹按离天元的距离递减, 星位再加 10
+typedef struct {
+    int16_t score[PLANE_ALLOC];
+} PositionalTable;
+
+template <int N>
+constexpr PositionalTable buildPositionalTable() {
+    PositionalTable t = {};
+    const SizeTables& tables = sizeTables<N>;
+    int center = N / 2;
+    for (int x = 0; x < N; x++) {
+        for (int y = 0; y < N; y++) {
+            int p = x * BOARD_SIZE + y;
+            int score = 0;
+            if (tables.region[p] == REGION_CORNER) {
+                score = 25;
+            }
+            else if (tables.region[p] == REGION_SIDE) {
+                score = 15;
+            }
+            else {
+                int dist = (x > center ? x - center : center - x) + (y > center ? y - center : center - y);
+                score = 10 - dist / 2;
+            }
+            if (tables.isStar[p]) {
+                score += 10;
+            }
+            t.score[PAD_INDEX(x, y)] = (int16_t)score;
+        }
+    }
+    return t;
+}
+
+template <int N>
+constexpr PositionalTable positional = buildPositionalTable<N>();
+
+// 邻居卷积: total = 位置分 + fw * 8邻域己方子 + ew * 8邻域对方子 + 3 * 4邻域空点
+// N 路棋盘的整段连续下标一次处理, 边框和盘外格的结果不会被读取
+#if defined(HEUR_USE_AVX2)
+
+static inline __m256i load16(const int16_t* a, int i) {
+    return _mm256_loadu_si256((const __m256i*)(a + i));
+}
+
+static inline __m256i sum8(const int16_t* a, int i) {
+    __m256i up = _mm256_add_epi16(_mm256_add_epi16(load16(a, i - PLANE_STRIDE - 1), load16(a, i - PLANE_STRIDE)),
+        load16(a, i - PLANE_STRIDE + 1));
+    __m256i mid = _mm256_add_epi16(load16(a, i - 1), load16(a, i + 1));
+    __m256i down = _mm256_add_epi16(_mm256_add_epi16(load16(a, i + PLANE_STRIDE - 1), load16(a, i + PLANE_STRIDE)),
+        load16(a, i + PLANE_STRIDE + 1));
+    return _mm256_add_epi16(_mm256_add_epi16(up, mid), down);
+}
+
+static inline __m256i sum4(const int16_t* a, int i) {
+    return _mm256_add_epi16(_mm256_add_epi16(load16(a, i - PLANE_STRIDE), load16(a, i - 1)),
+        _mm256_add_epi16(load16(a, i + 1), load16(a, i + PLANE_STRIDE)));
+}
+
+template <int N>
+static void convolve(const int16_t* own, const int16_t* enemy, const int16_t* empty,
+    int16_t friendWeight, int16_t enemyWeight, int16_t* total) {
+    __m256i fw = _mm256_set1_epi16(friendWeight);
+    __m256i ew = _mm256_set1_epi16(enemyWeight);
+    __m256i lw = _mm256_set1_epi16(3);
+    for (int i = PLANE_FIRST; i < PLANE_END(N); i += 16) {
+        __m256i v = load16(positional<N>.score, i);
+        v = _mm256_add_epi16(v, _mm256_mullo_epi16(fw, sum8(own, i)));
+        v = _mm256_add_epi16(v, _mm256_mullo_epi16(ew, sum8(enemy, i)));
+        v = _mm256_add_epi16(v, _mm256_mullo_epi16(lw, sum4(empty, i)));
+        _mm256_storeu_si256((__m256i*)(total + i), v);
+    }
+}
+
+#elif defined(HEUR_USE_SSE2)
+
+static inline __m128i load8(const int16_t* a, int i) {
+    return _mm_loadu_si128((const __m128i*)(a + i));
+}
+
+static inline __m128i sum8(const int16_t* a, int i) {
+    __m128i up = _mm_add_epi16(_mm_add_epi16(load8(a, i - PLANE_STRIDE - 1), load8(a, i - PLANE_STRIDE)),
+        load8(a, i - PLANE_STRIDE + 1));
+    __m128i mid = _mm_add_epi16(load8(a, i - 1), load8(a, i + 1));
+    __m128i down = _mm_add_epi16(_mm_add_epi16(load8(a, i + PLANE_STRIDE - 1), load8(a, i + PLANE_STRIDE)),
+        load8(a, i + PLANE_STRIDE + 1));
+    return _mm_add_epi16(_mm_add_epi16(up, mid), down);
+}
+
+static inline __m128i sum4(const int16_t* a, int i) {
+    return _mm_add_epi16(_mm_add_epi16(load8(a, i - PLANE_STRIDE), load8(a, i - 1)),
+        _mm_add_epi16(load8(a, i + 1), load8(a, i + PLANE_STRIDE)));
+}
+
+template <int N>
+static void convolve(const int16_t* own, const int16_t* enemy, const int16_t* empty,
+    int16_t friendWeight, int16_t enemyWeight, int16_t* total) {
+    __m128i fw = _mm_set1_epi16(friendWeight);
+    __m128i ew = _mm_set1_epi16(enemyWeight);
+    __m128i lw = _mm_set1_epi16(3);
+    for (int i = PLANE_FIRST; i < PLANE_END(N); i += 8) {
+        __m128i v = load8(positional<N>.score, i);
+        v = _mm_add_epi16(v, _mm_mullo_epi16(fw, sum8(own, i)));
+        v = _mm_add_epi16(v, _mm_mullo_epi16(ew, sum8(enemy, i)));
+        v = _mm_add_epi16(v, _mm_mullo_epi16(lw, sum4(empty, i)));
+        _mm_storeu_si128((__m128i*)(total + i), v);
+    }
+}
+
+#else
+
+static inline int16_t sum8(const int16_t* a, int i) {
+    return (int16_t)(a[i - PLANE_STRIDE - 1] + a[i - PLANE_STRIDE] + a[i - PLANE_STRIDE + 1] +
+        a[i - 1] + a[i + 1] +
+        a[i + PLANE_STRIDE - 1] + a[i + PLANE_STRIDE] + a[i + PLANE_STRIDE + 1]);
+}
+
+static inline int16_t sum4(const int16_t* a, int i) {
+    return (int16_t)(a[i - PLANE_STRIDE] + a[i - 1] + a[i + 1] + a[i + PLANE_STRIDE]);
+}
+
+template <int N>
+static void convolve(const int16_t* own, const int16_t* enemy, const int16_t* empty,
+    int16_t friendWeight, int16_t enemyWeight, int16_t* total) {
+    for (int i = PLANE_FIRST; i < PLANE_END(N); i++) {
+        total[i] = (int16_t)(positional<N>.score[i] +
+            friendWeight * sum8(own, i) +
+            enemyWeight * sum8(enemy, i) +
+            3 * sum4(empty, i));
+    }
+}
+
+#endif
+
+// N 路棋盘的整盘分数, 见 heuristicMap
+template <int N>
+static void heuristicMapSized(const GameState* gs, int difficulty, int scores[MAX_POINTS]) {
+    int color = gs->currentPlayer;
+    int opponent = (color == BLACK) ? WHITE : BLACK;
+    int16_t friendWeight = difficulty == 3 ? 7 : 5;
+    int16_t enemyWeight = difficulty == 3 ? 1 : 3;
+
+    alignas(32) int16_t own[PLANE_ALLOC] = { 0 };
+    alignas(32) int16_t enemy[PLANE_ALLOC] = { 0 };
+    alignas(32) int16_t empty[PLANE_ALLOC] = { 0 };
+    alignas(32) int16_t total[PLANE_ALLOC];
+
+    // 直接按带边框棋盘拆平面, OFF_BOARD 在三个平面里都是 0; 第 N 行之后本来就是 0
+    for (int i = 0; i < PAD_INDEX(N, 0); i++) {
+        int c = gs->cells[i];
+        own[i] = (int16_t)(c == color);
+        enemy[i] = (int16_t)(c == opponent);
+        empty[i] = (int16_t)(c == EMPTY);
+    }
+
+    convolve<N>(own, enemy, empty, friendWeight, enemyWeight, total);
+
+    // 吃子分: 对方每个被叫吃的棋串, 其唯一的气就是提子点
+    int capture[PADDED_POINTS] = { 0 };
+    for (int p = PLANE_FIRST; p < PLANE_END(N); p++) {
+        if (gs->chainHead[p] != p || gs->cells[p] != opponent) continue;
+        int d = boardTables.denseOf[p];
+        if (!stateInAtari(gs, d / BOARD_SIZE, d % BOARD_SIZE)) continue;
+        capture[gs->chainLibSum[p] / gs->chainLibs[p]] += gs->chainSize[p];
+    }
+
+    // 读秒(只读一两口气的棋串): 征得到的对方棋串按吃子加分, 救得活的己方棋串给救棋点加分, 救不活的叫吃棋串不再长
+    // 读秒要在局面上落子、撤销, 整盘只复制一次
+    int tactic[MAX_POINTS] = { 0 };
+    GameState work = *gs;
+    for (int p = PLANE_FIRST; p < PLANE_END(N); p++) {
+        int c = gs->cells[p];
+        if (gs->chainHead[p] != p || (c != color && c != opponent)) continue;
+        int d = boardTables.denseOf[p];
+        int x = d / BOARD_SIZE;
+        int y = d % BOARD_SIZE;
+        int libs = tacticsLiberties(gs, x, y, 2);
+        int move;
+        if (libs > 2) continue;
+        if (c == opponent) {
+            if (libs == 1) continue; // 已计入吃子分
+            if (tacticsCapture(&work, x, y, TACTICS_DEFAULT_NODES, &move)) tactic[move] += 40 * gs->chainSize[p];
+        }
+        else if (tacticsRescue(&work, x, y, TACTICS_DEFAULT_NODES, &move)) {
+            if (move >= 0) tactic[move] += 40 * gs->chainSize[p];
+        }
+        else if (libs == 1) {
+            tactic[stateAtariLiberty(gs, x, y)] -= 40 * gs->chainSize[p];
+        }
+    }
+
+    if (N < BOARD_SIZE) {
+        for (int p = 0; p < MAX_POINTS; p++) scores[p] = HEURISTIC_ILLEGAL;
+    }
+    for (int x = 0; x < N; x++) {
+        for (int y = 0; y < N; y++) {
+            int p = x * BOARD_SIZE + y;
+            if (gs->board[x][y] != EMPTY || !stateIsLegal(gs, x, y)) {
+                scores[p] = HEURISTIC_ILLEGAL;
+            }
+            else {
+                scores[p] = total[PAD_INDEX(x, y)] + 40 * capture[PAD_INDEX(x, y)] + tactic[p];
+            }
+        }
+    }
+}
+
+// 为当前走子方计算整盘分数: 位置分 + 每个相邻己方子5分/对方子3分 + 每口气3分 + 每颗可提的子40分
+// 读秒结果: 每颗征得到的子、救得活的子各加40分, 救不活的叫吃棋串长气的点每颗子减40分
+// 困难模式另加 (己方邻子 - 对方邻子) * 2; 简单模式的随机分由调用者自己加
+// 盘外的点记为 HEURISTIC_ILLEGAL
+void heuristicMap(const GameState* gs, int difficulty, int scores[MAX_POINTS]) {
+    switch (gs->size) {
+    case 9: heuristicMapSized<9>(gs, difficulty, scores); break;
+    case 13: heuristicMapSized<13>(gs, difficulty, scores); break;
+    default: heuristicMapSized<19>(gs, difficulty, scores); break;
+    }
+}
+
+// 整盘分数最高的合法点(含全局同形检查), 没有合法点时返回 -1, -1
+// 被围住的棋块先走能活(能杀)、后走就不行时, 先给出死活的关键一手
+void heuristicBestMove(const Position* pos, int difficulty, int* x, int* y) {
+    if (lifeDeathUrgentMove(&pos->state, LIFE_HINT_NODES, x, y) > 0 && posIsLegal(pos, *x, *y)) return;
+
+    int scores[MAX_POINTS];
+    heuristicMap(&pos->state, difficulty, scores);
+
+    int bestScore = HEURISTIC_ILLEGAL;
+    *x = *y = -1;
+    for (int p = 0; p < MAX_POINTS; p++) {
+        if (scores[p] <= bestScore) continue;
+        if (!posIsLegal(pos, p / BOARD_SIZE, p % BOARD_SIZE)) continue; // 全局同形只对候选点检查
+        bestScore = scores[p];
+        *x = p / BOARD_SIZE;
+        *y = p % BOARD_SIZE;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,18 @@
+/*
+ * 围棋游戏系统 - Part 3: 整盘启发式评分
+ * 负责人: 2518801370 李卓洵
+ * 包含: 一次算出全部交叉点的启发式分数(与 evaluatePosition 的规则相同), 按 9/13/19 路分别实例化
+ * 说明: 不依赖 EasyX, 用于 AI 提示和树搜索的先验
+ */
+
+#ifndef PART3_HEURISTIC_H
+#define PART3_HEURISTIC_H
+
+#include "Part1_Position.h"
+
+#define HEURISTIC_ILLEGAL (-1000000) // 有子或不合法(自杀、打劫)的点
+
+void heuristicMap(const GameState* gs, int difficulty, int scores[MAX_POINTS]);
+void heuristicBestMove(const Position* pos, int difficulty, int* x, int* y);
+
+#endif // PART3_HEURISTIC_H
\ No newline at end of file
@@ -0,0 +1,564 @@
+/*
+ * 围棋游戏系统 - Part 3: 局部死活求解实现
+ * 负责人: 2518801370 李卓洵
+ * 实现: 先走的一方为证明方, df-pn 只在区域内的空点和停一手之间选择; 目标棋串被提掉攻方胜,
+ *       守方按 Benson 算法在区域内无条件活了守方胜, 双方连续停一手时按本次证明的设定判断
+ * 劫和双活靠换设定重读: 不准先走方提劫还能达到目的是净活/净杀, 只有对方不准提劫才行是劫;
+ *       双方连续停一手不算守方活还能活的是净活, 否则是双活
+ */
+
+#include "Part3_LifeDeath.h"
+#include "Part1_BoardTables.h"
+#include <chrono>
+
+#define LIFE_INFINITY 100000000
+#define LIFE_PASS (-1)
+#define LIFE_MAX_CHILDREN (LIFE_MAX_REGION + 1) // 区域内的点加上停一手
+
+// 置换表项: 从证明方看的证明数和反证数
+typedef struct {
+    unsigned long long key;
+    int pn;
+    int dn;
+} LifeEntry;
+
+// 一个子节点: 带边框下标(或 LIFE_PASS)和目前的证明数、反证数
+typedef struct {
+    int move;
+    int pn;
+    int dn;
+} LifeChild;
+
+// 一次查询的搜索状态, 在 gs 这份副本上落子、撤销
+typedef struct {
+    GameState gs;
+    int points[LIFE_MAX_REGION];       // 区域内的点(带边框下标)
+    int pointCount;
+    signed char slot[PADDED_POINTS];   // 带边框下标在 points 中的位置, 不在区域内为 -1
+    int target;       // 目标棋串的一个子(带边框下标)
+    int defender;
+    int attacker;
+    int prover;       // 先走、要证明能达到目的的一方
+    int banned;       // 不准提劫的一方, 0 表示都可以
+    int sekiLives;    // 双方连续停一手时守方是否算活
+    unsigned long long mode; // 以上设定合成的值, 混入置换表的键
+    LifeEntry* table;
+    long long nodes;
+    long long limit;
+    int aborted;      // 读到局面数上限, 本次证明没有结论
+    int rootMove;     // 根节点上证明成功的一手
+} LifeSearch;
+
+static unsigned long long nodeKey(const LifeSearch* s, int passed) {
+    const GameState* gs = &s->gs;
+    unsigned long long k = gs->hash ^ s->mode;
+    k ^= (unsigned long long)(gs->koPoint + 1) << 40;
+    k ^= (unsigned long long)(gs->currentPlayer * 2 + passed) << 56;
+    k ^= k >> 31;
+    k *= 0x9E3779B97F4A7C15ULL;
+    return k ^ (k >> 29);
+}
+
+static int lookup(const LifeSearch* s, int passed, int* pn, int* dn) {
+    unsigned long long key = nodeKey(s, passed);
+    const LifeEntry* e = &s->table[key & ((1 << LIFE_TABLE_BITS) - 1)];
+    if (e->key != key) return 0;
+    *pn = e->pn;
+    *dn = e->dn;
+    return 1;
+}
+
+static void store(LifeSearch* s, int passed, int pn, int dn) {
+    unsigned long long key = nodeKey(s, passed);
+    LifeEntry* e = &s->table[key & ((1 << LIFE_TABLE_BITS) - 1)];
+    e->key = key;
+    e->pn = pn;
+    e->dn = dn;
+}
+
+// 守方的目标棋串是否在区域内无条件活(Benson):
+// 区域内非守方的点连成小块, 四周只有守方棋子和盘外的小块才算围住;
+// 小块的空点都是某串的气时对该串是要害, 反复去掉要害少于两个的串和挨着被去掉的串的小块
+static int bensonAlive(const LifeSearch* s) {
+    const GameState* gs = &s->gs;
+    int heads[LIFE_MAX_REGION];
+    int headCount = 0;
+    for (int i = 0; i < s->pointCount; i++) {
+        int p = s->points[i];
+        if (gs->cells[p] != s->defender) continue;
+        int h = gs->chainHead[p];
+        int k = 0;
+        while (k < headCount && heads[k] != h) k++;
+        if (k == headCount) heads[headCount++] = h;
+    }
+
+    unsigned long long vital[LIFE_MAX_REGION];    // 各小块对哪些串(按 heads 的位置)是要害
+    unsigned long long touching[LIFE_MAX_REGION]; // 各小块挨着哪些串
+    int blockCount = 0;
+    signed char blockOf[LIFE_MAX_REGION];
+    memset(blockOf, -1, sizeof(blockOf));
+
+    for (int i = 0; i < s->pointCount; i++) {
+        int start = s->points[i];
+        if (gs->cells[start] == s->defender || blockOf[i] >= 0) continue;
+
+        int b = blockCount++;
+        int stack[LIFE_MAX_REGION];
+        int top = 0;
+        int enclosed = 1;
+        unsigned long long libertyOfAll = ~0ULL;
+        touching[b] = 0;
+        blockOf[i] = (signed char)b;
+        stack[top++] = start;
+        while (top > 0) {
+            int p = stack[--top];
+            unsigned long long adjacent = 0;
+            for (int d = 0; d < 4; d++) {
+                int q = p + neighborOffset[d];
+                int c = gs->cells[q];
+                if (c == OFF_BOARD) continue;
+                if (c == s->defender) {
+                    int k = 0;
+                    while (k < headCount && heads[k] != gs->chainHead[q]) k++;
+                    adjacent |= 1ULL << k;
+                    continue;
+                }
+                int j = s->slot[q];
+                if (j < 0) {
+                    enclosed = 0; // 挨着区域外的攻方棋子或空点
+                    continue;
+                }
+                if (blockOf[j] < 0) {
+                    blockOf[j] = (signed char)b;
+                    stack[top++] = q;
+                }
+            }
+            touching[b] |= adjacent;
+            if (gs->cells[p] == EMPTY) libertyOfAll &= adjacent;
+        }
+        vital[b] = enclosed ? libertyOfAll & touching[b] : 0;
+    }
+
+    unsigned long long alive = headCount < 64 ? (1ULL << headCount) - 1 : ~0ULL;
+    for (;;) {
+        unsigned long long next = alive;
+        for (int k = 0; k < headCount; k++) {
+            if (!(alive >> k & 1)) continue;
+            int count = 0;
+            for (int b = 0; b < blockCount; b++) {
+                if ((vital[b] >> k & 1) && (touching[b] & ~alive) == 0) count++;
+            }
+            if (count < 2) next &= ~(1ULL << k);
+        }
+        if (next == alive) break;
+        alive = next;
+    }
+
+    int targetHead = gs->chainHead[s->target];
+    for (int k = 0; k < headCount; k++) {
+        if (heads[k] == targetHead) return (int)(alive >> k & 1);
+    }
+    return 0;
+}
+
+// 已经分出结果时返回胜方, 否则返回 0
+static int settled(const LifeSearch* s) {
+    if (s->gs.cells[s->target] != s->defender) return s->attacker;
+    if (bensonAlive(s)) return s->defender;
+    return 0;
+}
+
+// 胜方换成从证明方看的证明数、反证数
+static void outcome(const LifeSearch* s, int winner, int* pn, int* dn) {
+    *pn = winner == s->prover ? 0 : LIFE_INFINITY;
+    *dn = winner == s->prover ? LIFE_INFINITY : 0;
+}
+
+static void passMove(GameState* gs, int* koPoint) {
+    *koPoint = gs->koPoint;
+    statePass(gs);
+}
+
+static void unpassMove(GameState* gs, int koPoint) {
+    gs->koPoint = koPoint;
+    gs->moveCount--;
+    gs->currentPlayer = (gs->currentPlayer == BLACK) ? WHITE : BLACK;
+}
+
+// 区域内可走的点加上停一手, 证明数和反证数先都记 1, 展开到时再从置换表或搜索得到
+static int generateChildren(LifeSearch* s, int passed, LifeChild* children) {
+    GameState* gs = &s->gs;
+    int count = 0;
+    for (int i = 0; i < s->pointCount; i++) {
+        int p = s->points[i];
+        if (gs->cells[p] != EMPTY) continue;
+        int d = boardTables.denseOf[p];
+        if (!stateIsLegal(gs, d / BOARD_SIZE, d % BOARD_SIZE)) continue;
+        LifeChild* c = &children[count++];
+        c->move = p;
+        c->pn = c->dn = 1;
+    }
+
+    LifeChild* c = &children[count++];
+    c->move = LIFE_PASS;
+    c->pn = c->dn = 1;
+    if (passed) {
+        // 连续两次停一手: 目标还在, 守方活没活看本次的设定
+        outcome(s, s->sekiLives ? s->defender : s->attacker, &c->pn, &c->dn);
+    }
+    return count;
+}
+
+static int addCapped(int a, int b) {
+    int sum = a + b;
+    return sum > LIFE_INFINITY ? LIFE_INFINITY : sum;
+}
+
+// df-pn 的一个节点: 在阈值内展开, 返回本节点的证明数和反证数
+static void searchNode(LifeSearch* s, int passed, int depth, int thpn, int thdn, int* pnOut, int* dnOut) {
+    GameState* gs = &s->gs;
+    s->nodes++;
+
+    int pn, dn;
+    if (depth > 0 && lookup(s, passed, &pn, &dn) && (pn >= thpn || dn >= thdn)) {
+        *pnOut = pn;
+        *dnOut = dn;
+        return;
+    }
+    int winner = settled(s);
+    if (winner != 0) {
+        outcome(s, winner, pnOut, dnOut);
+        store(s, passed, *pnOut, *dnOut);
+        return;
+    }
+    if (depth >= LIFE_MAX_DEPTH) {
+        outcome(s, s->prover == s->defender ? s->attacker : s->defender, pnOut, dnOut); // 不进置换表
+        return;
+    }
+    if (s->nodes > s->limit) {
+        s->aborted = 1;
+        *pnOut = *dnOut = 1;
+        return;
+    }
+
+    LifeChild children[LIFE_MAX_CHILDREN];
+    int count = generateChildren(s, passed, children);
+    int mover = gs->currentPlayer;
+    int orNode = mover == s->prover;
+    short removed[MAX_POINTS];
+
+    for (;;) {
+        // 或节点: 证明数取最小、反证数求和; 与节点反过来
+        int best = 0;
+        int second = LIFE_INFINITY;
+        pn = orNode ? LIFE_INFINITY : 0;
+        dn = orNode ? 0 : LIFE_INFINITY;
+        for (int i = 0; i < count; i++) {
+            int value = orNode ? children[i].pn : children[i].dn;
+            int bestValue = orNode ? children[best].pn : children[best].dn;
+            if (i > 0 && value < bestValue) {
+                second = bestValue;
+                best = i;
+            }
+            else if (i > 0 && value < second) {
+                second = value;
+            }
+            if (orNode) {
+                if (children[i].pn < pn) pn = children[i].pn;
+                dn = addCapped(dn, children[i].dn);
+            }
+            else {
+                pn = addCapped(pn, children[i].pn);
+                if (children[i].dn < dn) dn = children[i].dn;
+            }
+        }
+        if (pn >= thpn || dn >= thdn || s->aborted) break;
+
+        LifeChild* c = &children[best];
+        int childThpn, childThdn;
+        if (orNode) {
+            childThpn = thpn < second + 1 ? thpn : second + 1;
+            childThdn = addCapped(thdn - dn, c->dn);
+        }
+        else {
+            childThdn = thdn < second + 1 ? thdn : second + 1;
+            childThpn = addCapped(thpn - pn, c->pn);
+        }
+
+        if (c->move == LIFE_PASS) {
+            int koPoint;
+            passMove(gs, &koPoint);
+            searchNode(s, 1, depth + 1, childThpn, childThdn, &c->pn, &c->dn);
+            unpassMove(gs, koPoint);
+        }
+        else {
+            int d = boardTables.denseOf[c->move];
+            int x = d / BOARD_SIZE;
+            int y = d % BOARD_SIZE;
+            int koPoint = gs->koPoint;
+            int captured = statePlay(gs, x, y, removed);
+            if (mover == s->banned && captured == 1 && gs->koPoint >= 0) {
+                outcome(s, mover == s->defender ? s->attacker : s->defender, &c->pn, &c->dn); // 不准提劫: 这一手算输
+            }
+            else {
+                searchNode(s, 0, depth + 1, childThpn, childThdn, &c->pn, &c->dn);
+            }
+            stateUnplay(gs, x, y, removed, captured, koPoint);
+        }
+    }
+
+    if (!s->aborted) store(s, passed, pn, dn);
+    if (depth == 0) {
+        s->rootMove = LIFE_PASS;
+        for (int i = 0; i < count; i++) {
+            if (children[i].pn == 0) {
+                s->rootMove = children[i].move;
+                break;
+            }
+        }
+    }
+    *pnOut = pn;
+    *dnOut = dn;
+}
+
+// 按给定的设定证明先走方能否达到目的, 能时 move 为第一手(普通下标, -1 表示停一手)
+static int prove(LifeSearch* s, int banned, int sekiLives, int* move) {
+    s->banned = banned;
+    s->sekiLives = sekiLives;
+    s->mode = (unsigned long long)(banned * 2 + sekiLives + 1) * 0xD6E8FEB86659FD93ULL;
+    s->rootMove = LIFE_PASS;
+
+    int pn, dn;
+    searchNode(s, 0, 0, LIFE_INFINITY, LIFE_INFINITY, &pn, &dn);
+    *move = s->rootMove == LIFE_PASS ? -1 : boardTables.denseOf[s->rootMove];
+    return !s->aborted && pn == 0;
+}
+
+// 求出 (x, y) 处棋串所在的区域: 从棋串出发经过空点和同色棋子能到的点, 加上被这些点完全围住的对方棋串和它们的眼
+// region 按普通下标标记, 返回区域内的空点数; 棋串没有被围住(空点或总点数超过上限)时返回 0
+int lifeDeathRegion(const GameState* gs, int x, int y, unsigned char region[MAX_POINTS]) {
+    memset(region, 0, MAX_POINTS);
+    if (x < 0 || x >= gs->size || y < 0 || y >= gs->size) return 0;
+    int start = PAD_INDEX(x, y);
+    int color = gs->cells[start];
+    if (color != BLACK && color != WHITE) return 0;
+
+    int points[LIFE_MAX_REGION];
+    int total = 0, empty = 0;
+    region[boardTables.denseOf[start]] = 1;
+    points[total++] = start;
+    for (int i = 0; i < total; i++) {
+        for (int d = 0; d < 4; d++) {
+            int q = points[i] + neighborOffset[d];
+            int c = gs->cells[q];
+            if ((c != EMPTY && c != color) || region[boardTables.denseOf[q]]) continue;
+            if (total == LIFE_MAX_REGION || (c == EMPTY && ++empty > LIFE_MAX_EMPTY)) {
+                memset(region, 0, MAX_POINTS);
+                return 0;
+            }
+            region[boardTables.denseOf[q]] = 1;
+            points[total++] = q;
+        }
+    }
+
+    // 区域里的对方棋串: 每个子的邻点都在区域内、在盘外、是同一串的子, 或是只挨着这些点的空点(它的眼)
+    int reached = total;
+    for (int i = 0; i < reached; i++) {
+        for (int d = 0; d < 4; d++) {
+            int q = points[i] + neighborOffset[d];
+            int c = gs->cells[q];
+            if (c == EMPTY || c == color || c == OFF_BOARD || region[boardTables.denseOf[q]]) continue;
+
+            int head = gs->chainHead[q];
+            int eyes[4];
+            int eyeCount = 0;
+            int enclosed = 1;
+            int r = head;
+            do {
+                for (int k = 0; k < 4 && enclosed; k++) {
+                    int n = r + neighborOffset[k];
+                    if (gs->cells[n] == OFF_BOARD || region[boardTables.denseOf[n]]) continue;
+                    if (gs->cells[n] == c && gs->chainHead[n] == head) continue;
+                    if (gs->cells[n] != EMPTY) {
+                        enclosed = 0;
+                        break;
+                    }
+                    for (int m = 0; m < 4; m++) {
+                        int e = n + neighborOffset[m];
+                        if (gs->cells[e] == OFF_BOARD || region[boardTables.denseOf[e]]) continue;
+                        if (gs->cells[e] != c || gs->chainHead[e] != head) enclosed = 0;
+                    }
+                    int j = 0;
+                    while (j < eyeCount && eyes[j] != n) j++;
+                    if (j == eyeCount) {
+                        if (eyeCount == 4) enclosed = 0;
+                        else eyes[eyeCount++] = n;
+                    }
+                }
+                r = gs->chainNext[r];
+            } while (r != head && enclosed);
+            if (!enclosed) continue;
+
+            if (total + gs->chainSize[head] + eyeCount > LIFE_MAX_REGION || empty + eyeCount > LIFE_MAX_EMPTY) {
+                memset(region, 0, MAX_POINTS);
+                return 0;
+            }
+            r = head;
+            do {
+                region[boardTables.denseOf[r]] = 1;
+                points[total++] = r;
+                r = gs->chainNext[r];
+            } while (r != head);
+            for (int j = 0; j < eyeCount; j++) {
+                region[boardTables.denseOf[eyes[j]]] = 1;
+                points[total++] = eyes[j];
+                empty++;
+            }
+        }
+    }
+    return empty;
+}
+
+// 判断 (x, y) 处棋串的死活, gs 的走子方先走; region 为 NULL 时用 lifeDeathRegion 求出的区域
+// 返回 result->status; 区域没被围住或读到 nodeLimit 时为 LIFE_UNKNOWN
+int lifeDeathSolve(const GameState* gs, int x, int y, const unsigned char* region, long long nodeLimit, LifeDeathResult* result) {
+    auto startTime = std::chrono::steady_clock::now();
+    result->status = LIFE_UNKNOWN;
+    result->moveX = result->moveY = -1;
+    result->defender = EMPTY;
+    result->regionEmpty = 0;
+    result->nodes = 0;
+    result->elapsedMs = 0.0;
+
+    unsigned char found[MAX_POINTS];
+    if (region == NULL) {
+        if (lifeDeathRegion(gs, x, y, found) == 0) return LIFE_UNKNOWN;
+        region = found;
+    }
+    int target = PAD_INDEX(x, y);
+    if (x < 0 || x >= gs->size || y < 0 || y >= gs->size) return LIFE_UNKNOWN;
+    if (gs->cells[target] != BLACK && gs->cells[target] != WHITE) return LIFE_UNKNOWN;
+
+    LifeSearch* s = new LifeSearch;
+    s->gs = *gs;
+    s->pointCount = 0;
+    memset(s->slot, -1, sizeof(s->slot));
+    for (int p = 0; p < MAX_POINTS; p++) {
+        if (!region[p] || p / BOARD_SIZE >= gs->size || p % BOARD_SIZE >= gs->size) continue;
+        if (s->pointCount == LIFE_MAX_REGION) {
+            delete s;
+            return LIFE_UNKNOWN;
+        }
+        int q = boardTables.padOf[p];
+        s->slot[q] = (signed char)s->pointCount;
+        s->points[s->pointCount++] = q;
+        if (gs->cells[q] == EMPTY) result->regionEmpty++;
+    }
+    s->target = target;
+    s->defender = gs->cells[target];
+    s->attacker = s->defender == BLACK ? WHITE : BLACK;
+    s->prover = gs->currentPlayer;
+    s->table = (LifeEntry*)calloc((size_t)1 << LIFE_TABLE_BITS, sizeof(LifeEntry));
+    if (s->table == NULL) {
+        delete s;
+        return LIFE_UNKNOWN; // 置换表分配失败, 按读不完处理
+    }
+    s->nodes = 0;
+    s->limit = nodeLimit;
+    s->aborted = 0;
+    result->defender = s->defender;
+
+    int status = LIFE_UNKNOWN;
+    int move = -1, other = -1;
+    if (s->prover == s->attacker) {
+        if (prove(s, s->attacker, 1, &move)) status = LIFE_DEAD;
+        else if (!s->aborted && prove(s, s->defender, 1, &move)) status = LIFE_KO;
+        else if (!s->aborted) {
+            // 杀不死: 再看守方是真活还是只能双活; 这一步读不完时按活算
+            move = -1;
+            status = prove(s, s->attacker, 0, &other) ? LIFE_SEKI : LIFE_ALIVE;
+            s->aborted = 0;
+        }
+    }
+    else {
+        if (prove(s, s->defender, 1, &move)) {
+            // 能活: 再看不靠双活能不能活, 这一步读不完时按活算
+            status = LIFE_ALIVE;
+            if (prove(s, s->defender, 0, &other)) move = other;
+            else if (!s->aborted) status = LIFE_SEKI;
+            s->aborted = 0;
+        }
+        else if (!s->aborted && prove(s, s->attacker, 1, &move)) status = LIFE_KO;
+        else if (!s->aborted) {
+            status = LIFE_DEAD;
+            move = -1;
+        }
+    }
+    if (s->aborted) status = LIFE_UNKNOWN;
+
+    result->status = status;
+    if (status != LIFE_UNKNOWN && move >= 0) {
+        result->moveX = move / BOARD_SIZE;
+        result->moveY = move % BOARD_SIZE;
+    }
+    result->nodes = s->nodes;
+    free(s->table);
+    delete s;
+
+    result->elapsedMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - startTime).count();
+    return status;
+}
+
+// 结论对 player 是否有利: player 是守方时活或双活, 是攻方时死
+static int goodFor(int player, const LifeDeathResult* result) {
+    if (result->defender == player) return result->status == LIFE_ALIVE || result->status == LIFE_SEKI;
+    return result->status == LIFE_DEAD;
+}
+
+// 整盘被围住的棋串中, 走子方先走能活(能杀)、让对方先走就不行的最大一块, 返回它的子数和关键的一手
+// 没有这样的棋串时返回 0, x, y 为 -1; nodeBudget 为所有查询合计的局面数, 用完就不再往下找
+int lifeDeathUrgentMove(const GameState* gs, long long nodeBudget, int* x, int* y) {
+    int player = gs->currentPlayer;
+    int best = 0;
+    *x = *y = -1;
+
+    for (int cx = 0; cx < gs->size; cx++) {
+        for (int cy = 0; cy < gs->size; cy++) {
+            int head = PAD_INDEX(cx, cy);
+            if ((gs->cells[head] != BLACK && gs->cells[head] != WHITE) || gs->chainHead[head] != head) continue;
+            if (gs->chainSize[head] <= best) continue;
+
+            unsigned char region[MAX_POINTS];
+            if (lifeDeathRegion(gs, cx, cy, region) == 0) continue;
+            if (nodeBudget <= 0) return best;
+            LifeDeathResult first;
+            lifeDeathSolve(gs, cx, cy, region, nodeBudget, &first);
+            nodeBudget -= first.nodes;
+            if (!goodFor(player, &first) || first.moveX < 0) continue;
+
+            GameState other = *gs;
+            other.currentPlayer = player == BLACK ? WHITE : BLACK;
+            other.koPoint = -1;
+            LifeDeathResult second;
+            lifeDeathSolve(&other, cx, cy, region, nodeBudget, &second);
+            nodeBudget -= second.nodes;
+            if (second.status == LIFE_UNKNOWN || goodFor(player, &second)) continue;
+
+            best = gs->chainSize[head];
+            *x = first.moveX;
+            *y = first.moveY;
+        }
+    }
+    return best;
+}
+
+const char* lifeDeathStatusName(int status) {
+    switch (status) {
+    case LIFE_ALIVE: return "alive";
+    case LIFE_DEAD: return "dead";
+    case LIFE_SEKI: return "seki";
+    case LIFE_KO: return "ko";
+    default: return "unknown";
+    }
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+/*
+ * 围棋游戏系统 - Part 3: 局部死活求解
+ * 负责人: 2518801370 李卓洵
+ * 包含: 对被围住的一块棋用 df-pn(深度优先证明数搜索)判断活、死、双活还是劫, 并给出关键的一手
+ * 说明: 不依赖 EasyX; 只在棋串周围被对方围住的小区域内落子, 置换表按 Zobrist 哈希索引,
+ *       每次查询单独分配, 可以在任何线程里调用; 用于提示和形势判断中的死子判断
+ */
+
+#ifndef PART3_LIFEDEATH_H
+#define PART3_LIFEDEATH_H
+
+#include "Part1_Rules.h"
+
+// 死活结论(都是对 gs 的走子方先走而言)
+#define LIFE_UNKNOWN 0  // 区域没有被围住、太大, 或读到局面数上限
+#define LIFE_ALIVE 1    // 守方能做出两只眼(对方先走也杀不死)
+#define LIFE_DEAD 2     // 攻方能提掉目标棋串
+#define LIFE_SEKI 3     // 双方都不能动手, 守方只能双活
+#define LIFE_KO 4       // 先走的一方要打赢劫才能达到目的
+
+#define LIFE_MAX_EMPTY 20           // 区域内最多这么多空点, 再多当作没被围住
+#define LIFE_MAX_REGION 64          // 区域内最多的点数(空点、守方棋子和被围住的攻方棋子)
+#define LIFE_MAX_DEPTH 60           // 最多读多少手, 超过时当作先走方失败
+#define LIFE_TABLE_BITS 16          // 置换表 2^16 项, 直接映射
+#define LIFE_DEFAULT_NODES 200000   // 单独查询一块棋时的局面数上限
+#define LIFE_HINT_NODES 50000       // 提示找整盘的死活急所时, 所有查询合计的局面数上限
+#define LIFE_ESTIMATE_NODES 20000   // 形势判断每次刷新时, 所有查询合计的局面数上限
+
+typedef struct {
+    int status;       // LIFE_* 之一
+    int moveX;        // 关键的一手, 都为 -1 表示不用走(或没有能达到目的的走法)
+    int moveY;
+    int defender;     // 守方(目标棋串)的颜色
+    int regionEmpty;  // 区域内的空点数
+    long long nodes;  // 搜索的局面数
+    double elapsedMs;
+} LifeDeathResult;
+
+int lifeDeathRegion(const GameState* gs, int x, int y, unsigned char region[MAX_POINTS]);
+int lifeDeathSolve(const GameState* gs, int x, int y, const unsigned char* region, long long nodeLimit, LifeDeathResult* result);
+int lifeDeathUrgentMove(const GameState* gs, long long nodeBudget, int* x, int* y);
+const char* lifeDeathStatusName(int status);
+
+#endif // PART3_LIFEDEATH_H
\ No newline at end of file
@@ -0,0 +1,109 @@
+/*
+ * 围棋游戏系统 - Part 3: 局部死活求解测试程序
+ * 负责人: 2518801370 李卓洵
+ * 用法: go_tsumego [--reps 轮数] [--nodes 局面数上限] [--only 题名]
+ * 在内置的一组经典死活题(角上的各种眼形、双活、劫)上求解, 每题打印结论、关键的一手、
+ * 局面数、求解时间(各轮的中位数)和每秒局面数, 结论与答案不符时标出 MISMATCH 并以 1 退出
+ */
+
+#include "Part3_LifeDeath.h"
+#include <algorithm>
+#include <vector>
+
+#define PROBLEM_ROWS 8
+
+// 题目: 棋盘左上角的图, 第 r 行第 c 列为 (r, c); X 黑 O 白 . 空, 其余为空棋盘
+typedef struct {
+    const char* name;
+    const char* rows[PROBLEM_ROWS]; // 以 NULL 结束
+    int targetX;     // 要判断死活的棋串中的一个子
+    int targetY;
+    int toMove;
+    int expected;
+} LifeProblem;
+
+static const LifeProblem problems[] = {
+    { "straight three, black first", { "...XO", "XXXXO", "OOOOO", NULL }, 1, 0, BLACK, LIFE_ALIVE },
+    { "straight three, white first", { "...XO", "XXXXO", "OOOOO", NULL }, 1, 0, WHITE, LIFE_DEAD },
+    { "bent three, black first", { "..XO", ".XXO", "XXOO", "OOO.", NULL }, 1, 1, BLACK, LIFE_ALIVE },
+    { "bent three, white first", { "..XO", ".XXO", "XXOO", "OOO.", NULL }, 1, 1, WHITE, LIFE_DEAD },
+    { "straight four, white first", { "....XO", "XXXXXO", "OOOOOO", NULL }, 1, 0, WHITE, LIFE_ALIVE },
+    { "square four, black first", { "..XO", "..XO", "XXXO", "OOOO", NULL }, 2, 0, BLACK, LIFE_DEAD },
+    { "bulky five, black first", { "...XO", "..XXO", "XXXOO", "OOOO.", NULL }, 2, 0, BLACK, LIFE_ALIVE },
+    { "bulky five, white first", { "...XO", "..XXO", "XXXOO", "OOOO.", NULL }, 2, 0, WHITE, LIFE_DEAD },
+    { "seki, black first", { ".XO.OXXO", "XXOOO.XO", "XXXXXXXO", "OOOOOOOO", NULL }, 1, 0, BLACK, LIFE_SEKI },
+    { "seki, white first", { ".XO.OXXO", "XXOOO.XO", "XXXXXXXO", "OOOOOOOO", NULL }, 1, 0, WHITE, LIFE_SEKI },
+    { "rectangular six, no liberty", { "...XO", "...XO", "XXXXO", "OOOOO", NULL }, 2, 0, WHITE, LIFE_DEAD },
+    { "rectangular six, one liberty", { "...XO", "...XO", "XXXXO", "O.OOO", "OOO..", NULL }, 2, 0, WHITE, LIFE_KO },
+    { "rectangular six, two liberties", { "...XO", "...XO", "XXXXO", "O.O.O", "OOOOO", NULL }, 2, 0, WHITE, LIFE_ALIVE },
+    { "straight five, white first", { ".....XO", "XXXXXXO", "OOOOOOO", NULL }, 1, 0, WHITE, LIFE_ALIVE },
+};
+
+#define PROBLEM_COUNT ((int)(sizeof(problems) / sizeof(problems[0])))
+
+static void setupProblem(const LifeProblem* problem, GameState* gs) {
+    stateReset(gs, BOARD_SIZE);
+    for (int r = 0; r < PROBLEM_ROWS && problem->rows[r] != NULL; r++) {
+        for (int c = 0; problem->rows[r][c] != '\0'; c++) {
+            if (problem->rows[r][c] == 'X') stateAddStone(gs, r, c, BLACK);
+            else if (problem->rows[r][c] == 'O') stateAddStone(gs, r, c, WHITE);
+        }
+    }
+    gs->currentPlayer = problem->toMove;
+}
+
+int main(int argc, char* argv[]) {
+    int reps = 5;
+    long long nodeLimit = LIFE_DEFAULT_NODES;
+    const char* only = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--reps") == 0 && i + 1 < argc) reps = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--nodes") == 0 && i + 1 < argc) nodeLimit = atoll(argv[++i]);
+        else if (strcmp(argv[i], "--only") == 0 && i + 1 < argc) only = argv[++i];
+        else {
+            printf("usage: go_tsumego [--reps N] [--nodes N] [--only NAME]\n");
+            return 1;
+        }
+    }
+    if (reps < 1) reps = 1;
+
+    printf("%-30s %-8s %-8s %8s %10s %12s %12s\n", "problem", "status", "move", "empty", "nodes", "median ms", "nodes/s");
+    long long totalNodes = 0;
+    double totalMs = 0.0;
+    int mismatches = 0;
+
+    for (int k = 0; k < PROBLEM_COUNT; k++) {
+        const LifeProblem* problem = &problems[k];
+        if (only != NULL && strstr(problem->name, only) == NULL) continue;
+
+        GameState gs;
+        setupProblem(problem, &gs);
+
+        LifeDeathResult result;
+        std::vector<double> times;
+        for (int r = 0; r < reps; r++) {
+            lifeDeathSolve(&gs, problem->targetX, problem->targetY, NULL, nodeLimit, &result);
+            times.push_back(result.elapsedMs);
+            totalNodes += result.nodes;
+            totalMs += result.elapsedMs;
+        }
+        std::sort(times.begin(), times.end());
+        double median = times[times.size() / 2];
+
+        char move[16];
+        if (result.moveX >= 0) snprintf(move, sizeof(move), "(%d,%d)", result.moveX, result.moveY);
+        else snprintf(move, sizeof(move), "-");
+        printf("%-30s %-8s %-8s %8d %10lld %12.3f %12.0f", problem->name, lifeDeathStatusName(result.status),
+            move, result.regionEmpty, result.nodes, median, median > 0 ? result.nodes / median * 1000.0 : 0.0);
+        if (result.status != problem->expected) {
+            printf("  MISMATCH, expected %s", lifeDeathStatusName(problem->expected));
+            mismatches++;
+        }
+        printf("\n");
+    }
+
+    printf("total %lld nodes in %.1f ms, %.0f nodes/s, %d mismatches\n",
+        totalNodes, totalMs, totalMs > 0 ? totalNodes / totalMs * 1000.0 : 0.0, mismatches);
+    return mismatches > 0 ? 1 : 0;
+}
\ No newline at end of file
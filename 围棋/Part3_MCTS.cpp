@@ -0,0 +1,896 @@
+/*
+ * 围棋游戏系统 - Part 3: 蒙特卡洛树搜索实现
+ * 负责人: 2518801370 李卓洵
+ * 实现: 节点池、UCT 选择、展开、随机对局(或网络估值)、回传, 按模拟次数/时间控制预算
+ * 多线程: 所有线程共享一棵树, 节点统计用原子操作更新, 下降时加虚拟负局
+ * 树复用: 搜索开始时在上一棵树的前两层中找当前局面, 找到就把该子树压缩到另一块节点池继续使用
+ */
+
+#include "Part3_MCTS.h"
+#include "Part1_BoardTables.h"
+#include "Part3_Heuristic.h"
+#include "Part3_Patterns.h"
+#include "Part3_Tactics.h"
+#include <math.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#define MCTS_UCT_C 0.8f              // UCT 探索系数
+#define MCTS_MAX_GAME_MOVES(n) ((n) * (n) * 3) // 单次模拟的最大手数, 防止循环劫
+#define MCTS_MAX_DEPTH 512
+#define MCTS_CAPTURE_WEIGHT 40       // 走子策略: 提掉被叫吃的上一手
+#define MCTS_ESCAPE_WEIGHT 30        // 走子策略: 救出被上一手叫吃的己方棋子
+#define MCTS_POLICY_CANDIDATES 16
+#define MCTS_READ_CHAIN_SIZE 3       // 打开 readLadders 时只对这么大以内的被叫吃棋串读秒
+
+// 节点展开状态
+#define NODE_LEAF 0       // 未展开
+#define NODE_EXPANDING 1  // 某个线程正在展开(节点池满时永远停在这个状态, 当作叶节点)
+#define NODE_EXPANDED 2   // 已展开, firstChild/childCount 可读
+
+// 树节点: 子节点在节点池中连续存放
+typedef struct {
+    std::atomic<int> visits; // 含其他线程尚未回传的虚拟访问
+    std::atomic<int> wins;   // 从走出 move 的一方看的胜局数
+    std::atomic<int> state;
+    int firstChild;
+    short childCount;
+    short move;       // x * BOARD_SIZE + y 或 MCTS_PASS
+} MctsNode;
+
+struct MctsTree {
+    MctsNode* nodes;
+    MctsNode* spare;      // 复用子树时的压缩目标, 用到时才分配
+    std::atomic<int> nodeCount;
+    int capacity;
+    int hasRoot;
+    GameState rootState;  // 根节点对应的局面
+    int priorVisits;      // 最近一次搜索中新子节点预置的访问数(先验), 统计搜索访问数时扣除
+    std::atomic<int> ready; // 根节点已整理好, 其他线程可以读取根的子节点
+};
+
+// 各搜索线程共享的数据
+typedef struct {
+    MctsTree* tree;
+    const GameState* root;
+    const MctsParams* params;
+    int maxPlayouts;
+    int expandVisits; // 叶节点的访问数(含先验和本线程的虚拟负局)达到此值时展开
+    std::atomic<int> playoutsStarted;
+    std::atomic<int> playoutsDone;
+    std::atomic<int> stop;
+    std::chrono::steady_clock::time_point startTime;
+} MctsShared;
+
+// xorshift 随机数, 比 rand() 快, 每个搜索线程各用一份状态
+static inline unsigned int nextRandom(unsigned int* state) {
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+// 是否为 color 的真眼: 四邻都是己方子(或盘外), 斜角对方子不过多
+static int isOwnEye(const GameState* gs, int x, int y, int color) {
+    int p = PAD_INDEX(x, y);
+    for (int i = 0; i < 4; i++) {
+        int c = gs->cells[p + neighborOffset[i]];
+        if (c != color && c != OFF_BOARD) return 0;
+    }
+
+    int opponent = (color == BLACK) ? WHITE : BLACK;
+    int offBoard = 0, enemy = 0;
+    for (int i = 0; i < 4; i++) {
+        int c = gs->cells[p + diagonalOffset[i]];
+        offBoard |= c == OFF_BOARD;
+        enemy += c == opponent;
+    }
+    return offBoard ? enemy == 0 : enemy < 2;
+}
+
+// 走子策略的候选点: 合法、不填己方眼时按权重加入
+static void addCandidate(const GameState* gs, int p, int weight, int* moves, int* weights, int* count, int* total) {
+    if (p < 0 || *count >= MCTS_POLICY_CANDIDATES) return;
+    int x = p / BOARD_SIZE;
+    int y = p % BOARD_SIZE;
+    if (isOwnEye(gs, x, y, gs->currentPlayer) || !stateIsLegal(gs, x, y)) return;
+    moves[*count] = p;
+    weights[*count] = weight;
+    (*count)++;
+    *total += weight;
+}
+
+// 快速走子策略(MoGo): 只看上一手 last 周围, 提子、救子和 3x3 好形按权重随机选一个
+// 模式码和叫吃都是增量维护的, 每手只查十来个点; 没有候选时返回 -1, 由调用方随机落子
+// readLadders 非 0 时救子前读秒, 会在 gs 上落子再撤销, 返回时 gs 不变
+static int policyMove(GameState* gs, int last, const unsigned char* patterns, int readLadders, unsigned int* rng) {
+    if (last < 0) return -1;
+    int moves[MCTS_POLICY_CANDIDATES];
+    int weights[MCTS_POLICY_CANDIDATES];
+    int count = 0, total = 0;
+    int lx = last / BOARD_SIZE;
+    int ly = last % BOARD_SIZE;
+    int lp = PAD_INDEX(lx, ly);
+
+    // 上一手自己只剩一口气: 提掉
+    addCandidate(gs, stateAtariLiberty(gs, lx, ly), MCTS_CAPTURE_WEIGHT, moves, weights, &count, &total);
+
+    // 上一手叫吃了相邻的己方棋串: 长出后空的邻点不少于两个就长;
+    // 打开 readLadders 时只有两个空邻点(可能是征子)的小棋串先读秒找救棋的一手(长出或提子), 死征子不跑
+    for (int i = 0; i < 4; i++) {
+        int q = lp + neighborOffset[i];
+        if (gs->cells[q] != gs->currentPlayer) continue;
+        int d = boardTables.denseOf[q];
+        int lib = stateAtariLiberty(gs, d / BOARD_SIZE, d % BOARD_SIZE);
+        if (lib < 0) continue;
+        int empty = 0;
+        int lq = PAD_INDEX(lib / BOARD_SIZE, lib % BOARD_SIZE);
+        for (int j = 0; j < 4; j++) {
+            empty += gs->cells[lq + neighborOffset[j]] == EMPTY;
+        }
+        if (readLadders && empty == 2 && gs->chainSize[gs->chainHead[q]] <= MCTS_READ_CHAIN_SIZE) {
+            int save;
+            if (tacticsRescue(gs, d / BOARD_SIZE, d % BOARD_SIZE, TACTICS_PLAYOUT_NODES, &save)) {
+                addCandidate(gs, save, MCTS_ESCAPE_WEIGHT, moves, weights, &count, &total);
+            }
+        }
+        else if (empty >= 2) {
+            addCandidate(gs, lib, MCTS_ESCAPE_WEIGHT, moves, weights, &count, &total);
+        }
+    }
+
+    // 上一手周围 8 个空点中的好形
+    for (int k = 0; k < 8; k++) {
+        int q = lp + patternOffset[k];
+        if (gs->cells[q] != EMPTY) continue;
+        int weight = patterns[gs->pattern[q]];
+        if (weight > 0) addCandidate(gs, boardTables.denseOf[q], weight, moves, weights, &count, &total);
+    }
+
+    if (total == 0) return -1;
+    int r = (int)(nextRandom(rng) % (unsigned int)total);
+    for (int i = 0; i < count; i++) {
+        r -= weights[i];
+        if (r < 0) return moves[i];
+    }
+    return moves[count - 1];
+}
+
+// 以下几个函数按棋盘路数 N 实例化, 循环范围和数组大小都是常量
+// 从 gs 开始双方随机落子(不填己方眼)直到连续两次停一手, 返回黑方目差
+// patterns 不为 NULL 时先按走子策略在上一手(last, -1 表示不知道)周围选点
+template <int N>
+static float runPlayout(GameState* gs, int passes, int last, float komi, const unsigned char* patterns, int readLadders, unsigned int* rng) {
+    short empties[N * N];
+    short where[MAX_POINTS]; // 按普通下标查 empties 中的位置
+    short removed[N * N];
+    int emptyCount = 0;
+
+    for (int i = 0; i < N; i++) {
+        for (int j = 0; j < N; j++) {
+            if (gs->board[i][j] == EMPTY) {
+                where[i * BOARD_SIZE + j] = (short)emptyCount;
+                empties[emptyCount++] = (short)(i * BOARD_SIZE + j);
+            }
+        }
+    }
+
+    for (int moves = 0; passes < 2 && moves < MCTS_MAX_GAME_MOVES(N); moves++) {
+        int color = gs->currentPlayer;
+        int chosen = patterns != NULL ? policyMove(gs, last, patterns, readLadders, rng) : -1;
+        int start = emptyCount > 0 ? (int)(nextRandom(rng) % emptyCount) : 0;
+
+        for (int k = 0; chosen < 0 && k < emptyCount; k++) {
+            int p = empties[(start + k) % emptyCount];
+            int x = p / BOARD_SIZE;
+            int y = p % BOARD_SIZE;
+            if (!isOwnEye(gs, x, y, color) && stateIsLegal(gs, x, y)) {
+                chosen = p;
+                break;
+            }
+        }
+
+        if (chosen < 0) {
+            statePass(gs);
+            passes++;
+            last = -1;
+            continue;
+        }
+        passes = 0;
+        last = chosen;
+
+        int captured = statePlay(gs, chosen / BOARD_SIZE, chosen % BOARD_SIZE, removed);
+
+        // 从空点表删除落子点, 加入被提的子
+        int tail = empties[--emptyCount];
+        empties[where[chosen]] = (short)tail;
+        where[tail] = where[chosen];
+        for (int k = 0; k < captured; k++) {
+            where[removed[k]] = (short)emptyCount;
+            empties[emptyCount++] = removed[k];
+        }
+    }
+
+    return stateAreaScore(gs, komi, NULL);
+}
+
+// 搜索用的网络: 没有给出或路数与棋盘不同时为 NULL
+static const Network* searchNetwork(const MctsParams* params, int size) {
+    const Network* network = params->evalQueue != NULL ? evalQueueNetwork(params->evalQueue) : params->network;
+    return (network != NULL && network->size == size) ? network : NULL;
+}
+
+// 网络估值: 有批量队列时与其他线程的叶节点合批计算, 否则在本线程直接算
+static void evaluateNetwork(const MctsParams* params, const Network* network, const GameState* gs, const short* recent,
+    float* policy, float* value) {
+    if (params->evalQueue != NULL) evalQueueEvaluate(params->evalQueue, gs, recent, policy, value);
+    else networkEvaluateState(network, gs, recent, policy, value);
+}
+
+// 网络输入用的最近几手: 先取搜索路径 path[1..depth-1] 上的着法(停一手为 -1), 不够的从根局面的棋谱补
+static void pathRecentMoves(const MctsTree* tree, const MctsParams* params, const int* path, int depth,
+    short recent[FEATURE_HISTORY]) {
+    int k = 0;
+    for (int i = depth - 1; i >= 1 && k < FEATURE_HISTORY; i--) {
+        int move = tree->nodes[path[i]].move;
+        recent[k++] = move == MCTS_PASS ? -1 : (short)move;
+    }
+    short rootRecent[FEATURE_HISTORY];
+    if (params->rootPosition != NULL) featuresRecentMoves(params->rootPosition, rootRecent);
+    else for (int i = 0; i < FEATURE_HISTORY; i++) rootRecent[i] = -1;
+    for (int i = 0; k < FEATURE_HISTORY; i++) recent[k++] = rootRecent[i];
+}
+
+// 为节点生成子节点(当前局面所有不填眼的合法着法, 没有则只有停一手)
+// 只有把节点从 NODE_LEAF 改为 NODE_EXPANDING 的线程会执行展开
+template <int N>
+static void expandNode(MctsTree* tree, int index, const GameState* gs, const short* recent, int isRoot,
+    const MctsParams* params, unsigned int* rng) {
+    MctsNode* node = &tree->nodes[index];
+    int expected = NODE_LEAF;
+    if (!node->state.compare_exchange_strong(expected, NODE_EXPANDING)) return;
+
+    short moves[N * N + 1];
+    int count = 0;
+
+    for (int i = 0; i < N; i++) {
+        for (int j = 0; j < N; j++) {
+            if (gs->board[i][j] != EMPTY) continue;
+            if (isOwnEye(gs, i, j, gs->currentPlayer)) continue;
+            if (!stateIsLegal(gs, i, j)) continue;
+            if (isRoot && params->rootPosition != NULL && !posIsLegal(params->rootPosition, i, j)) continue;
+            moves[count++] = (short)(i * BOARD_SIZE + j);
+        }
+    }
+    if (count == 0) {
+        moves[count++] = MCTS_PASS;
+    }
+    if (tree->nodeCount.load(std::memory_order_relaxed) + count > tree->capacity) return;
+    int first = tree->nodeCount.fetch_add(count);
+    if (first + count > tree->capacity) return;
+
+    // 打乱顺序, 未访问节点按顺序尝试时不会偏向棋盘一角
+    for (int i = count - 1; i > 0; i--) {
+        int k = (int)(nextRandom(rng) % (unsigned int)(i + 1));
+        short t = moves[i]; moves[i] = moves[k]; moves[k] = t;
+    }
+
+    // 先验: 网络给出的概率或启发式分数在子节点间线性映射到 0.3~0.7 的胜率, 折算成 MCTS_PRIOR_VISITS 次访问;
+    // 启发式不给停一手打分, 停一手取 0.3
+    int priorWins[N * N + 1];
+    const Network* network = searchNetwork(params, N);
+    int priorVisits = (params->usePrior || network != NULL) ? MCTS_PRIOR_VISITS : 0;
+    if (priorVisits > 0) {
+        float scores[N * N + 1];
+        if (network != NULL) {
+            float policy[N * N + 1];
+            float value;
+            evaluateNetwork(params, network, gs, recent, policy, &value);
+            for (int i = 0; i < count; i++) {
+                scores[i] = moves[i] == MCTS_PASS ? policy[N * N] : policy[moves[i] / BOARD_SIZE * N + moves[i] % BOARD_SIZE];
+            }
+        }
+        else {
+            int map[MAX_POINTS];
+            heuristicMap(gs, 2, map);
+            for (int i = 0; i < count; i++) {
+                scores[i] = moves[i] == MCTS_PASS ? -1.0f : (float)map[moves[i]];
+            }
+        }
+        float low = 1e30f, high = 0.0f;
+        for (int i = 0; i < count; i++) {
+            if (moves[i] == MCTS_PASS && network == NULL) continue;
+            if (scores[i] < low) low = scores[i];
+            if (scores[i] > high) high = scores[i];
+        }
+        for (int i = 0; i < count; i++) {
+            float prior = 0.3f;
+            if ((moves[i] != MCTS_PASS || network != NULL) && high > low) {
+                prior += 0.4f * (scores[i] - low) / (high - low);
+            }
+            priorWins[i] = (int)(prior * MCTS_PRIOR_VISITS + 0.5f);
+        }
+    }
+
+    for (int i = 0; i < count; i++) {
+        MctsNode* child = &tree->nodes[first + i];
+        child->visits.store(priorVisits, std::memory_order_relaxed);
+        child->wins.store(priorVisits > 0 ? priorWins[i] : 0, std::memory_order_relaxed);
+        child->state.store(NODE_LEAF, std::memory_order_relaxed);
+        child->firstChild = -1;
+        child->childCount = 0;
+        child->move = moves[i];
+    }
+    node->firstChild = first;
+    node->childCount = (short)count;
+    node->state.store(NODE_EXPANDED, std::memory_order_release);
+}
+
+// 执行树中的一步着法
+static void playTreeMove(GameState* gs, int move) {
+    if (move == MCTS_PASS) {
+        statePass(gs);
+    }
+    else {
+        statePlay(gs, move / BOARD_SIZE, move % BOARD_SIZE, NULL);
+    }
+}
+
+// UCT 选择: 未访问的子节点优先, 否则取 胜率 + C * sqrt(ln N / n) 最大者
+static int selectChild(const MctsTree* tree, int index) {
+    const MctsNode* node = &tree->nodes[index];
+    int parentVisits = node->visits.load(std::memory_order_relaxed);
+    float logParent = logf((float)(parentVisits > 0 ? parentVisits : 1));
+    int best = node->firstChild;
+    float bestValue = -1.0f;
+
+    for (int i = 0; i < node->childCount; i++) {
+        const MctsNode* child = &tree->nodes[node->firstChild + i];
+        if (child->move == MCTS_PRUNED) continue;
+        int visits = child->visits.load(std::memory_order_relaxed);
+        if (visits == 0) return node->firstChild + i;
+
+        float value = (float)child->wins.load(std::memory_order_relaxed) / visits +
+            MCTS_UCT_C * sqrtf(logParent / visits);
+        if (value > bestValue) {
+            bestValue = value;
+            best = node->firstChild + i;
+        }
+    }
+    return best;
+}
+
+// 沿 index 下降一步: 选子节点、加虚拟负局并在 gs 上走出该着
+static int descend(MctsTree* tree, int index, GameState* gs, int* passes) {
+    int child = selectChild(tree, index);
+    MctsNode* node = &tree->nodes[child];
+    node->visits.fetch_add(MCTS_VIRTUAL_LOSS, std::memory_order_relaxed);
+    *passes = (node->move == MCTS_PASS) ? *passes + 1 : 0;
+    playTreeMove(gs, node->move);
+    return child;
+}
+
+// 按时间管理时能否提前结束: 按目前的速度, 剩余预算内次多的着法已追不上最多的;
+// 或已过软时限且最多的明显领先
+static int searchSettled(const MctsShared* shared, double elapsedMs) {
+    const MctsTree* tree = shared->tree;
+    const MctsParams* params = shared->params;
+    int done = shared->playoutsDone.load(std::memory_order_relaxed);
+    if (done < MCTS_SETTLE_MIN_PLAYOUTS || elapsedMs <= 0.0) return 0;
+
+    const MctsNode* rootNode = &tree->nodes[0];
+    if (rootNode->state.load(std::memory_order_acquire) != NODE_EXPANDED) return 0;
+    int best = 0;
+    int second = 0;
+    for (int i = 0; i < rootNode->childCount; i++) {
+        const MctsNode* child = &tree->nodes[rootNode->firstChild + i];
+        if (child->move == MCTS_PRUNED) continue;
+        int v = child->visits.load(std::memory_order_relaxed);
+        if (v > best) {
+            second = best;
+            best = v;
+        }
+        else if (v > second) {
+            second = v;
+        }
+    }
+
+    double left = done / elapsedMs * (params->maxTimeMs - elapsedMs);
+    if (shared->maxPlayouts > 0 && left > shared->maxPlayouts - done) left = shared->maxPlayouts - done;
+    if (best - second > left) return 1;
+    return elapsedMs >= params->softTimeMs && best >= second * MCTS_SETTLE_RATIO;
+}
+
+// 搜索线程: 反复执行 选择-展开-模拟-回传, 直到预算用完
+template <int N>
+static void searchWorker(MctsShared* shared, unsigned int seed) {
+    MctsTree* tree = shared->tree;
+    const MctsParams* params = shared->params;
+    const unsigned char* patterns = params->usePatterns ? patternTable() : NULL;
+    const Network* network = searchNetwork(params, N);
+    unsigned int rng = seed;
+    int path[MCTS_MAX_DEPTH];
+    int localPlayouts = 0;
+    // 随机对局很快, 每 32 次看一次时间; 用网络时每次都要等估值(成批时可达几百毫秒), 每次都看,
+    // 并且按本线程每次的平均用时, 不再开始时限内做不完的一次
+    int timeCheckMask = network != NULL ? 0 : 31;
+
+    while (!shared->stop.load(std::memory_order_relaxed)) {
+        if (params->cancel != NULL && params->cancel->load(std::memory_order_relaxed)) break;
+        if (params->ponder && tree->nodeCount.load(std::memory_order_relaxed) >= tree->capacity) break;
+        if (shared->maxPlayouts > 0 &&
+            shared->playoutsStarted.fetch_add(1, std::memory_order_relaxed) >= shared->maxPlayouts) {
+            break;
+        }
+        if (params->maxTimeMs > 0 && (localPlayouts & timeCheckMask) == 0) {
+            double elapsedMs = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - shared->startTime).count();
+            double iterationMs = network != NULL && localPlayouts > 0 ? elapsedMs / localPlayouts : 0.0;
+            if (elapsedMs + iterationMs >= params->maxTimeMs ||
+                (params->softTimeMs > 0 && searchSettled(shared, elapsedMs))) {
+                shared->stop.store(1, std::memory_order_relaxed);
+                break;
+            }
+        }
+
+        GameState gs = *shared->root;
+        int depth = 0;
+        int index = 0;
+        int passes = 0;
+        path[depth++] = 0;
+        tree->nodes[0].visits.fetch_add(1, std::memory_order_relaxed);
+
+        // 选择: 沿 UCT 下降到叶节点
+        while (tree->nodes[index].state.load(std::memory_order_acquire) == NODE_EXPANDED &&
+            passes < 2 && depth < MCTS_MAX_DEPTH) {
+            index = descend(tree, index, &gs, &passes);
+            path[depth++] = index;
+        }
+
+        // 展开: 访问足够次数的叶节点生成子节点并下降一步
+        if (passes < 2 && depth < MCTS_MAX_DEPTH &&
+            tree->nodes[index].visits.load(std::memory_order_relaxed) >= shared->expandVisits) {
+            short recent[FEATURE_HISTORY];
+            if (network != NULL) pathRecentMoves(tree, params, path, depth, recent);
+            expandNode<N>(tree, index, &gs, recent, 0, params, &rng);
+            if (tree->nodes[index].state.load(std::memory_order_acquire) == NODE_EXPANDED) {
+                index = descend(tree, index, &gs, &passes);
+                path[depth++] = index;
+            }
+        }
+
+        // 模拟与回传: 撤掉虚拟负局, 每个节点记走出该着的一方是否获胜
+        // 有网络时把叶节点的价值估计换算成黑胜的概率抽一次胜负, 节点仍按整数胜局统计; 终局照常计分
+        int winner;
+        if (network != NULL && passes < 2) {
+            short recent[FEATURE_HISTORY];
+            float value;
+            pathRecentMoves(tree, params, path, depth, recent);
+            evaluateNetwork(params, network, &gs, recent, NULL, &value);
+            float blackWins = (gs.currentPlayer == BLACK) ? (1.0f + value) * 0.5f : (1.0f - value) * 0.5f;
+            winner = (nextRandom(&rng) >> 8) < (unsigned int)(blackWins * 16777216.0f) ? BLACK : WHITE;
+        }
+        else {
+            int last = (index != 0 && tree->nodes[index].move != MCTS_PASS) ? tree->nodes[index].move : -1;
+            float score = runPlayout<N>(&gs, passes, last, params->komi, patterns, params->readLadders, &rng);
+            winner = score > 0 ? BLACK : WHITE;
+        }
+        int mover = shared->root->currentPlayer;
+        for (int i = 1; i < depth; i++) {
+            MctsNode* node = &tree->nodes[path[i]];
+            node->visits.fetch_add(1 - MCTS_VIRTUAL_LOSS, std::memory_order_relaxed);
+            if (mover == winner) node->wins.fetch_add(1, std::memory_order_relaxed);
+            mover = (mover == BLACK) ? WHITE : BLACK;
+        }
+        shared->playoutsDone.fetch_add(1, std::memory_order_relaxed);
+        localPlayouts++;
+    }
+}
+
+// 节点初始化为未展开的叶节点
+static void initNode(MctsNode* node, int move) {
+    node->visits.store(0, std::memory_order_relaxed);
+    node->wins.store(0, std::memory_order_relaxed);
+    node->state.store(NODE_LEAF, std::memory_order_relaxed);
+    node->firstChild = -1;
+    node->childCount = 0;
+    node->move = (short)move;
+}
+
+// 复制节点的统计(子节点下标由调用者处理)
+static void copyNode(MctsNode* dst, const MctsNode* src) {
+    dst->visits.store(src->visits.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    dst->wins.store(src->wins.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    dst->state.store(src->state.load(std::memory_order_relaxed) == NODE_EXPANDED ? NODE_EXPANDED : NODE_LEAF,
+        std::memory_order_relaxed);
+    dst->childCount = src->childCount;
+    dst->move = src->move;
+}
+
+// 清空整棵树, 以 root 为新的根
+static void resetTree(MctsTree* tree, const GameState* root) {
+    tree->nodeCount.store(1);
+    initNode(&tree->nodes[0], MCTS_PASS);
+    tree->rootState = *root;
+    tree->hasRoot = 1;
+}
+
+// 两个局面是否相同(棋盘大小、棋子和轮走方)
+static int samePosition(const GameState* a, const GameState* b) {
+    return a->hash == b->hash && a->currentPlayer == b->currentPlayer && a->size == b->size;
+}
+
+// 在旧树的前两层找与 root 相同的节点, 没有返回 -1
+static int findReusableNode(const MctsTree* tree, const GameState* root) {
+    if (!tree->hasRoot) return -1;
+    if (samePosition(&tree->rootState, root)) return 0;
+
+    const MctsNode* rootNode = &tree->nodes[0];
+    if (rootNode->state.load() != NODE_EXPANDED) return -1;
+
+    for (int i = 0; i < rootNode->childCount; i++) {
+        int index = rootNode->firstChild + i;
+        const MctsNode* child = &tree->nodes[index];
+        if (child->move == MCTS_PRUNED) continue;
+
+        GameState gs = tree->rootState;
+        playTreeMove(&gs, child->move);
+        if (samePosition(&gs, root)) return index;
+        if (child->state.load() != NODE_EXPANDED) continue;
+
+        // 第二层只比较哈希, 不必真的走出每一手
+        int opponent = (gs.currentPlayer == BLACK) ? WHITE : BLACK;
+        if (opponent != root->currentPlayer) continue;
+        for (int k = 0; k < child->childCount; k++) {
+            const MctsNode* grandchild = &tree->nodes[child->firstChild + k];
+            int move = grandchild->move;
+            if (move == MCTS_PRUNED) continue;
+            unsigned long long hash = (move == MCTS_PASS) ? gs.hash :
+                stateHashAfterMove(&gs, move / BOARD_SIZE, move % BOARD_SIZE, gs.currentPlayer);
+            if (hash == root->hash) return child->firstChild + k;
+        }
+    }
+    return -1;
+}
+
+// 把以 index 为根的子树按广度优先复制到备用节点池并交换, 其余节点全部丢弃
+static void compactTree(MctsTree* tree, int index) {
+    if (tree->spare == NULL) tree->spare = new MctsNode[tree->capacity];
+    MctsNode* src = tree->nodes;
+    MctsNode* dst = tree->spare;
+
+    // 处理到 dst[d] 之前, 其 firstChild 暂存对应的旧节点下标
+    copyNode(&dst[0], &src[index]);
+    dst[0].firstChild = index;
+    int count = 1;
+    for (int d = 0; d < count; d++) {
+        const MctsNode* old = &src[dst[d].firstChild];
+        if (dst[d].state.load(std::memory_order_relaxed) != NODE_EXPANDED) {
+            dst[d].firstChild = -1;
+            dst[d].childCount = 0;
+            continue;
+        }
+        dst[d].firstChild = count;
+        for (int i = 0; i < old->childCount; i++) {
+            copyNode(&dst[count + i], &src[old->firstChild + i]);
+            dst[count + i].firstChild = old->firstChild + i;
+        }
+        count += old->childCount;
+    }
+
+    tree->nodes = dst;
+    tree->spare = src;
+    tree->nodeCount.store(count);
+}
+
+// 准备根节点: 能复用就复用旧树, 否则重建; 再按当前局面剔除根下不合法的着法
+template <int N>
+static void prepareRoot(MctsTree* tree, const GameState* root, const MctsParams* params, unsigned int* rng) {
+    int index = findReusableNode(tree, root);
+    if (index < 0) {
+        resetTree(tree, root);
+    }
+    else if (index > 0) {
+        compactTree(tree, index);
+    }
+    tree->rootState = *root;
+    int rootPath[1] = { 0 };
+    short recent[FEATURE_HISTORY];
+    pathRecentMoves(tree, params, rootPath, 1, recent);
+
+    MctsNode* rootNode = &tree->nodes[0];
+    if (rootNode->state.load() == NODE_LEAF) {
+        expandNode<N>(tree, 0, root, recent, 1, params, rng);
+        return;
+    }
+
+    // 复用的根节点当时没有检查打劫和全局同形
+    int legalCount = 0;
+    for (int i = 0; i < rootNode->childCount; i++) {
+        MctsNode* child = &tree->nodes[rootNode->firstChild + i];
+        int move = child->move;
+        if (move == MCTS_PRUNED) continue;
+        if (move != MCTS_PASS) {
+            int x = move / BOARD_SIZE;
+            int y = move % BOARD_SIZE;
+            if (!stateIsLegal(root, x, y) ||
+                (params->rootPosition != NULL && !posIsLegal(params->rootPosition, x, y))) {
+                child->move = MCTS_PRUNED;
+                continue;
+            }
+        }
+        legalCount++;
+    }
+    if (legalCount == 0) {
+        resetTree(tree, root);
+        expandNode<N>(tree, 0, root, recent, 1, params, rng);
+    }
+}
+
+// 一种棋盘大小的搜索函数, 每次搜索开始时按根局面的路数选定
+typedef struct {
+    void (*prepareRoot)(MctsTree* tree, const GameState* root, const MctsParams* params, unsigned int* rng);
+    void (*worker)(MctsShared* shared, unsigned int seed);
+    float (*playout)(GameState* gs, int passes, int last, float komi, const unsigned char* patterns, int readLadders, unsigned int* rng);
+} MctsKernel;
+
+template <int N>
+static const MctsKernel* sizedKernel() {
+    static const MctsKernel kernel = { prepareRoot<N>, searchWorker<N>, runPlayout<N> };
+    return &kernel;
+}
+
+static const MctsKernel* kernelFor(int size) {
+    switch (size) {
+    case 9: return sizedKernel<9>();
+    case 13: return sizedKernel<13>();
+    default: return sizedKernel<19>();
+    }
+}
+
+// 创建可在多次搜索间复用的搜索树
+MctsTree* mctsTreeCreate() {
+    MctsTree* tree = new MctsTree;
+    tree->capacity = MCTS_MAX_NODES;
+    tree->nodes = new MctsNode[tree->capacity];
+    tree->spare = NULL;
+    tree->nodeCount.store(0);
+    tree->hasRoot = 0;
+    tree->priorVisits = 0;
+    tree->ready.store(0);
+    return tree;
+}
+
+void mctsTreeDestroy(MctsTree* tree) {
+    if (tree == NULL) return;
+    delete[] tree->nodes;
+    delete[] tree->spare;
+    delete tree;
+}
+
+// 根节点访问最多的着法; 可在搜索进行中调用. 树未就绪或访问数不足 minVisits 时返回0
+int mctsTreeBestMove(const MctsTree* tree, int minVisits, int* x, int* y, int* visits) {
+    if (!tree->ready.load(std::memory_order_acquire)) return 0;
+
+    const MctsNode* rootNode = &tree->nodes[0];
+    if (rootNode->state.load(std::memory_order_acquire) != NODE_EXPANDED) return 0;
+
+    int bestMove = MCTS_PASS;
+    int bestVisits = -1;
+    for (int i = 0; i < rootNode->childCount; i++) {
+        const MctsNode* child = &tree->nodes[rootNode->firstChild + i];
+        if (child->move == MCTS_PRUNED) continue;
+        int v = child->visits.load(std::memory_order_relaxed);
+        if (v > bestVisits) {
+            bestVisits = v;
+            bestMove = child->move;
+        }
+    }
+    if (visits != NULL) *visits = rootNode->visits.load(std::memory_order_relaxed);
+    if (rootNode->visits.load(std::memory_order_relaxed) < minVisits) return 0;
+
+    *x = bestMove == MCTS_PASS ? -1 : bestMove / BOARD_SIZE;
+    *y = bestMove == MCTS_PASS ? -1 : bestMove % BOARD_SIZE;
+    return 1;
+}
+
+// 上一次搜索结束后根节点各子节点的搜索访问数(扣除先验), 写入 visits[MAX_POINTS + 1]
+// (下标 x * BOARD_SIZE + y, 停一手为 MCTS_PASS, 没有的着法为 0), 返回合计; 在调用 mctsSearchTree 的线程中使用
+int mctsTreeRootVisits(const MctsTree* tree, int* visits) {
+    memset(visits, 0, sizeof(int) * (MAX_POINTS + 1));
+    if (!tree->hasRoot) return 0;
+    const MctsNode* rootNode = &tree->nodes[0];
+    if (rootNode->state.load(std::memory_order_acquire) != NODE_EXPANDED) return 0;
+
+    int total = 0;
+    for (int i = 0; i < rootNode->childCount; i++) {
+        const MctsNode* child = &tree->nodes[rootNode->firstChild + i];
+        if (child->move == MCTS_PRUNED) continue;
+        int v = child->visits.load(std::memory_order_relaxed) - tree->priorVisits;
+        if (v <= 0) continue;
+        visits[child->move] = v;
+        total += v;
+    }
+    return total;
+}
+
+// 各难度(1~3)每步的模拟次数, 界面和自对弈共用
+int mctsLevelPlayouts(int level) {
+    static const int playouts[4] = { 0, 1000, 4000, 12000 };
+    if (level < 1) level = 1;
+    if (level > 3) level = 3;
+    return playouts[level];
+}
+
+// 局面的复杂程度: 按手数在整局中的位置(布局少用、中盘多用、收官渐少), 气紧的棋串(对杀、打劫)越多越复杂
+static float positionEffort(const GameState* gs) {
+    int n = gs->size;
+    float expected = n * n * 2.0f / 3.0f; // 一局大约的手数
+    float t = gs->moveCount / expected;
+    float effort;
+    if (t < 0.1f) effort = 0.6f;
+    else if (t < 0.3f) effort = 0.6f + (t - 0.1f) * 4.0f;
+    else if (t < 0.6f) effort = 1.4f;
+    else if (t < 1.0f) effort = 1.4f - (t - 0.6f) * 1.75f;
+    else effort = 0.7f;
+
+    int weak = 0;
+    for (int x = 0; x < n && weak < 5; x++) {
+        for (int y = 0; y < n && weak < 5; y++) {
+            int p = PAD_INDEX(x, y);
+            if (gs->cells[p] == EMPTY || gs->chainHead[p] != p) continue;
+            if (stateLiberties(gs, x, y) <= 2) weak++;
+        }
+    }
+    return effort * (1.0f + 0.1f * weak);
+}
+
+// 按剩余用时给这一手分配思考时间: *softMs 为通常的用时, *hardMs 为绝不超过的上限(都不小于 MCTS_MIN_THINK_MS);
+// mainMs 为剩余的基本时间, 之后还有 periods 次读秒, 本次读秒剩 periodMs; iterationMs 为每个线程做一次模拟的用时
+// (上一步实测, 用网络时是等一批估值的时间), 到时限时正在做的一次还要做完, 上限中再扣除这么多;
+// 返回本手相对平均用时的倍数
+float mctsPlanTime(const GameState* gs, int mainMs, int periods, int periodMs, double iterationMs,
+    int* softMs, int* hardMs) {
+    int points = gs->size * gs->size;
+    int movesLeft = (points * 2 / 3 - gs->moveCount) / 2; // 己方大约还要下的手数
+    if (movesLeft < points / 12) movesLeft = points / 12;
+    if (movesLeft < 1) movesLeft = 1;
+    float effort = positionEffort(gs);
+    double slack = MCTS_TIME_MARGIN_MS + iterationMs;
+    double usable = periods > 0 ? periodMs - slack : 0.0; // 读秒中每手可放心用的时间
+
+    double soft, hard;
+    if (mainMs > 0) {
+        // 基本时间按剩余手数平摊; 有读秒时用完基本时间也不会输, 再加半次读秒
+        soft = (double)mainMs / movesLeft + (usable > 0 ? usable / 2.0 : 0.0);
+        soft *= effort;
+        hard = soft * 3.0;
+        // 一手最多用四分之一的基本时间, 有读秒时再加上一次读秒
+        double cap = usable > 0 ? mainMs / 4.0 + usable : mainMs / 4.0 - iterationMs;
+        if (hard > cap) hard = cap;
+    }
+    else {
+        hard = usable;
+        soft = usable * effort / 2.0;
+    }
+    if (soft > hard) soft = hard;
+    *hardMs = hard > MCTS_MIN_THINK_MS ? (int)hard : MCTS_MIN_THINK_MS;
+    *softMs = soft > MCTS_MIN_THINK_MS ? (int)soft : MCTS_MIN_THINK_MS;
+    return effort;
+}
+
+// 按预算执行蒙特卡洛树搜索, params->threads 个线程共享同一棵树; 树中已有的相关子树会被复用
+void mctsSearchTree(MctsTree* tree, const GameState* root, const MctsParams* params, MctsResult* result) {
+    MctsShared* shared = new MctsShared;
+    shared->tree = tree;
+    shared->startTime = std::chrono::steady_clock::now();
+    shared->root = root;
+    shared->params = params;
+    shared->playoutsStarted.store(0);
+    shared->playoutsDone.store(0);
+    shared->stop.store(0);
+
+    shared->maxPlayouts = params->maxPlayouts;
+    if (params->ponder) {
+        shared->maxPlayouts = 0;
+    }
+    else if (shared->maxPlayouts <= 0 && params->maxTimeMs <= 0) {
+        shared->maxPlayouts = MCTS_DEFAULT_PLAYOUTS;
+    }
+    int hasPrior = params->usePrior || searchNetwork(params, root->size) != NULL;
+    shared->expandVisits = MCTS_EXPAND_VISITS + MCTS_VIRTUAL_LOSS + (hasPrior ? MCTS_PRIOR_VISITS : 0);
+    tree->priorVisits = hasPrior ? MCTS_PRIOR_VISITS : 0;
+
+    int threads = params->threads;
+    if (threads <= 0) threads = (int)std::thread::hardware_concurrency();
+    if (threads <= 0) threads = 1;
+    if (threads > MCTS_MAX_THREADS) threads = MCTS_MAX_THREADS;
+
+    // 根节点在启动线程前准备好
+    const MctsKernel* kernel = kernelFor(root->size);
+    unsigned int seed = params->seed != 0 ? params->seed : 0x2545F491u;
+    tree->ready.store(0);
+    kernel->prepareRoot(tree, root, params, &seed);
+    int reusedVisits = tree->nodes[0].visits.load();
+    tree->ready.store(1, std::memory_order_release);
+
+    // 每个线程独立的随机数种子
+    std::thread workers[MCTS_MAX_THREADS];
+    for (int i = 1; i < threads; i++) {
+        unsigned int threadSeed = seed + (unsigned int)i * 0x9E3779B9u;
+        workers[i] = std::thread(kernel->worker, shared, threadSeed != 0 ? threadSeed : 1u);
+    }
+    kernel->worker(shared, seed);
+    for (int i = 1; i < threads; i++) {
+        workers[i].join();
+    }
+
+    // 选访问次数最多的着法
+    const MctsNode* rootNode = &tree->nodes[0];
+    int bestMove = MCTS_PASS;
+    int bestVisits = -1;
+    int bestWins = 0;
+    for (int i = 0; i < rootNode->childCount; i++) {
+        const MctsNode* child = &tree->nodes[rootNode->firstChild + i];
+        if (child->move == MCTS_PRUNED) continue;
+        int visits = child->visits.load();
+        if (visits > bestVisits) {
+            bestVisits = visits;
+            bestWins = child->wins.load();
+            bestMove = child->move;
+        }
+    }
+
+    double elapsedMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - shared->startTime).count();
+    int playouts = shared->playoutsDone.load();
+    int nodes = tree->nodeCount.load();
+
+    result->bestX = bestMove == MCTS_PASS ? -1 : bestMove / BOARD_SIZE;
+    result->bestY = bestMove == MCTS_PASS ? -1 : bestMove % BOARD_SIZE;
+    result->playouts = playouts;
+    result->reusedVisits = reusedVisits;
+    result->nodes = nodes < tree->capacity ? nodes : tree->capacity;
+    result->threads = threads;
+    result->elapsedMs = elapsedMs;
+    result->playoutsPerSec = elapsedMs > 0.0 ? playouts * 1000.0 / elapsedMs : 0.0;
+    result->winRate = bestVisits > 0 ? (float)bestWins / bestVisits : 0.5f;
+
+    // 下一次搜索开始时会整理节点池, 搜索结束后不再允许其他线程读取
+    tree->ready.store(0);
+    delete shared;
+}
+
+// 搜索参数的默认值: 单线程、MCTS_DEFAULT_PLAYOUTS 次模拟、启发式先验和走子策略, 不读征子、不用网络、不限时
+void mctsDefaultParams(MctsParams* params) {
+    params->maxPlayouts = MCTS_DEFAULT_PLAYOUTS;
+    params->maxTimeMs = 0;
+    params->komi = 7.5f;
+    params->seed = 0;
+    params->threads = 1;
+    params->usePrior = 1;
+    params->usePatterns = 1;
+    params->readLadders = 0;
+    params->network = NULL;
+    params->evalQueue = NULL;
+    params->rootPosition = NULL;
+    params->cancel = NULL;
+    params->ponder = 0;
+    params->softTimeMs = 0;
+}
+
+// 单次搜索: 临时建一棵树, 搜完释放
+void mctsSearch(const GameState* root, const MctsParams* params, MctsResult* result) {
+    MctsTree* tree = mctsTreeCreate();
+    mctsSearchTree(tree, root, params, result);
+    mctsTreeDestroy(tree);
+}
+
+// 不建树, 从 gs 按走子策略下完一局(与打开 usePatterns 的搜索中的模拟相同), gs 变为终局局面; 返回黑方目差
+// rng 为调用者的随机数状态, 不能为 0
+float mctsPlayout(GameState* gs, float komi, unsigned int* rng) {
+    return kernelFor(gs->size)->playout(gs, 0, -1, komi, patternTable(), 0, rng);
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+/*
+ * 围棋游戏系统 - Part 3: 蒙特卡洛树搜索
+ * 负责人: 2518801370 李卓洵
+ * 包含: UCT 树搜索(可多线程)、轻量随机对局或策略价值网络估值、Tromp-Taylor 终局计分
+ * 说明: 只依赖规则引擎, 不依赖 EasyX, 可在 Linux 下无界面运行
+ */
+
+#ifndef PART3_MCTS_H
+#define PART3_MCTS_H
+
+#include "Part1_Position.h"
+#include "Part3_EvalQueue.h"
+#include <atomic>
+
+#define MCTS_PASS MAX_POINTS        // 停一手的着法编号
+#define MCTS_PRUNED (-1)            // 复用的根节点下已不合法的着法
+#define MCTS_MAX_NODES (1 << 20)    // 搜索树节点上限
+#define MCTS_EXPAND_VISITS 4        // 叶节点访问这么多次后才展开
+#define MCTS_DEFAULT_PLAYOUTS 3000  // 没有给出任何预算时的模拟次数
+#define MCTS_MAX_THREADS 64         // 搜索线程数上限
+#define MCTS_VIRTUAL_LOSS 3         // 线程经过节点时临时记的负局数, 使各线程分散到不同变化
+#define MCTS_PRIOR_VISITS 10        // 启发式先验折算成的初始访问次数
+#define MCTS_HINT_MIN_VISITS 200    // 从后台思考的树中取提示所需的最少根节点访问数
+#define MCTS_SETTLE_MIN_PLAYOUTS 64 // 按时间管理时, 本次搜索至少这么多次模拟后才考虑提前结束
+#define MCTS_SETTLE_RATIO 2         // 过了软时限后, 最多访问的着法是次多的这么多倍即结束
+#define MCTS_TIME_MARGIN_MS 500     // 按剩余用时分配时间时留出的余量(结束线程、界面取回结果和落子)
+#define MCTS_MIN_THINK_MS 20        // 分配的思考时间下限
+
+// 搜索参数: 模拟次数和时间至少给一个, 两者都给时先到者为准; 先用 mctsDefaultParams 填好, 再改需要的项
+typedef struct {
+    int maxPlayouts;  // 模拟次数上限, 0 表示不限
+    int maxTimeMs;    // 思考时间上限(毫秒), 0 表示不限
+    float komi;
+    unsigned int seed;
+    int threads;      // 搜索线程数, 0 表示按CPU核数
+    int usePrior;     // 非 0 时新节点按整盘启发式分数预置胜率
+    int usePatterns;  // 非 0 时模拟按走子策略(提子、长出、3x3 好形)落子, 否则纯随机
+    int readLadders;  // 非 0 时走子策略长出前先读征子, 死征子不跑; 模拟约慢一半, 默认不开
+    const Network* network; // 非 NULL 且路数与棋盘相同时, 先验取网络的策略, 叶节点的胜负按网络的价值估计代替随机对局
+    EvalQueue* evalQueue;   // 非 NULL 时改用队列的网络, 各线程的估值在队列里合批计算(线程应多于批大小的一半)
+    const Position* rootPosition;  // 非 NULL 时根节点按其棋谱再检查全局同形, state 应与 root 相同
+    const std::atomic<int>* cancel; // 非 NULL 且变为非 0 时尽快结束搜索
+    int ponder;       // 非 0 时忽略预算, 一直搜索到取消或节点池用满(对手思考时用)
+    int softTimeMs;   // 非 0 时按时间管理(须同时给 maxTimeMs): 剩余预算内最佳着法已不会被超过时提前结束,
+                      // 过了这个时间最佳着法明显领先也结束, 否则继续搜到 maxTimeMs
+} MctsParams;
+
+// 搜索结果
+typedef struct {
+    int bestX;        // 都为 -1 表示停一手
+    int bestY;
+    int playouts;     // 本次搜索的模拟次数
+    int reusedVisits; // 从上一棵树继承的根节点访问数
+    int nodes;
+    int threads;      // 实际使用的线程数
+    double elapsedMs;
+    double playoutsPerSec;
+    float winRate;    // 根节点走子方的胜率估计
+} MctsResult;
+
+// 可复用的搜索树
+typedef struct MctsTree MctsTree;
+
+MctsTree* mctsTreeCreate();
+void mctsTreeDestroy(MctsTree* tree);
+void mctsSearchTree(MctsTree* tree, const GameState* root, const MctsParams* params, MctsResult* result);
+int mctsTreeBestMove(const MctsTree* tree, int minVisits, int* x, int* y, int* visits);
+int mctsTreeRootVisits(const MctsTree* tree, int* visits);
+void mctsDefaultParams(MctsParams* params);
+void mctsSearch(const GameState* root, const MctsParams* params, MctsResult* result);
+float mctsPlayout(GameState* gs, float komi, unsigned int* rng);
+int mctsLevelPlayouts(int level);
+float mctsPlanTime(const GameState* gs, int mainMs, int periods, int periodMs, double iterationMs,
+    int* softMs, int* hardMs);
+
+#endif // PART3_MCTS_H
\ No newline at end of file
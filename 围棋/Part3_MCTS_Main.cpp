@@ -0,0 +1,355 @@
+/*
+ * 围棋游戏系统 - Part 3: 蒙特卡洛树搜索无界面测试程序
+ * 负责人: 2518801370 李卓洵
+ * 用法: go_mcts [--size 棋盘路数] [--patterns 模式文件] [--ladders] [--network 权重文件 [--queue 批大小 等待微秒]] [每步模拟次数] [对局手数] [线程数] [是否用启发式先验] [是否用走子策略]
+ *       go_mcts [--size 棋盘路数] [--patterns 模式文件] [--ladders] [--network 权重文件 [--queue 批大小 等待微秒]] --scaling [每步模拟次数] [局面数]
+ *       go_mcts [--size 棋盘路数] [--patterns 模式文件] [--ladders] [--network 权重文件 [--queue 批大小 等待微秒]] --match [每步模拟次数] [对局数]
+ *       go_mcts [--size 棋盘路数] [--patterns 模式文件] [--ladders] [--network 权重文件 [--queue 批大小 等待微秒]] --clock [基本时间秒数] [读秒次数] [每次读秒秒数] [线程数]
+ * 自对弈模式从空棋盘开始, 双方共用一棵树(每步复用上一步的子树),
+ * 打印每步的模拟次数、继承的访问数、耗时和每秒模拟次数
+ * 扩展性模式在固定局面集上分别用 1/2/4/8/16 线程搜索, 打印速度和与单线程选点的一致率
+ * 对抗模式让模拟用走子策略的一方与纯随机模拟的一方轮流执黑对局, 打印胜率和双方的每秒模拟次数;
+ * 加 --ladders 时双方都用走子策略, 只有一方在模拟中读征子; 加 --network 时这一方(用走子策略或读征子的一方)改用网络估值
+ * --queue 让网络估值经批量队列合批计算, 自对弈模式结束时打印队列的缓存命中和平均批大小
+ * 计时模式先检查棋钟的规则(转入读秒、读秒重新计时、用掉一次读秒、判负), 再按棋钟下一局自对弈,
+ * 每步的思考时间由 mctsPlanTime 分配; 有一方超时、读秒中用掉一次读秒或一步超出上限多于 MCTS_TIME_MARGIN_MS 时
+ * 打印原因并以返回值 1 退出
+ */
+
+#include "Part1_Clock.h"
+#include "Part3_MCTS.h"
+#include "Part3_Patterns.h"
+#include <thread>
+
+static int boardSize = BOARD_SIZE;
+static int readLadders = 0; // --ladders: 模拟中读征子
+static Network* network = NULL; // --network: 用策略价值网络代替启发式先验和随机对局
+static EvalQueue* evalQueue = NULL; // --queue: 网络估值经批量队列合批计算
+
+// 用固定种子随机走 moves 手生成测试局面
+static void makeTestPosition(GameState* gs, unsigned int seed, int moves) {
+    stateReset(gs, boardSize);
+    for (int i = 0; i < moves; i++) {
+        int legal[MAX_POINTS];
+        int count = 0;
+        for (int p = 0; p < MAX_POINTS; p++) {
+            if (stateIsLegal(gs, p / BOARD_SIZE, p % BOARD_SIZE)) legal[count++] = p;
+        }
+        if (count == 0) break;
+
+        seed = seed * 1103515245u + 12345u;
+        int p = legal[(seed >> 8) % count];
+        statePlay(gs, p / BOARD_SIZE, p % BOARD_SIZE, NULL);
+    }
+}
+
+// 1/2/4/8/16 线程的扩展性测试
+static void runScalingReport(int playouts, int positions) {
+    static const int threadCounts[] = { 1, 2, 4, 8, 16 };
+    int bestMoves[5][64];
+    double baseRate = 0.0;
+    if (positions > 64) positions = 64;
+
+    printf("scaling: %dx%d, %d positions, %d playouts per search, %u hardware threads\n",
+        boardSize, boardSize, positions, playouts, std::thread::hardware_concurrency());
+
+    for (int t = 0; t < 5; t++) {
+        double totalMs = 0.0;
+        long long totalPlayouts = 0;
+        int agree = 0;
+
+        for (int i = 0; i < positions; i++) {
+            GameState gs;
+            makeTestPosition(&gs, 1000u + i, 20 + i * 7);
+
+            MctsParams params;
+            mctsDefaultParams(&params);
+            params.maxPlayouts = playouts;
+            params.seed = 4242u + i;
+            params.threads = threadCounts[t];
+            params.readLadders = readLadders;
+            params.network = network;
+            params.evalQueue = evalQueue;
+
+            MctsResult result;
+            mctsSearch(&gs, &params, &result);
+            bestMoves[t][i] = result.bestX * BOARD_SIZE + result.bestY;
+            if (bestMoves[t][i] == bestMoves[0][i]) agree++;
+            totalMs += result.elapsedMs;
+            totalPlayouts += result.playouts;
+        }
+
+        double rate = totalMs > 0.0 ? totalPlayouts * 1000.0 / totalMs : 0.0;
+        if (t == 0) baseRate = rate;
+        printf("threads %2d  %9.0f playouts/s  speedup %5.2fx  agreement with 1 thread %3d/%d\n",
+            threadCounts[t], rate, baseRate > 0.0 ? rate / baseRate : 0.0, agree, positions);
+    }
+}
+
+// 走子策略对纯随机模拟(--ladders 时为读征子对不读征子): 双方同样的模拟次数, 轮流执黑下完 games 局
+static void runPolicyMatch(int playouts, int games) {
+    int policyWins = 0;
+    double msBySide[2] = { 0.0, 0.0 };
+    long long playoutsBySide[2] = { 0, 0 };
+
+    for (int g = 0; g < games; g++) {
+        int policyColor = (g % 2 == 0) ? BLACK : WHITE;
+        GameState gs;
+        stateReset(&gs, boardSize);
+
+        MctsParams params;
+        mctsDefaultParams(&params);
+        params.maxPlayouts = playouts;
+        params.seed = 9001u + g * 7919u;
+
+        int passes = 0;
+        for (int i = 0; passes < 2 && i < boardSize * boardSize * 2; i++) {
+            int side = gs.currentPlayer == policyColor ? 0 : 1;
+            MctsResult result;
+            params.usePatterns = readLadders || side == 0;
+            params.readLadders = readLadders && side == 0;
+            params.network = side == 0 ? network : NULL;
+            params.evalQueue = side == 0 ? evalQueue : NULL;
+            params.seed += 104729u;
+            mctsSearch(&gs, &params, &result);
+            msBySide[side] += result.elapsedMs;
+            playoutsBySide[side] += result.playouts;
+
+            if (result.bestX < 0) {
+                statePass(&gs);
+                passes++;
+            }
+            else {
+                statePlay(&gs, result.bestX, result.bestY, NULL);
+                passes = 0;
+            }
+        }
+
+        float score = stateAreaScore(&gs, params.komi, NULL);
+        int policyWon = (score > 0) == (policyColor == BLACK);
+        policyWins += policyWon;
+        printf("game %3d  policy plays %s  score %+6.1f  %s\n", g + 1,
+            policyColor == BLACK ? "B" : "W", score, policyWon ? "policy wins" : "random wins");
+    }
+
+    printf("policy %d/%d wins on %dx%d, %d playouts per move; %.0f vs %.0f playouts/s\n",
+        policyWins, games, boardSize, boardSize, playouts,
+        msBySide[0] > 0.0 ? playoutsBySide[0] * 1000.0 / msBySide[0] : 0.0,
+        msBySide[1] > 0.0 ? playoutsBySide[1] * 1000.0 / msBySide[1] : 0.0);
+}
+
+static int expect(int ok, const char* what) {
+    if (!ok) printf("clock check failed: %s\n", what);
+    return !ok;
+}
+
+// 棋钟规则自检, 返回失败的项数
+static int checkClockRules() {
+    int failures = 0;
+    GameClock clock;
+    clockInit(&clock, 2, 2, 1); // 2 秒基本时间, 2 次 1 秒读秒
+    clockTick(&clock, BLACK, 1500);
+    failures += expect(clock.mainMs[BLACK] == 500 && !clockInByoYomi(&clock, BLACK), "main time runs first");
+    clockTick(&clock, BLACK, 800);
+    failures += expect(clockInByoYomi(&clock, BLACK) && clock.periods[BLACK] == 2 && clock.periodLeftMs[BLACK] == 700,
+        "main time overflows into byo-yomi");
+    failures += expect(clock.mainMs[WHITE] == 2000, "only the side to move is charged");
+    clockPunch(&clock, BLACK);
+    failures += expect(clock.periodLeftMs[BLACK] == 1000, "a move resets the period");
+    clockTick(&clock, BLACK, 1200);
+    failures += expect(clock.periods[BLACK] == 1 && clock.periodLeftMs[BLACK] == 800, "an overrun uses up one period");
+    failures += expect(clockTick(&clock, BLACK, 799) == 0 && clockRemainingMs(&clock, BLACK) == 1, "last period counts down");
+    failures += expect(clockTick(&clock, BLACK, 1) == 1 && clock.flagged == BLACK && !clockRunning(&clock),
+        "last period exhausted flags");
+    clockInit(&clock, 1, 0, 0);
+    failures += expect(clockTick(&clock, WHITE, 999) == 0 && clockTick(&clock, WHITE, 1) == 1 && clock.flagged == WHITE,
+        "sudden death flags when main time is gone");
+    clockInit(&clock, 0, 0, 0);
+    failures += expect(!clock.enabled, "no main time and no periods means untimed");
+    return failures;
+}
+
+// 按棋钟自对弈一局: 每步按剩余用时分配时间, 实际用时从棋钟上扣除
+static int runClockGame(int mainSeconds, int periods, int periodSeconds, int threads) {
+    int failures = checkClockRules();
+    printf("clock rules: %s\n", failures == 0 ? "ok" : "FAILED");
+    printf("clock game: %dx%d, %d s main time, %d x %d s byo-yomi, %d thread(s)\n",
+        boardSize, boardSize, mainSeconds, periods, periodSeconds, threads);
+
+    GameClock clock;
+    clockInit(&clock, mainSeconds, periods, periodSeconds);
+    GameState gs;
+    stateReset(&gs, boardSize);
+
+    MctsParams params;
+    mctsDefaultParams(&params);
+    params.maxPlayouts = 0;
+    params.seed = 2024;
+    params.threads = threads;
+    params.readLadders = readLadders;
+    params.network = network;
+    params.evalQueue = evalQueue;
+
+    double iterationMs[3] = { 0.0, 0.0, 0.0 };
+    double usedMs[3] = { 0.0, 0.0, 0.0 };
+    int worstOverrun = 0;
+    int passes = 0;
+    int maxMoves = boardSize * boardSize * 2;
+    int moves = 0;
+    MctsTree* tree = mctsTreeCreate();
+
+    for (; moves < maxMoves && passes < 2; moves++) {
+        int side = gs.currentPlayer;
+        int inByoYomi = clockInByoYomi(&clock, side);
+        int periodsBefore = clock.periods[side];
+        int softMs, hardMs;
+        mctsPlanTime(&gs, clock.mainMs[side], clock.periods[side], clock.periodLeftMs[side], iterationMs[side],
+            &softMs, &hardMs);
+        params.maxTimeMs = hardMs;
+        params.softTimeMs = softMs;
+        params.seed += 7919;
+
+        MctsResult result;
+        long long start = clockNowMs();
+        mctsSearchTree(tree, &gs, &params, &result);
+        int elapsedMs = (int)(clockNowMs() - start);
+        if (result.playouts > 0) iterationMs[side] = result.elapsedMs * result.threads / result.playouts;
+        usedMs[side] += elapsedMs;
+        if (elapsedMs - hardMs > worstOverrun) worstOverrun = elapsedMs - hardMs;
+
+        int flagged = clockTick(&clock, side, elapsedMs);
+        printf("move %3d %s  main %6.1f s  periods %d  plan %6d / %6d ms  used %6d ms  playouts %6d\n",
+            moves + 1, side == BLACK ? "B" : "W", clock.mainMs[side] / 1000.0, clock.periods[side],
+            softMs, hardMs, elapsedMs, result.playouts);
+
+        failures += expect(elapsedMs <= hardMs + MCTS_TIME_MARGIN_MS, "search overran its hard limit");
+        failures += expect(!inByoYomi || clock.periods[side] == periodsBefore, "search used up a byo-yomi period");
+        if (expect(!flagged, "side to move lost on time")) {
+            failures++;
+            break;
+        }
+
+        if (result.bestX < 0) {
+            statePass(&gs);
+            passes++;
+        }
+        else {
+            statePlay(&gs, result.bestX, result.bestY, NULL);
+            passes = 0;
+        }
+        clockPunch(&clock, side);
+    }
+
+    mctsTreeDestroy(tree);
+    printf("clock game: %d moves, black used %.1f s, white used %.1f s, worst overrun %d ms: %s\n",
+        moves, usedMs[BLACK] / 1000.0, usedMs[WHITE] / 1000.0, worstOverrun, failures == 0 ? "ok" : "FAILED");
+    return failures;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 2 && strcmp(argv[1], "--size") == 0) {
+        boardSize = atoi(argv[2]);
+        argc -= 2;
+        argv += 2;
+    }
+    if (argc > 2 && strcmp(argv[1], "--patterns") == 0) {
+        int count = patternLoad(argv[2]);
+        if (count < 0) {
+            printf("cannot open pattern file %s\n", argv[2]);
+            return 1;
+        }
+        printf("%d patterns loaded from %s\n", count, argv[2]);
+        argc -= 2;
+        argv += 2;
+    }
+    if (argc > 1 && strcmp(argv[1], "--ladders") == 0) {
+        readLadders = 1;
+        argc--;
+        argv++;
+    }
+    if (argc > 2 && strcmp(argv[1], "--network") == 0) {
+        network = networkLoad(argv[2]);
+        if (network == NULL || network->size != boardSize) {
+            printf("cannot load %dx%d network from %s\n", boardSize, boardSize, argv[2]);
+            return 1;
+        }
+        argc -= 2;
+        argv += 2;
+        if (argc > 3 && strcmp(argv[1], "--queue") == 0) {
+            evalQueue = evalQueueCreate(network, atoi(argv[2]), atoi(argv[3]), EVAL_DEFAULT_CACHE);
+            argc -= 3;
+            argv += 3;
+        }
+    }
+    if (argc > 1 && strcmp(argv[1], "--match") == 0) {
+        runPolicyMatch(argc > 2 ? atoi(argv[2]) : MCTS_DEFAULT_PLAYOUTS, argc > 3 ? atoi(argv[3]) : 10);
+        return 0;
+    }
+    if (argc > 1 && strcmp(argv[1], "--clock") == 0) {
+        return runClockGame(argc > 2 ? atoi(argv[2]) : 10, argc > 3 ? atoi(argv[3]) : 3,
+            argc > 4 ? atoi(argv[4]) : 1, argc > 5 ? atoi(argv[5]) : 1) == 0 ? 0 : 1;
+    }
+    if (argc > 1 && strcmp(argv[1], "--scaling") == 0) {
+        runScalingReport(argc > 2 ? atoi(argv[2]) : MCTS_DEFAULT_PLAYOUTS,
+            argc > 3 ? atoi(argv[3]) : 8);
+        return 0;
+    }
+
+    int playouts = argc > 1 ? atoi(argv[1]) : MCTS_DEFAULT_PLAYOUTS;
+    int moves = argc > 2 ? atoi(argv[2]) : 20;
+    int threads = argc > 3 ? atoi(argv[3]) : 1;
+
+    GameState gs;
+    stateReset(&gs, boardSize);
+
+    MctsParams params;
+    mctsDefaultParams(&params);
+    params.maxPlayouts = playouts;
+    params.seed = 12345;
+    params.threads = threads;
+    params.usePrior = argc > 4 ? atoi(argv[4]) : 1;
+    params.usePatterns = argc > 5 ? atoi(argv[5]) : 1;
+    params.readLadders = readLadders;
+    params.network = network;
+    params.evalQueue = evalQueue;
+
+    double totalMs = 0.0;
+    long long totalPlayouts = 0;
+    int passes = 0;
+    MctsTree* tree = mctsTreeCreate();
+
+    for (int i = 0; i < moves && passes < 2; i++) {
+        MctsResult result;
+        params.seed += 7919;
+        mctsSearchTree(tree, &gs, &params, &result);
+
+        printf("move %3d %s (%2d,%2d)  playouts %6d  reused %6d  nodes %7d  %8.1f ms  %9.0f playouts/s  winrate %.2f\n",
+            i + 1, gs.currentPlayer == BLACK ? "B" : "W", result.bestX, result.bestY,
+            result.playouts, result.reusedVisits, result.nodes, result.elapsedMs, result.playoutsPerSec, result.winRate);
+
+        if (result.bestX < 0) {
+            statePass(&gs);
+            passes++;
+        }
+        else {
+            statePlay(&gs, result.bestX, result.bestY, NULL);
+            passes = 0;
+        }
+        totalMs += result.elapsedMs;
+        totalPlayouts += result.playouts;
+    }
+
+    mctsTreeDestroy(tree);
+
+    printf("total %lld playouts in %.1f ms with %d thread(s), average %.0f playouts/s\n",
+        totalPlayouts, totalMs, threads, totalMs > 0.0 ? totalPlayouts * 1000.0 / totalMs : 0.0);
+    if (evalQueue != NULL) {
+        EvalQueueStats stats;
+        evalQueueStats(evalQueue, &stats);
+        printf("eval queue: %lld requests, %lld cache hits, %lld merged, %lld evaluated in %lld batches, "
+            "average batch %.2f (fill %.0f%%), average wait %.0f us\n", stats.requests, stats.cacheHits, stats.merged,
+            stats.evaluated, stats.batches, stats.averageBatch, stats.averageFill * 100.0, stats.averageWaitUs);
+        evalQueueDestroy(evalQueue);
+    }
+    return 0;
+}
\ No newline at end of file
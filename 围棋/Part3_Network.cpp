@@ -0,0 +1,822 @@
+/*
+ * 围棋游戏系统 - Part 3: 策略价值网络实现
+ * 负责人: 2518801370 李卓洵
+ * 实现: 权重文件读写和随机初始化、主干卷积(标量/AVX2/AVX-512, float/int8)、策略头和价值头
+ * 布局: 每个局面的特征图按 [点][通道] 存放在四周各补一圈 0 的 (N+2)x(N+2) 棋盘上, 3x3 卷积不用判断边界;
+ *       只写内部的点, 边框始终为 0
+ * int8: 主干每层的输入都是 ReLU 之后的非负数, 每个局面按最大值量化到 0~127(u8), 权重按输出通道量化到 s8,
+ *       u8*s8 两两相加不会超出 16 位, 可以用 maddubs(有 VNNI 时用 dpbusd)累加, 最后按两个缩放还原
+ */
+
+#include "Part3_Network.h"
+#include "Part1_BoardTables.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+// 与位棋盘相同, 定义 BB_NO_SIMD 可强制只用标量实现
+#if !defined(BB_NO_SIMD) && defined(__AVX2__) && defined(__FMA__)
+#define NET_HAVE_AVX2 1
+#endif
+#if !defined(BB_NO_SIMD) && defined(__AVX512F__) && defined(__AVX512BW__)
+#define NET_HAVE_AVX512 1
+#endif
+#if defined(NET_HAVE_AVX2) || defined(NET_HAVE_AVX512)
+#include <immintrin.h>
+#endif
+
+#define NET_RESIDUAL_GAIN 0.1f // 随机初始化时残差块第二层权重的缩小倍数, 使深层输出不发散
+
+// 每个线程一份的中间结果, 按网络结构和批大小分配, 边框在分配时清零后不再写入
+typedef struct {
+    int size;
+    int inputPlanes;
+    int channels;
+    int batch;
+    std::vector<float> input;        // [batch][点][inputPlanes]
+    std::vector<float> act;          // [batch][3][点][channels]: 当前层输入、残差块中间层、输出
+    std::vector<unsigned char> qinput; // int8 模式下量化后的输入, [batch][点][inputPlanes 向上取整到 4]
+    std::vector<unsigned char> qact;   // [batch][点][channels]
+} NetWorkspace;
+
+static thread_local NetWorkspace workspace;
+
+static inline int groupsOf(int channels) {
+    return (channels + 3) / 4;
+}
+
+// ---------------- 结构与参数 ----------------
+
+static int initConv(NetConv* conv, int in, int out, int taps) {
+    conv->in = in;
+    conv->out = out;
+    conv->taps = taps;
+    conv->weight = (float*)calloc((size_t)taps * in * out, sizeof(float));
+    conv->bias = (float*)calloc(out, sizeof(float));
+    conv->qweight = NULL;
+    conv->qscale = NULL;
+    return conv->weight != NULL && conv->bias != NULL;
+}
+
+static void freeConv(NetConv* conv) {
+    free(conv->weight);
+    free(conv->bias);
+    free(conv->qweight);
+    free(conv->qscale);
+    conv->weight = conv->bias = conv->qscale = NULL;
+    conv->qweight = NULL;
+}
+
+// 按文件中的顺序列出全部参数数组; arrays 为 NULL 时只返回个数
+static int listArrays(Network* net, float** arrays, size_t* counts) {
+    int n = 0;
+    int points = net->size * net->size;
+#define NET_ARRAY(ptr, count) do { if (arrays != NULL) { arrays[n] = (ptr); counts[n] = (size_t)(count); } n++; } while (0)
+    NET_ARRAY(net->input.weight, (size_t)9 * net->inputPlanes * net->channels);
+    NET_ARRAY(net->input.bias, net->channels);
+    for (int i = 0; i < net->blocks * 2; i++) {
+        NET_ARRAY(net->trunk[i].weight, (size_t)9 * net->channels * net->channels);
+        NET_ARRAY(net->trunk[i].bias, net->channels);
+    }
+    NET_ARRAY(net->policyConv.weight, net->channels * 2);
+    NET_ARRAY(net->policyConv.bias, 2);
+    NET_ARRAY(net->policyWeight, (size_t)2 * points * (points + 1));
+    NET_ARRAY(net->policyBias, points + 1);
+    NET_ARRAY(net->valueConv.weight, net->channels);
+    NET_ARRAY(net->valueConv.bias, 1);
+    NET_ARRAY(net->valueWeight1, (size_t)points * NET_VALUE_HIDDEN);
+    NET_ARRAY(net->valueBias1, NET_VALUE_HIDDEN);
+    NET_ARRAY(net->valueWeight2, NET_VALUE_HIDDEN);
+    NET_ARRAY(net->valueBias2, 1);
+#undef NET_ARRAY
+    return n;
+}
+
+// 创建全部参数为 0 的网络, 结构不合法或内存不足时返回 NULL
+Network* networkCreate(int size, int inputPlanes, int channels, int blocks) {
+    if (size < 2 || size > BOARD_SIZE || inputPlanes < 1 || inputPlanes > NET_MAX_CHANNELS ||
+        channels < NET_CHANNEL_ALIGN || channels > NET_MAX_CHANNELS || channels % NET_CHANNEL_ALIGN != 0 ||
+        blocks < 0 || blocks > NET_MAX_BLOCKS) {
+        return NULL;
+    }
+    Network* net = (Network*)calloc(1, sizeof(Network));
+    if (net == NULL) return NULL;
+    net->size = size;
+    net->inputPlanes = inputPlanes;
+    net->channels = channels;
+    net->blocks = blocks;
+    net->kernel = networkBestKernel();
+    net->quantized = 0;
+
+    int points = size * size;
+    int ok = initConv(&net->input, inputPlanes, channels, 9);
+    net->trunk = (NetConv*)calloc(blocks * 2 + 1, sizeof(NetConv));
+    ok = ok && net->trunk != NULL;
+    for (int i = 0; ok && i < blocks * 2; i++) {
+        ok = initConv(&net->trunk[i], channels, channels, 9);
+    }
+    ok = ok && initConv(&net->policyConv, channels, 2, 1) && initConv(&net->valueConv, channels, 1, 1);
+    net->policyWeight = (float*)calloc((size_t)2 * points * (points + 1), sizeof(float));
+    net->policyBias = (float*)calloc(points + 1, sizeof(float));
+    net->valueWeight1 = (float*)calloc((size_t)points * NET_VALUE_HIDDEN, sizeof(float));
+    net->valueBias1 = (float*)calloc(NET_VALUE_HIDDEN, sizeof(float));
+    net->valueWeight2 = (float*)calloc(NET_VALUE_HIDDEN, sizeof(float));
+    net->valueBias2 = (float*)calloc(1, sizeof(float));
+    ok = ok && net->policyWeight != NULL && net->policyBias != NULL && net->valueWeight1 != NULL &&
+        net->valueBias1 != NULL && net->valueWeight2 != NULL && net->valueBias2 != NULL;
+    if (!ok) {
+        networkDestroy(net);
+        return NULL;
+    }
+    return net;
+}
+
+void networkDestroy(Network* net) {
+    if (net == NULL) return;
+    freeConv(&net->input);
+    if (net->trunk != NULL) {
+        for (int i = 0; i < net->blocks * 2; i++) freeConv(&net->trunk[i]);
+        free(net->trunk);
+    }
+    freeConv(&net->policyConv);
+    freeConv(&net->valueConv);
+    free(net->policyWeight);
+    free(net->policyBias);
+    free(net->valueWeight1);
+    free(net->valueBias1);
+    free(net->valueWeight2);
+    free(net->valueBias2);
+    free(net);
+}
+
+static unsigned int nextRandom(unsigned int* state) {
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+// 在 [-limit, limit] 内均匀取值
+static void fillUniform(float* data, size_t count, float limit, unsigned int* rng) {
+    for (size_t i = 0; i < count; i++) {
+        data[i] = limit * ((nextRandom(rng) >> 8) * (2.0f / 16777216.0f) - 1.0f);
+    }
+}
+
+// 随机初始化(He 初始化), 只用于测试速度和各实现的一致性, 不会下棋
+void networkRandomize(Network* net, unsigned int seed) {
+    unsigned int rng = seed != 0 ? seed : 1;
+    int points = net->size * net->size;
+    fillUniform(net->input.weight, (size_t)9 * net->inputPlanes * net->channels, sqrtf(6.0f / (9 * net->inputPlanes)), &rng);
+    fillUniform(net->input.bias, net->channels, 0.1f, &rng);
+    for (int i = 0; i < net->blocks * 2; i++) {
+        float gain = (i % 2 == 1) ? NET_RESIDUAL_GAIN : 1.0f;
+        fillUniform(net->trunk[i].weight, (size_t)9 * net->channels * net->channels,
+            gain * sqrtf(6.0f / (9 * net->channels)), &rng);
+        fillUniform(net->trunk[i].bias, net->channels, 0.1f, &rng);
+    }
+    fillUniform(net->policyConv.weight, net->channels * 2, sqrtf(6.0f / net->channels), &rng);
+    fillUniform(net->policyConv.bias, 2, 0.1f, &rng);
+    fillUniform(net->policyWeight, (size_t)2 * points * (points + 1), sqrtf(3.0f / (2 * points)), &rng);
+    fillUniform(net->policyBias, points + 1, 0.1f, &rng);
+    fillUniform(net->valueConv.weight, net->channels, sqrtf(6.0f / net->channels), &rng);
+    fillUniform(net->valueConv.bias, 1, 0.1f, &rng);
+    fillUniform(net->valueWeight1, (size_t)points * NET_VALUE_HIDDEN, sqrtf(6.0f / points), &rng);
+    fillUniform(net->valueBias1, NET_VALUE_HIDDEN, 0.1f, &rng);
+    fillUniform(net->valueWeight2, NET_VALUE_HIDDEN, sqrtf(3.0f / NET_VALUE_HIDDEN), &rng);
+    fillUniform(net->valueBias2, 1, 0.1f, &rng);
+    if (net->quantized) networkQuantize(net, 1);
+}
+
+// 读权重文件: 7 个 int32 的文件头(NET_MAGIC、版本、路数、输入平面数、通道数、残差块数、价值头宽度),
+// 之后按 listArrays 的顺序是各层的 float32 参数(小端); 格式不对、输入平面数与 featuresEncode 不符
+// 或文件不完整时返回 NULL
+Network* networkLoad(const char* filename) {
+    FILE* fp = fopen(filename, "rb");
+    if (fp == NULL) return NULL;
+
+    int header[7];
+    Network* net = NULL;
+    if (fread(header, sizeof(int), 7, fp) == 7 && header[0] == NET_MAGIC && header[1] == NET_VERSION &&
+        header[3] == FEATURE_PLANES && header[6] == NET_VALUE_HIDDEN) {
+        net = networkCreate(header[2], header[3], header[4], header[5]);
+    }
+    if (net != NULL) {
+        int count = listArrays(net, NULL, NULL);
+        std::vector<float*> arrays(count);
+        std::vector<size_t> counts(count);
+        listArrays(net, arrays.data(), counts.data());
+        for (int i = 0; i < count; i++) {
+            if (fread(arrays[i], sizeof(float), counts[i], fp) != counts[i]) {
+                networkDestroy(net);
+                net = NULL;
+                break;
+            }
+        }
+    }
+    fclose(fp);
+    return net;
+}
+
+// 写权重文件, 格式见 networkLoad; 成功返回 1
+int networkSave(const Network* net, const char* filename) {
+    FILE* fp = fopen(filename, "wb");
+    if (fp == NULL) return 0;
+
+    int header[7] = { NET_MAGIC, NET_VERSION, net->size, net->inputPlanes, net->channels, net->blocks, NET_VALUE_HIDDEN };
+    int ok = fwrite(header, sizeof(int), 7, fp) == 7;
+    Network* writable = (Network*)net; // listArrays 只取指针, 不修改参数
+    int count = listArrays(writable, NULL, NULL);
+    std::vector<float*> arrays(count);
+    std::vector<size_t> counts(count);
+    listArrays(writable, arrays.data(), counts.data());
+    for (int i = 0; ok && i < count; i++) {
+        ok = fwrite(arrays[i], sizeof(float), counts[i], fp) == counts[i];
+    }
+    if (fclose(fp) != 0) ok = 0;
+    return ok;
+}
+
+// 编译进来的最快的实现
+int networkBestKernel() {
+#if defined(NET_HAVE_AVX512)
+    return NET_KERNEL_AVX512;
+#elif defined(NET_HAVE_AVX2)
+    return NET_KERNEL_AVX2;
+#else
+    return NET_KERNEL_SCALAR;
+#endif
+}
+
+// 选择主干卷积的实现, 没有编译进来的返回 0 且不改变
+int networkSetKernel(Network* net, int kernel) {
+    switch (kernel) {
+    case NET_KERNEL_SCALAR: break;
+#if defined(NET_HAVE_AVX2)
+    case NET_KERNEL_AVX2: break;
+#endif
+#if defined(NET_HAVE_AVX512)
+    case NET_KERNEL_AVX512: break;
+#endif
+    default: return 0;
+    }
+    net->kernel = kernel;
+    return 1;
+}
+
+const char* networkKernelName(int kernel) {
+    switch (kernel) {
+    case NET_KERNEL_SCALAR: return "scalar";
+    case NET_KERNEL_AVX2: return "avx2";
+    case NET_KERNEL_AVX512: return "avx512";
+    default: return "?";
+    }
+}
+
+// 把一层 3x3 卷积的权重按输出通道量化为 int8, 输入通道按 4 个一组排列
+static int quantizeConv(NetConv* conv) {
+    int groups = groupsOf(conv->in);
+    free(conv->qweight);
+    free(conv->qscale);
+    conv->qweight = (signed char*)calloc((size_t)conv->taps * groups * conv->out * 4, 1);
+    conv->qscale = (float*)calloc(conv->out, sizeof(float));
+    if (conv->qweight == NULL || conv->qscale == NULL) return 0;
+
+    for (int o = 0; o < conv->out; o++) {
+        float maxAbs = 0.0f;
+        for (int t = 0; t < conv->taps; t++) {
+            for (int c = 0; c < conv->in; c++) {
+                float w = fabsf(conv->weight[((size_t)t * conv->in + c) * conv->out + o]);
+                if (w > maxAbs) maxAbs = w;
+            }
+        }
+        float scale = maxAbs > 0.0f ? maxAbs / 127.0f : 1.0f;
+        conv->qscale[o] = scale;
+        for (int t = 0; t < conv->taps; t++) {
+            for (int c = 0; c < conv->in; c++) {
+                float w = conv->weight[((size_t)t * conv->in + c) * conv->out + o];
+                conv->qweight[(((size_t)t * groups + c / 4) * conv->out + o) * 4 + c % 4] = (signed char)lrintf(w / scale);
+            }
+        }
+    }
+    return 1;
+}
+
+// 打开或关闭主干的 int8 计算; 打开时按当前的 float 权重量化, 内存不足返回 0
+int networkQuantize(Network* net, int enable) {
+    net->quantized = 0;
+    if (!enable) return 1;
+    if (!quantizeConv(&net->input)) return 0;
+    for (int i = 0; i < net->blocks * 2; i++) {
+        if (!quantizeConv(&net->trunk[i])) return 0;
+    }
+    net->quantized = 1;
+    return 1;
+}
+
+// ---------------- 主干卷积 ----------------
+
+// 3x3 卷积九个邻点在补边棋盘上的偏移
+static void tapOffsets(int n, int taps, int* offsets) {
+    if (taps == 1) {
+        offsets[0] = 0;
+        return;
+    }
+    int k = 0;
+    for (int dx = -1; dx <= 1; dx++) {
+        for (int dy = -1; dy <= 1; dy++) {
+            offsets[k++] = dx * (n + 2) + dy;
+        }
+    }
+}
+
+// 标量参考实现: out = relu(conv(in) + bias [+ residual])
+static void convScalar(const NetConv* conv, int n, const int* offsets, const float* in, float* out, const float* residual) {
+    int stride = n + 2;
+    float acc[NET_MAX_CHANNELS];
+    for (int x = 0; x < n; x++) {
+        for (int y = 0; y < n; y++) {
+            int p = (x + 1) * stride + y + 1;
+            for (int o = 0; o < conv->out; o++) acc[o] = conv->bias[o];
+            for (int t = 0; t < conv->taps; t++) {
+                const float* a = in + (size_t)(p + offsets[t]) * conv->in;
+                const float* w = conv->weight + (size_t)t * conv->in * conv->out;
+                for (int c = 0; c < conv->in; c++, w += conv->out) {
+                    for (int o = 0; o < conv->out; o++) acc[o] += a[c] * w[o];
+                }
+            }
+            float* dst = out + (size_t)p * conv->out;
+            const float* r = residual != NULL ? residual + (size_t)p * conv->out : NULL;
+            for (int o = 0; o < conv->out; o++) {
+                float v = acc[o] + (r != NULL ? r[o] : 0.0f);
+                dst[o] = v > 0.0f ? v : 0.0f;
+            }
+        }
+    }
+}
+
+// int8 标量参考实现, in 为量化后的输入(每点 groups * 4 字节), scale 为输入的缩放
+static void qconvScalar(const NetConv* conv, int n, const int* offsets, const unsigned char* in, float scale,
+    float* out, const float* residual) {
+    int stride = n + 2;
+    int groups = groupsOf(conv->in);
+    int acc[NET_MAX_CHANNELS];
+    for (int x = 0; x < n; x++) {
+        for (int y = 0; y < n; y++) {
+            int p = (x + 1) * stride + y + 1;
+            for (int o = 0; o < conv->out; o++) acc[o] = 0;
+            for (int t = 0; t < conv->taps; t++) {
+                const unsigned char* a = in + (size_t)(p + offsets[t]) * groups * 4;
+                const signed char* w = conv->qweight + (size_t)t * groups * conv->out * 4;
+                for (int g = 0; g < groups; g++, a += 4, w += conv->out * 4) {
+                    for (int o = 0; o < conv->out; o++) {
+                        acc[o] += a[0] * w[o * 4] + a[1] * w[o * 4 + 1] + a[2] * w[o * 4 + 2] + a[3] * w[o * 4 + 3];
+                    }
+                }
+            }
+            float* dst = out + (size_t)p * conv->out;
+            const float* r = residual != NULL ? residual + (size_t)p * conv->out : NULL;
+            for (int o = 0; o < conv->out; o++) {
+                float v = acc[o] * scale * conv->qscale[o] + conv->bias[o] + (r != NULL ? r[o] : 0.0f);
+                dst[o] = v > 0.0f ? v : 0.0f;
+            }
+        }
+    }
+}
+
+#if defined(NET_HAVE_AVX2)
+// AVX2: 一次算同一行上 P 个相邻点的 V*8 个输出通道, 累加器留在寄存器里,
+// 每个权重向量读一次用于 P 个点, 每个输入广播一次用于 V 个向量
+template <int P, int V>
+static void convTileAvx2(const NetConv* conv, const int* offsets, const float* in, float* out,
+    const float* residual, int p, int o0) {
+    __m256 acc[P][V];
+    for (int j = 0; j < P; j++) {
+        for (int v = 0; v < V; v++) acc[j][v] = _mm256_loadu_ps(conv->bias + o0 + v * 8);
+    }
+    for (int t = 0; t < conv->taps; t++) {
+        const float* a = in + (size_t)(p + offsets[t]) * conv->in;
+        const float* w = conv->weight + (size_t)t * conv->in * conv->out + o0;
+        for (int c = 0; c < conv->in; c++, w += conv->out) {
+            __m256 wv[V];
+            for (int v = 0; v < V; v++) wv[v] = _mm256_loadu_ps(w + v * 8);
+            for (int j = 0; j < P; j++) {
+                __m256 s = _mm256_set1_ps(a[j * conv->in + c]);
+                for (int v = 0; v < V; v++) acc[j][v] = _mm256_fmadd_ps(s, wv[v], acc[j][v]);
+            }
+        }
+    }
+    for (int j = 0; j < P; j++) {
+        float* dst = out + (size_t)(p + j) * conv->out + o0;
+        const float* r = residual != NULL ? residual + (size_t)(p + j) * conv->out + o0 : NULL;
+        for (int v = 0; v < V; v++) {
+            __m256 s = acc[j][v];
+            if (r != NULL) s = _mm256_add_ps(s, _mm256_loadu_ps(r + v * 8));
+            _mm256_storeu_ps(dst + v * 8, _mm256_max_ps(s, _mm256_setzero_ps()));
+        }
+    }
+}
+
+template <int V>
+static void convRowsAvx2(const NetConv* conv, int n, const int* offsets, const float* in, float* out,
+    const float* residual, int o0) {
+    for (int x = 0; x < n; x++) {
+        int p = (x + 1) * (n + 2) + 1;
+        int y = 0;
+        for (; y + 6 <= n; y += 6) convTileAvx2<6, V>(conv, offsets, in, out, residual, p + y, o0);
+        for (; y < n; y++) convTileAvx2<1, V>(conv, offsets, in, out, residual, p + y, o0);
+    }
+}
+
+static void convAvx2(const NetConv* conv, int n, const int* offsets, const float* in, float* out, const float* residual) {
+    // 6 个点 x 16 个通道: 12 个累加器加 2 个权重和 1 个广播, 正好放进 AVX2 的 16 个寄存器
+    for (int o0 = 0; o0 < conv->out; o0 += 16) convRowsAvx2<2>(conv, n, offsets, in, out, residual, o0);
+}
+
+// u8 x s8 的四元点积累加到 32 位
+static inline __m256i dotAvx2(__m256i acc, __m256i a, __m256i w) {
+#if defined(__AVX512VNNI__) && defined(__AVX512VL__)
+    return _mm256_dpbusd_epi32(acc, a, w);
+#else
+    __m256i pairs = _mm256_maddubs_epi16(a, w);
+    return _mm256_add_epi32(acc, _mm256_madd_epi16(pairs, _mm256_set1_epi16(1)));
+#endif
+}
+
+template <int P, int V>
+static void qconvTileAvx2(const NetConv* conv, const int* offsets, const unsigned char* in, float scale,
+    float* out, const float* residual, int p, int o0) {
+    int groups = groupsOf(conv->in);
+    __m256i acc[P][V];
+    for (int j = 0; j < P; j++) {
+        for (int v = 0; v < V; v++) acc[j][v] = _mm256_setzero_si256();
+    }
+    for (int t = 0; t < conv->taps; t++) {
+        const unsigned char* a = in + (size_t)(p + offsets[t]) * groups * 4;
+        const signed char* w = conv->qweight + ((size_t)t * groups * conv->out + o0) * 4;
+        for (int g = 0; g < groups; g++, w += conv->out * 4) {
+            int four[P];
+            int any = 0;
+            for (int j = 0; j < P; j++) {
+                memcpy(&four[j], a + ((size_t)j * groups + g) * 4, 4);
+                any |= four[j];
+            }
+            if (any == 0) continue; // ReLU 之后很多通道为 0
+            __m256i wv[V];
+            for (int v = 0; v < V; v++) wv[v] = _mm256_loadu_si256((const __m256i*)(w + v * 32));
+            for (int j = 0; j < P; j++) {
+                __m256i s = _mm256_set1_epi32(four[j]);
+                for (int v = 0; v < V; v++) acc[j][v] = dotAvx2(acc[j][v], s, wv[v]);
+            }
+        }
+    }
+    __m256 inScale = _mm256_set1_ps(scale);
+    for (int j = 0; j < P; j++) {
+        float* dst = out + (size_t)(p + j) * conv->out + o0;
+        const float* r = residual != NULL ? residual + (size_t)(p + j) * conv->out + o0 : NULL;
+        for (int v = 0; v < V; v++) {
+            __m256 k = _mm256_mul_ps(inScale, _mm256_loadu_ps(conv->qscale + o0 + v * 8));
+            __m256 s = _mm256_fmadd_ps(_mm256_cvtepi32_ps(acc[j][v]), k, _mm256_loadu_ps(conv->bias + o0 + v * 8));
+            if (r != NULL) s = _mm256_add_ps(s, _mm256_loadu_ps(r + v * 8));
+            _mm256_storeu_ps(dst + v * 8, _mm256_max_ps(s, _mm256_setzero_ps()));
+        }
+    }
+}
+
+template <int V>
+static void qconvRowsAvx2(const NetConv* conv, int n, const int* offsets, const unsigned char* in, float scale,
+    float* out, const float* residual, int o0) {
+    for (int x = 0; x < n; x++) {
+        int p = (x + 1) * (n + 2) + 1;
+        int y = 0;
+        for (; y + 6 <= n; y += 6) qconvTileAvx2<6, V>(conv, offsets, in, scale, out, residual, p + y, o0);
+        for (; y < n; y++) qconvTileAvx2<1, V>(conv, offsets, in, scale, out, residual, p + y, o0);
+    }
+}
+
+static void qconvAvx2(const NetConv* conv, int n, const int* offsets, const unsigned char* in, float scale,
+    float* out, const float* residual) {
+    for (int o0 = 0; o0 < conv->out; o0 += 16) qconvRowsAvx2<2>(conv, n, offsets, in, scale, out, residual, o0);
+}
+#endif
+
+#if defined(NET_HAVE_AVX512)
+// AVX-512: 一次算 P 个相邻点的 V*16 个输出通道, 做法同 AVX2; 6 个点 x 64 个通道用 24 个累加器
+template <int P, int V>
+static void convTileAvx512(const NetConv* conv, const int* offsets, const float* in, float* out,
+    const float* residual, int p, int o0) {
+    __m512 acc[P][V];
+    for (int j = 0; j < P; j++) {
+        for (int v = 0; v < V; v++) acc[j][v] = _mm512_loadu_ps(conv->bias + o0 + v * 16);
+    }
+    for (int t = 0; t < conv->taps; t++) {
+        const float* a = in + (size_t)(p + offsets[t]) * conv->in;
+        const float* w = conv->weight + (size_t)t * conv->in * conv->out + o0;
+        for (int c = 0; c < conv->in; c++, w += conv->out) {
+            __m512 wv[V];
+            for (int v = 0; v < V; v++) wv[v] = _mm512_loadu_ps(w + v * 16);
+            for (int j = 0; j < P; j++) {
+                __m512 s = _mm512_set1_ps(a[j * conv->in + c]);
+                for (int v = 0; v < V; v++) acc[j][v] = _mm512_fmadd_ps(s, wv[v], acc[j][v]);
+            }
+        }
+    }
+    for (int j = 0; j < P; j++) {
+        float* dst = out + (size_t)(p + j) * conv->out + o0;
+        const float* r = residual != NULL ? residual + (size_t)(p + j) * conv->out + o0 : NULL;
+        for (int v = 0; v < V; v++) {
+            __m512 s = acc[j][v];
+            if (r != NULL) s = _mm512_add_ps(s, _mm512_loadu_ps(r + v * 16));
+            _mm512_storeu_ps(dst + v * 16, _mm512_max_ps(s, _mm512_setzero_ps()));
+        }
+    }
+}
+
+template <int V>
+static void convRowsAvx512(const NetConv* conv, int n, const int* offsets, const float* in, float* out,
+    const float* residual, int o0) {
+    for (int x = 0; x < n; x++) {
+        int p = (x + 1) * (n + 2) + 1;
+        int y = 0;
+        for (; y + 6 <= n; y += 6) convTileAvx512<6, V>(conv, offsets, in, out, residual, p + y, o0);
+        for (; y < n; y++) convTileAvx512<1, V>(conv, offsets, in, out, residual, p + y, o0);
+    }
+}
+
+static void convAvx512(const NetConv* conv, int n, const int* offsets, const float* in, float* out, const float* residual) {
+    int o0 = 0;
+    for (; o0 + 64 <= conv->out; o0 += 64) convRowsAvx512<4>(conv, n, offsets, in, out, residual, o0);
+    switch ((conv->out - o0) / 16) {
+    case 1: convRowsAvx512<1>(conv, n, offsets, in, out, residual, o0); break;
+    case 2: convRowsAvx512<2>(conv, n, offsets, in, out, residual, o0); break;
+    case 3: convRowsAvx512<3>(conv, n, offsets, in, out, residual, o0); break;
+    default: break;
+    }
+}
+
+static inline __m512i dotAvx512(__m512i acc, __m512i a, __m512i w) {
+#if defined(__AVX512VNNI__)
+    return _mm512_dpbusd_epi32(acc, a, w);
+#else
+    __m512i pairs = _mm512_maddubs_epi16(a, w);
+    return _mm512_add_epi32(acc, _mm512_madd_epi16(pairs, _mm512_set1_epi16(1)));
+#endif
+}
+
+template <int P, int V>
+static void qconvTileAvx512(const NetConv* conv, const int* offsets, const unsigned char* in, float scale,
+    float* out, const float* residual, int p, int o0) {
+    int groups = groupsOf(conv->in);
+    __m512i acc[P][V];
+    for (int j = 0; j < P; j++) {
+        for (int v = 0; v < V; v++) acc[j][v] = _mm512_setzero_si512();
+    }
+    for (int t = 0; t < conv->taps; t++) {
+        const unsigned char* a = in + (size_t)(p + offsets[t]) * groups * 4;
+        const signed char* w = conv->qweight + ((size_t)t * groups * conv->out + o0) * 4;
+        for (int g = 0; g < groups; g++, w += conv->out * 4) {
+            int four[P];
+            int any = 0;
+            for (int j = 0; j < P; j++) {
+                memcpy(&four[j], a + ((size_t)j * groups + g) * 4, 4);
+                any |= four[j];
+            }
+            if (any == 0) continue;
+            __m512i wv[V];
+            for (int v = 0; v < V; v++) wv[v] = _mm512_loadu_si512((const void*)(w + v * 64));
+            for (int j = 0; j < P; j++) {
+                __m512i s = _mm512_set1_epi32(four[j]);
+                for (int v = 0; v < V; v++) acc[j][v] = dotAvx512(acc[j][v], s, wv[v]);
+            }
+        }
+    }
+    __m512 inScale = _mm512_set1_ps(scale);
+    for (int j = 0; j < P; j++) {
+        float* dst = out + (size_t)(p + j) * conv->out + o0;
+        const float* r = residual != NULL ? residual + (size_t)(p + j) * conv->out + o0 : NULL;
+        for (int v = 0; v < V; v++) {
+            __m512 k = _mm512_mul_ps(inScale, _mm512_loadu_ps(conv->qscale + o0 + v * 16));
+            __m512 s = _mm512_fmadd_ps(_mm512_cvtepi32_ps(acc[j][v]), k, _mm512_loadu_ps(conv->bias + o0 + v * 16));
+            if (r != NULL) s = _mm512_add_ps(s, _mm512_loadu_ps(r + v * 16));
+            _mm512_storeu_ps(dst + v * 16, _mm512_max_ps(s, _mm512_setzero_ps()));
+        }
+    }
+}
+
+template <int V>
+static void qconvRowsAvx512(const NetConv* conv, int n, const int* offsets, const unsigned char* in, float scale,
+    float* out, const float* residual, int o0) {
+    for (int x = 0; x < n; x++) {
+        int p = (x + 1) * (n + 2) + 1;
+        int y = 0;
+        for (; y + 6 <= n; y += 6) qconvTileAvx512<6, V>(conv, offsets, in, scale, out, residual, p + y, o0);
+        for (; y < n; y++) qconvTileAvx512<1, V>(conv, offsets, in, scale, out, residual, p + y, o0);
+    }
+}
+
+static void qconvAvx512(const NetConv* conv, int n, const int* offsets, const unsigned char* in, float scale,
+    float* out, const float* residual) {
+    int o0 = 0;
+    for (; o0 + 64 <= conv->out; o0 += 64) qconvRowsAvx512<4>(conv, n, offsets, in, scale, out, residual, o0);
+    switch ((conv->out - o0) / 16) {
+    case 1: qconvRowsAvx512<1>(conv, n, offsets, in, scale, out, residual, o0); break;
+    case 2: qconvRowsAvx512<2>(conv, n, offsets, in, scale, out, residual, o0); break;
+    case 3: qconvRowsAvx512<3>(conv, n, offsets, in, scale, out, residual, o0); break;
+    default: break;
+    }
+}
+#endif
+
+// 把一个局面的非负特征图量化为 u8(每点 channels 向上取整到 4 个字节, 多出的为 0), 返回缩放
+static float quantizeActivations(int n, int channels, const float* in, unsigned char* out) {
+    int stride = n + 2;
+    int width = groupsOf(channels) * 4;
+    float maxValue = 0.0f;
+    for (int x = 0; x < n; x++) {
+        const float* row = in + (size_t)((x + 1) * stride + 1) * channels;
+        for (int i = 0; i < n * channels; i++) {
+            if (row[i] > maxValue) maxValue = row[i];
+        }
+    }
+    float scale = maxValue > 0.0f ? maxValue / 127.0f : 1.0f;
+    float inverse = 1.0f / scale;
+    for (int x = 0; x < n; x++) {
+        for (int y = 0; y < n; y++) {
+            int p = (x + 1) * stride + y + 1;
+            const float* src = in + (size_t)p * channels;
+            unsigned char* dst = out + (size_t)p * width;
+            for (int c = 0; c < channels; c++) dst[c] = (unsigned char)(src[c] * inverse + 0.5f);
+            for (int c = channels; c < width; c++) dst[c] = 0;
+        }
+    }
+    return scale;
+}
+
+// 按网络设置的实现计算一层主干卷积(包括 ReLU 和残差)
+static void runConv(const Network* net, const NetConv* conv, const float* in, unsigned char* qin, float* out,
+    const float* residual) {
+    int n = net->size;
+    int offsets[9];
+    tapOffsets(n, conv->taps, offsets);
+
+    if (net->quantized && conv->qweight != NULL) {
+        float scale = quantizeActivations(n, conv->in, in, qin);
+        switch (net->kernel) {
+#if defined(NET_HAVE_AVX512)
+        case NET_KERNEL_AVX512: qconvAvx512(conv, n, offsets, qin, scale, out, residual); return;
+#endif
+#if defined(NET_HAVE_AVX2)
+        case NET_KERNEL_AVX2: qconvAvx2(conv, n, offsets, qin, scale, out, residual); return;
+#endif
+        default: qconvScalar(conv, n, offsets, qin, scale, out, residual); return;
+        }
+    }
+    switch (net->kernel) {
+#if defined(NET_HAVE_AVX512)
+    case NET_KERNEL_AVX512: convAvx512(conv, n, offsets, in, out, residual); return;
+#endif
+#if defined(NET_HAVE_AVX2)
+    case NET_KERNEL_AVX2: convAvx2(conv, n, offsets, in, out, residual); return;
+#endif
+    default: convScalar(conv, n, offsets, in, out, residual); return;
+    }
+}
+
+// ---------------- 输出头 ----------------
+
+// 1x1 卷积到 outs 个平面并 ReLU, 结果按 [平面][x * n + y] 存放
+static void headConv(const NetConv* conv, int n, const float* in, float* out) {
+    int stride = n + 2;
+    for (int x = 0; x < n; x++) {
+        for (int y = 0; y < n; y++) {
+            const float* a = in + (size_t)((x + 1) * stride + y + 1) * conv->in;
+            for (int o = 0; o < conv->out; o++) {
+                float s = conv->bias[o];
+                for (int c = 0; c < conv->in; c++) s += a[c] * conv->weight[c * conv->out + o];
+                out[o * n * n + x * n + y] = s > 0.0f ? s : 0.0f;
+            }
+        }
+    }
+}
+
+// 全连接层 out[j] = bias[j] + sum_i in[i] * weight[i][j]
+static void dense(const float* in, int ins, const float* weight, const float* bias, int outs, float* out) {
+    for (int j = 0; j < outs; j++) out[j] = bias[j];
+    for (int i = 0; i < ins; i++) {
+        float a = in[i];
+        if (a == 0.0f) continue;
+        const float* w = weight + (size_t)i * outs;
+        for (int j = 0; j < outs; j++) out[j] += a * w[j];
+    }
+}
+
+static void policyHead(const Network* net, const float* act, float* policy) {
+    int points = net->size * net->size;
+    float features[2 * MAX_POINTS];
+    headConv(&net->policyConv, net->size, act, features);
+    dense(features, 2 * points, net->policyWeight, net->policyBias, points + 1, policy);
+
+    float maxLogit = policy[0];
+    for (int i = 1; i <= points; i++) {
+        if (policy[i] > maxLogit) maxLogit = policy[i];
+    }
+    float sum = 0.0f;
+    for (int i = 0; i <= points; i++) {
+        policy[i] = expf(policy[i] - maxLogit);
+        sum += policy[i];
+    }
+    for (int i = 0; i <= points; i++) policy[i] /= sum;
+}
+
+static float valueHead(const Network* net, const float* act) {
+    int points = net->size * net->size;
+    float features[MAX_POINTS];
+    float hidden[NET_VALUE_HIDDEN];
+    headConv(&net->valueConv, net->size, act, features);
+    dense(features, points, net->valueWeight1, net->valueBias1, NET_VALUE_HIDDEN, hidden);
+    float s = net->valueBias2[0];
+    for (int i = 0; i < NET_VALUE_HIDDEN; i++) {
+        if (hidden[i] > 0.0f) s += hidden[i] * net->valueWeight2[i];
+    }
+    return tanhf(s);
+}
+
+// ---------------- 整个网络 ----------------
+
+static void prepareWorkspace(const Network* net, int batch) {
+    NetWorkspace* ws = &workspace;
+    if (ws->size == net->size && ws->inputPlanes == net->inputPlanes && ws->channels == net->channels && ws->batch >= batch) {
+        return;
+    }
+    size_t padded = (size_t)(net->size + 2) * (net->size + 2);
+    ws->size = net->size;
+    ws->inputPlanes = net->inputPlanes;
+    ws->channels = net->channels;
+    ws->batch = batch;
+    ws->input.assign(batch * padded * net->inputPlanes, 0.0f);
+    ws->act.assign(batch * 3 * padded * net->channels, 0.0f);
+    ws->qinput.assign(batch * padded * groupsOf(net->inputPlanes) * 4, 0);
+    ws->qact.assign(batch * padded * net->channels, 0);
+}
+
+// 计算一批局面: input 为 batch 个局面的特征平面([局面][平面][x * size + y]),
+// policy 输出每个局面 size*size+1 个概率(最后一项为停一手), value 输出走子方的胜负估计(-1~1);
+// policy 为 NULL 时不计算策略头
+void networkEvaluate(const Network* net, const float* input, int batch, float* policy, float* value) {
+    if (batch <= 0) return;
+    prepareWorkspace(net, batch);
+    NetWorkspace* ws = &workspace;
+
+    int n = net->size;
+    int points = n * n;
+    size_t padded = (size_t)(n + 2) * (n + 2);
+    size_t plane = padded * net->channels;
+    size_t inputSize = padded * net->inputPlanes;
+    size_t qinputSize = padded * groupsOf(net->inputPlanes) * 4;
+
+    // 特征平面转成补边的 [点][平面]
+    for (int b = 0; b < batch; b++) {
+        const float* src = input + (size_t)b * net->inputPlanes * points;
+        float* dst = ws->input.data() + b * inputSize;
+        for (int k = 0; k < net->inputPlanes; k++) {
+            for (int x = 0; x < n; x++) {
+                for (int y = 0; y < n; y++) {
+                    dst[(size_t)((x + 1) * (n + 2) + y + 1) * net->inputPlanes + k] = src[k * points + x * n + y];
+                }
+            }
+        }
+    }
+
+    // 逐层处理整批局面; 每个局面三块特征图 0: 残差块输入/输出 1: 块内中间层 2: 块输出
+    for (int b = 0; b < batch; b++) {
+        runConv(net, &net->input, ws->input.data() + b * inputSize, ws->qinput.data() + b * qinputSize,
+            ws->act.data() + b * 3 * plane, NULL);
+    }
+    for (int k = 0; k < net->blocks; k++) {
+        for (int b = 0; b < batch; b++) {
+            float* act = ws->act.data() + b * 3 * plane;
+            runConv(net, &net->trunk[2 * k], act, ws->qact.data() + b * plane, act + plane, NULL);
+        }
+        for (int b = 0; b < batch; b++) {
+            float* act = ws->act.data() + b * 3 * plane;
+            runConv(net, &net->trunk[2 * k + 1], act + plane, ws->qact.data() + b * plane, act + 2 * plane, act);
+            memcpy(act, act + 2 * plane, plane * sizeof(float));
+        }
+    }
+
+    for (int b = 0; b < batch; b++) {
+        const float* act = ws->act.data() + b * 3 * plane;
+        if (policy != NULL) policyHead(net, act, policy + (size_t)b * (points + 1));
+        value[b] = valueHead(net, act);
+    }
+}
+
+// 计算单个局面, recent 为最近几手(见 featuresEncode, 可为 NULL); policy(可为 NULL)按 x * size + y 排列, 最后一项为停一手
+void networkEvaluateState(const Network* net, const GameState* gs, const short* recent, float* policy, float* value) {
+    float planes[FEATURE_PLANES * MAX_POINTS];
+    featuresEncode(gs, recent, 0, planes);
+    networkEvaluate(net, planes, 1, policy, value);
+}
\ No newline at end of file
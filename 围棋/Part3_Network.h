@@ -0,0 +1,69 @@
+/*
+ * 围棋游戏系统 - Part 3: 策略价值网络
+ * 负责人: 2518801370 李卓洵
+ * 包含: 在 CPU 上计算的残差卷积网络(输入卷积 + 若干残差块 + 策略头和价值头), 权重文件的读写
+ * 说明: 不依赖 EasyX; 主干卷积有标量、AVX2、AVX-512 三种实现, 另可把主干权重量化为 int8;
+ *       各实现的结果只差浮点舍入(int8 另有量化误差), go_nnbench 比较结果和每秒局面数
+ *       批量计算时逐层处理整批局面, 一层的权重在缓存中被整批复用
+ */
+
+#ifndef PART3_NETWORK_H
+#define PART3_NETWORK_H
+
+#include "Part3_Features.h"
+
+#define NET_MAGIC 0x4E4E4F47   // 权重文件开头的 "GONN"
+#define NET_VERSION 2           // 2: 输入改为 featuresEncode 的 FEATURE_PLANES 个平面
+#define NET_VALUE_HIDDEN 64    // 价值头全连接层的宽度
+#define NET_CHANNEL_ALIGN 16   // 主干通道数须为其倍数(一个 AVX-512 寄存器的浮点数个数)
+#define NET_MAX_CHANNELS 512
+#define NET_MAX_BLOCKS 64
+
+// 主干卷积的实现
+#define NET_KERNEL_SCALAR 0
+#define NET_KERNEL_AVX2 1
+#define NET_KERNEL_AVX512 2
+
+// 卷积层(批归一化已并入偏置), 权重按 [taps][in][out] 存放, 输出通道连续便于向量化
+typedef struct {
+    int in;               // 输入通道数
+    int out;              // 输出通道数
+    int taps;             // 9 为 3x3 卷积, 1 为 1x1 卷积
+    float* weight;
+    float* bias;          // [out]
+    signed char* qweight; // int8 权重 [taps][in/4 向上取整][out][4], 未量化时为 NULL
+    float* qscale;        // [out] 各输出通道 int8 权重的缩放
+} NetConv;
+
+typedef struct {
+    int size;          // 棋盘路数
+    int inputPlanes;
+    int channels;      // 主干通道数
+    int blocks;        // 残差块数
+    int kernel;        // 主干卷积用的实现 NET_KERNEL_*
+    int quantized;     // 非 0 时主干卷积用 int8 计算
+    NetConv input;     // inputPlanes -> channels, 3x3
+    NetConv* trunk;    // 每个残差块两层 channels -> channels, 3x3
+    NetConv policyConv; // channels -> 2, 1x1
+    float* policyWeight; // [2 * N * N][N * N + 1]
+    float* policyBias;   // [N * N + 1], 最后一项为停一手
+    NetConv valueConv;   // channels -> 1, 1x1
+    float* valueWeight1; // [N * N][NET_VALUE_HIDDEN]
+    float* valueBias1;
+    float* valueWeight2; // [NET_VALUE_HIDDEN]
+    float* valueBias2;   // [1]
+} Network;
+
+Network* networkCreate(int size, int inputPlanes, int channels, int blocks);
+void networkDestroy(Network* net);
+void networkRandomize(Network* net, unsigned int seed);
+Network* networkLoad(const char* filename);
+int networkSave(const Network* net, const char* filename);
+int networkBestKernel();
+int networkSetKernel(Network* net, int kernel);
+const char* networkKernelName(int kernel);
+int networkQuantize(Network* net, int enable);
+void networkEvaluate(const Network* net, const float* input, int batch, float* policy, float* value);
+void networkEvaluateState(const Network* net, const GameState* gs, const short* recent, float* policy, float* value);
+
+#endif // PART3_NETWORK_H
\ No newline at end of file
@@ -0,0 +1,176 @@
+/*
+ * 围棋游戏系统 - Part 3: 策略价值网络性能测试程序
+ * 负责人: 2518801370 李卓洵
+ * 用法: go_nnbench [--weights 文件] [--size 路数] [--channels 通道数] [--blocks 残差块数]
+ *                  [--ms 每项毫秒数] [--max-batch 批大小上限] [--save 文件]
+ * 没有给出权重文件时用随机初始化的网络; 先在几个随机局面上比较各实现(标量/AVX2/AVX-512, float/int8)
+ * 与标量 float 的最大误差, 再对每种实现和批大小 1, 2, 4, ... 打印每秒计算的局面数;
+ * float 实现与标量的误差超出舍入范围时以 1 退出
+ */
+
+#include "Part3_Network.h"
+#include <math.h>
+#include <chrono>
+#include <vector>
+
+#define BENCH_POSITIONS 8
+#define BENCH_FLOAT_TOLERANCE 1e-3f // float 各实现间只差舍入
+
+// 在空棋盘上双方随机落 moves 手得到测试局面(带棋谱, 编码时有最近几手)
+static void randomPosition(Position* pos, int size, int moves, unsigned int* rng) {
+    posInit(pos, size);
+    for (int m = 0; m < moves; m++) {
+        for (int tries = 0; tries < 50; tries++) {
+            *rng = *rng * 1103515245u + 12345u;
+            int p = (int)((*rng >> 8) % (unsigned int)(size * size));
+            if (posMakeMove(pos, p / size, p % size)) break;
+        }
+    }
+}
+
+// 用当前设置计算 inputs 中的全部局面, 与参考结果比较, 返回策略和价值的最大误差
+static void compareWith(const Network* net, const std::vector<float>& inputs, const std::vector<float>& refPolicy,
+    const std::vector<float>& refValue, float* policyError, float* valueError) {
+    int outs = net->size * net->size + 1;
+    std::vector<float> policy(BENCH_POSITIONS * outs);
+    std::vector<float> value(BENCH_POSITIONS);
+    networkEvaluate(net, inputs.data(), BENCH_POSITIONS, policy.data(), value.data());
+    *policyError = 0.0f;
+    *valueError = 0.0f;
+    for (size_t i = 0; i < policy.size(); i++) {
+        float d = fabsf(policy[i] - refPolicy[i]);
+        if (d > *policyError) *policyError = d;
+    }
+    for (int b = 0; b < BENCH_POSITIONS; b++) {
+        float d = fabsf(value[b] - refValue[b]);
+        if (d > *valueError) *valueError = d;
+    }
+}
+
+// 按批大小 batch 反复计算至少 ms 毫秒, 返回每秒局面数
+static double measure(const Network* net, const std::vector<float>& inputs, int batch, int ms) {
+    int points = net->size * net->size;
+    std::vector<float> batchInput((size_t)batch * FEATURE_PLANES * points);
+    for (int b = 0; b < batch; b++) {
+        memcpy(&batchInput[(size_t)b * FEATURE_PLANES * points],
+            &inputs[(size_t)(b % BENCH_POSITIONS) * FEATURE_PLANES * points], sizeof(float) * FEATURE_PLANES * points);
+    }
+    std::vector<float> policy((size_t)batch * (points + 1));
+    std::vector<float> value(batch);
+
+    networkEvaluate(net, batchInput.data(), batch, policy.data(), value.data()); // 预热并分配中间结果
+    long long evals = 0;
+    double elapsedMs = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    while (evals == 0 || elapsedMs < ms) {
+        networkEvaluate(net, batchInput.data(), batch, policy.data(), value.data());
+        evals += batch;
+        elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+    return evals / elapsedMs * 1000.0;
+}
+
+int main(int argc, char* argv[]) {
+    const char* weights = NULL;
+    const char* saveFile = NULL;
+    int size = BOARD_SIZE;
+    int channels = 64;
+    int blocks = 6;
+    int ms = 300;
+    int maxBatch = 32;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--weights") == 0 && i + 1 < argc) weights = argv[++i];
+        else if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) size = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--channels") == 0 && i + 1 < argc) channels = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--blocks") == 0 && i + 1 < argc) blocks = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--ms") == 0 && i + 1 < argc) ms = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--max-batch") == 0 && i + 1 < argc) maxBatch = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--save") == 0 && i + 1 < argc) saveFile = argv[++i];
+        else {
+            printf("usage: go_nnbench [--weights FILE] [--size N] [--channels C] [--blocks B] [--ms MS] [--max-batch N] [--save FILE]\n");
+            return 1;
+        }
+    }
+
+    Network* net = NULL;
+    if (weights != NULL) {
+        net = networkLoad(weights);
+        if (net == NULL) {
+            printf("cannot load %s\n", weights);
+            return 1;
+        }
+    }
+    else {
+        net = networkCreate(size, FEATURE_PLANES, channels, blocks);
+        if (net == NULL) {
+            printf("bad network shape: size %d, channels %d (multiple of %d), blocks %d\n",
+                size, channels, NET_CHANNEL_ALIGN, blocks);
+            return 1;
+        }
+        networkRandomize(net, 12345u);
+    }
+    if (saveFile != NULL && !networkSave(net, saveFile)) {
+        printf("cannot save %s\n", saveFile);
+        return 1;
+    }
+    printf("network %dx%d, %d planes, %d channels, %d blocks, best kernel %s\n", net->size, net->size,
+        net->inputPlanes, net->channels, net->blocks, networkKernelName(networkBestKernel()));
+
+    // 测试局面: 从空棋盘到中盘
+    int points = net->size * net->size;
+    std::vector<float> inputs((size_t)BENCH_POSITIONS * FEATURE_PLANES * points);
+    unsigned int rng = 2024u;
+    for (int b = 0; b < BENCH_POSITIONS; b++) {
+        static Position pos;
+        short recent[FEATURE_HISTORY];
+        randomPosition(&pos, net->size, b * points / (2 * BENCH_POSITIONS), &rng);
+        featuresRecentMoves(&pos, recent);
+        featuresEncode(&pos.state, recent, 0, &inputs[(size_t)b * FEATURE_PLANES * points]);
+    }
+
+    // 参考结果: 标量 float
+    std::vector<float> refPolicy((size_t)BENCH_POSITIONS * (points + 1));
+    std::vector<float> refValue(BENCH_POSITIONS);
+    networkSetKernel(net, NET_KERNEL_SCALAR);
+    networkQuantize(net, 0);
+    networkEvaluate(net, inputs.data(), BENCH_POSITIONS, refPolicy.data(), refValue.data());
+
+    int kernels[3];
+    int kernelCount = 0;
+    for (int k = NET_KERNEL_SCALAR; k <= NET_KERNEL_AVX512; k++) {
+        if (networkSetKernel(net, k)) kernels[kernelCount++] = k;
+    }
+
+    int failed = 0;
+    printf("\n%-8s %-6s %14s %14s\n", "kernel", "type", "policy error", "value error");
+    for (int i = 0; i < kernelCount; i++) {
+        for (int q = 0; q <= 1; q++) {
+            networkSetKernel(net, kernels[i]);
+            networkQuantize(net, q);
+            float policyError, valueError;
+            compareWith(net, inputs, refPolicy, refValue, &policyError, &valueError);
+            int bad = !q && (policyError > BENCH_FLOAT_TOLERANCE || valueError > BENCH_FLOAT_TOLERANCE);
+            printf("%-8s %-6s %14.6f %14.6f%s\n", networkKernelName(kernels[i]), q ? "int8" : "float",
+                policyError, valueError, bad ? "  MISMATCH" : "");
+            failed |= bad;
+        }
+    }
+
+    printf("\n%-8s %-6s %6s %12s %12s\n", "kernel", "type", "batch", "evals/s", "us/eval");
+    for (int i = 0; i < kernelCount; i++) {
+        for (int q = 0; q <= 1; q++) {
+            networkSetKernel(net, kernels[i]);
+            networkQuantize(net, q);
+            for (int batch = 1; batch <= maxBatch; batch *= 2) {
+                double rate = measure(net, inputs, batch, ms);
+                printf("%-8s %-6s %6d %12.1f %12.1f\n", networkKernelName(kernels[i]), q ? "int8" : "float",
+                    batch, rate, 1e6 / rate);
+                fflush(stdout);
+            }
+        }
+    }
+
+    networkDestroy(net);
+    return failed ? 1 : 0;
+}
\ No newline at end of file
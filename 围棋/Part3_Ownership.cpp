@@ -0,0 +1,240 @@
+/*
+ * 围棋游戏系统 - Part 3: 蒙特卡洛形势判断实现
+ * 负责人: 2518801370 李卓洵
+ * 实现: 每个线程各做一批随机对局, 用位棋盘求终局归属并计数, 最后合并;
+ *       被围住的小块棋先用死活求解定下归属, 其余按棋串取平均判断死活, 再按归属数目
+ */
+
+#include "Part3_Ownership.h"
+#include "Part3_MCTS.h"
+#include "Part3_LifeDeath.h"
+#include "Part1_Bitboard.h"
+#include "Part1_BoardTables.h"
+#include <math.h>
+#include <thread>
+
+// 一个线程的计数
+typedef struct {
+    int black[MAX_POINTS];
+    int white[MAX_POINTS];
+    int count;
+    int blackWins;
+    double scoreSum;
+    double scoreSqSum;
+} OwnershipBatch;
+
+static inline int bitAt(const Bitboard* b, int p) {
+    return (int)((b->w[p >> 6] >> (p & 63)) & 1);
+}
+
+// 从 root 做 playouts 次随机对局, 计数写入 batch
+static void runBatch(const GameState* root, float komi, int playouts, unsigned int seed, OwnershipBatch* batch) {
+    int size = root->size;
+    unsigned int rng = seed != 0 ? seed : 1u;
+    memset(batch, 0, sizeof(OwnershipBatch));
+
+    for (int i = 0; i < playouts; i++) {
+        GameState gs = *root;
+        float score = mctsPlayout(&gs, komi, &rng);
+
+        BitPosition pos;
+        Bitboard black, white;
+        bitPosFromCells(&pos, gs.cells, size, gs.currentPlayer);
+        bitPosAreaOwner(&pos, &black, &white);
+        for (int x = 0; x < size; x++) {
+            for (int y = 0; y < size; y++) {
+                int p = x * BOARD_SIZE + y;
+                batch->black[p] += bitAt(&black, p);
+                batch->white[p] += bitAt(&white, p);
+            }
+        }
+
+        batch->count++;
+        batch->blackWins += score > 0;
+        batch->scoreSum += score;
+        batch->scoreSqSum += (double)score * score;
+    }
+}
+
+// 被围住的小块棋用死活求解的结论覆盖随机对局的归属:
+// 对方先走也杀不死的棋串和区域内的空点归己方(双活的空点不归任何一方), 自己先走也活不了的都归对方
+// 所有查询合计最多读 LIFE_ESTIMATE_NODES 个局面, 读不到的棋串仍按随机对局判断
+static void settleEnclosed(OwnershipMap* map, const GameState* gs) {
+    long long budget = LIFE_ESTIMATE_NODES;
+    GameState probe = *gs;
+    probe.koPoint = -1;
+    for (int x = 0; x < gs->size; x++) {
+        for (int y = 0; y < gs->size; y++) {
+            int head = PAD_INDEX(x, y);
+            int color = gs->cells[head];
+            if ((color != BLACK && color != WHITE) || gs->chainHead[head] != head) continue;
+
+            unsigned char region[MAX_POINTS];
+            if (lifeDeathRegion(gs, x, y, region) == 0) continue;
+            if (budget <= 0) return;
+            int opponent = color == BLACK ? WHITE : BLACK;
+            float own = color == BLACK ? 1.0f : -1.0f;
+            float stoneValue, emptyValue;
+            LifeDeathResult result;
+
+            probe.currentPlayer = opponent;
+            lifeDeathSolve(&probe, x, y, region, budget, &result);
+            budget -= result.nodes;
+            if (result.status == LIFE_ALIVE || result.status == LIFE_SEKI) {
+                stoneValue = own;
+                emptyValue = result.status == LIFE_ALIVE ? own : 0.0f;
+            }
+            else {
+                probe.currentPlayer = color;
+                lifeDeathSolve(&probe, x, y, region, budget, &result);
+                budget -= result.nodes;
+                if (result.status != LIFE_DEAD) continue;
+                stoneValue = emptyValue = -own;
+            }
+
+            for (int p = 0; p < MAX_POINTS; p++) {
+                if (region[p] && gs->board[p / BOARD_SIZE][p % BOARD_SIZE] == EMPTY) map->ownership[p] = emptyValue;
+            }
+            int q = head;
+            do {
+                map->ownership[boardTables.denseOf[q]] = stoneValue;
+                q = gs->chainNext[q];
+            } while (q != head);
+        }
+    }
+}
+
+// 由累计的样本算出归属、死子和目差
+static void summarize(OwnershipMap* map, const GameState* gs) {
+    int size = gs->size;
+    float inv = map->weight > 0 ? 1.0f / map->weight : 0.0f;
+
+    memset(map->ownership, 0, sizeof(map->ownership));
+    for (int x = 0; x < size; x++) {
+        for (int y = 0; y < size; y++) {
+            int p = x * BOARD_SIZE + y;
+            map->ownership[p] = (map->blackSum[p] - map->whiteSum[p]) * inv;
+        }
+    }
+    settleEnclosed(map, gs);
+
+    // 死子: 整串的平均归属偏向对方
+    memset(map->dead, 0, sizeof(map->dead));
+    map->deadBlack = 0;
+    map->deadWhite = 0;
+    for (int x = 0; x < size; x++) {
+        for (int y = 0; y < size; y++) {
+            int head = PAD_INDEX(x, y);
+            int color = gs->cells[head];
+            if (color != BLACK && color != WHITE) continue;
+            if (gs->chainHead[head] != head) continue;
+
+            float total = 0.0f;
+            int q = head;
+            do {
+                total += map->ownership[boardTables.denseOf[q]];
+                q = gs->chainNext[q];
+            } while (q != head);
+
+            float average = total / gs->chainSize[head];
+            if (color == WHITE) average = -average;
+            if (average > -OWNERSHIP_DEAD_LEVEL) continue;
+
+            q = head;
+            do {
+                map->dead[boardTables.denseOf[q]] = 1;
+                q = gs->chainNext[q];
+            } while (q != head);
+            if (color == BLACK) map->deadBlack += gs->chainSize[head];
+            else map->deadWhite += gs->chainSize[head];
+        }
+    }
+
+    // 按归属数目: 死子的点归属本来就偏向对方
+    int blackArea = 0, whiteArea = 0;
+    for (int x = 0; x < size; x++) {
+        for (int y = 0; y < size; y++) {
+            float o = map->ownership[x * BOARD_SIZE + y];
+            if (o >= OWNERSHIP_SETTLED) blackArea++;
+            else if (o <= -OWNERSHIP_SETTLED) whiteArea++;
+        }
+    }
+    map->score = (float)(blackArea - whiteArea) - map->komi;
+
+    float mean = map->scoreSum * inv;
+    float variance = map->scoreSqSum * inv - mean * mean;
+    map->scoreMean = mean;
+    map->scoreStdDev = variance > 0 ? sqrtf(variance) : 0.0f;
+    map->blackWinRate = map->weight > 0 ? map->blackWinSum * inv : 0.5f;
+}
+
+void ownershipReset(OwnershipMap* map) {
+    memset(map, 0, sizeof(OwnershipMap));
+}
+
+// 从 gs 再做 playouts 次随机对局并更新估计
+// 与上次估计的局面同样大小、贴目时: 局面没变则旧样本全部保留, 变化的点不多则乘上 OWNERSHIP_DECAY 后保留, 否则清空
+// threads 为 0 时按CPU核数, 线程数不超过 playouts / OWNERSHIP_MIN_PER_THREAD
+void ownershipUpdate(OwnershipMap* map, const GameState* gs, float komi, int playouts, int threads, unsigned int seed) {
+    int changes = 0;
+    for (int x = 0; x < gs->size; x++) {
+        for (int y = 0; y < gs->size; y++) {
+            changes += map->board[x * BOARD_SIZE + y] != gs->board[x][y];
+        }
+    }
+
+    map->reused = map->weight > 0 && map->size == gs->size && map->komi == komi &&
+        changes <= OWNERSHIP_REUSE_CHANGES;
+    if (map->reused && changes > 0) {
+        for (int p = 0; p < MAX_POINTS; p++) {
+            map->blackSum[p] *= OWNERSHIP_DECAY;
+            map->whiteSum[p] *= OWNERSHIP_DECAY;
+        }
+        map->weight *= OWNERSHIP_DECAY;
+        map->scoreSum *= OWNERSHIP_DECAY;
+        map->scoreSqSum *= OWNERSHIP_DECAY;
+        map->blackWinSum *= OWNERSHIP_DECAY;
+    }
+    else if (!map->reused) {
+        ownershipReset(map);
+        map->size = gs->size;
+        map->komi = komi;
+    }
+    for (int x = 0; x < BOARD_SIZE; x++) {
+        for (int y = 0; y < BOARD_SIZE; y++) {
+            map->board[x * BOARD_SIZE + y] = (unsigned char)gs->board[x][y];
+        }
+    }
+
+    if (playouts < 1) playouts = 1;
+    if (threads <= 0) threads = (int)std::thread::hardware_concurrency();
+    if (threads > playouts / OWNERSHIP_MIN_PER_THREAD) threads = playouts / OWNERSHIP_MIN_PER_THREAD;
+    if (threads > OWNERSHIP_MAX_THREADS) threads = OWNERSHIP_MAX_THREADS;
+    if (threads < 1) threads = 1;
+
+    OwnershipBatch* batches = new OwnershipBatch[threads];
+    std::thread workers[OWNERSHIP_MAX_THREADS];
+    for (int i = 1; i < threads; i++) {
+        int share = playouts / threads + (i < playouts % threads);
+        workers[i] = std::thread(runBatch, gs, komi, share, seed + (unsigned int)i * 0x9E3779B9u, &batches[i]);
+    }
+    runBatch(gs, komi, playouts / threads + (playouts % threads > 0), seed, &batches[0]);
+    for (int i = 1; i < threads; i++) {
+        workers[i].join();
+    }
+
+    for (int i = 0; i < threads; i++) {
+        const OwnershipBatch* batch = &batches[i];
+        for (int p = 0; p < MAX_POINTS; p++) {
+            map->blackSum[p] += (float)batch->black[p];
+            map->whiteSum[p] += (float)batch->white[p];
+        }
+        map->weight += (float)batch->count;
+        map->scoreSum += (float)batch->scoreSum;
+        map->scoreSqSum += (float)batch->scoreSqSum;
+        map->blackWinSum += (float)batch->blackWins;
+    }
+    delete[] batches;
+
+    summarize(map, gs);
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+/*
+ * 围棋游戏系统 - Part 3: 蒙特卡洛形势判断
+ * 负责人: 2518801370 李卓洵
+ * 包含: 从当前局面做多次随机对局统计各点归属、按棋串推断死子(被围住的小块棋用死活求解)、带置信度的目差估计
+ * 说明: 不依赖 EasyX; 局面只变了几个点时保留之前的样本(按权重衰减), 每手之后都可以刷新
+ */
+
+#ifndef PART3_OWNERSHIP_H
+#define PART3_OWNERSHIP_H
+
+#include "Part1_Rules.h"
+
+#define OWNERSHIP_MAX_THREADS 64
+#define OWNERSHIP_MIN_PER_THREAD 32  // 每个线程至少分到这么多次模拟, 否则少开线程
+#define OWNERSHIP_REUSE_CHANGES 8    // 与上次估计相比变化的点不超过这么多时保留旧样本
+#define OWNERSHIP_DECAY 0.5f         // 保留旧样本时乘上的权重
+#define OWNERSHIP_DEAD_LEVEL 0.3f    // 棋串的平均归属偏向对方超过此值时判为死子
+#define OWNERSHIP_SETTLED 0.3f       // 归属绝对值不到此值的点算未定, 数目时不计入任何一方
+
+typedef struct {
+    // 累计的样本, 由 ownershipUpdate 维护
+    int size;
+    float komi;
+    unsigned char board[MAX_POINTS]; // 上次估计时的棋盘
+    float blackSum[MAX_POINTS];      // 各点终局归黑的加权次数
+    float whiteSum[MAX_POINTS];
+    float weight;                    // 样本总权重(有效样本数)
+    float scoreSum;
+    float scoreSqSum;
+    float blackWinSum;
+
+    // 估计结果, 下标 x * BOARD_SIZE + y
+    float ownership[MAX_POINTS];     // 归黑的概率减归白的概率, -1 到 1, 盘外为 0
+    unsigned char dead[MAX_POINTS];  // 判为死子的棋子为 1
+    int deadBlack;
+    int deadWhite;
+    float score;        // 按归属数目(死子归对方, 未定点不计)的黑方目差, 已减贴目
+    float scoreMean;    // 随机对局终局黑方目差的平均值
+    float scoreStdDev;  // 同上的标准差
+    float blackWinRate;
+    int reused;         // 本次是否保留了之前的样本
+} OwnershipMap;
+
+void ownershipReset(OwnershipMap* map);
+void ownershipUpdate(OwnershipMap* map, const GameState* gs, float komi, int playouts, int threads, unsigned int seed);
+
+#endif // PART3_OWNERSHIP_H
\ No newline at end of file
@@ -0,0 +1,120 @@
+/*
+ * 围棋游戏系统 - Part 3: 3x3 模式表实现
+ * 负责人: 2518801370 李卓洵
+ * 实现: 把模式文本按 8 种对称和黑白互换展开, 通配符逐个枚举, 写入以模式码为下标的权重表
+ */
+
+#include "Part3_Patterns.h"
+
+// MoGo 论文中的模式(中心为落子点): 挡、断、边上的追、挡、立等
+static const char* const builtinPatterns[] = {
+    "XOX...???", // 挡: 夹住对方一子
+    "XO....?.?", // 挡: 不被断的扳
+    "XO?X..x.?", // 挡: 拐
+    "XO?O.o?o?", // 断: 没有保护的断点
+    "XO?O.X???", // 断: 已被刺的断点
+    "?X?O.Oooo", // 断: 冲
+    "OX?o.O???", // 断: 小飞的断
+    "X.?O.?###", // 边: 追
+    "OX?X.O###", // 边: 挡住边上的断
+    "?X?x.O###", // 边: 挡住边上的连接
+    "?XOx.x###", // 边: 立
+    "?OXX.O###", // 边: 断
+};
+
+static unsigned char weights[PATTERN_CODES];
+
+// 模式文本中第 r 行第 c 列对应模式码中的第几个邻点
+static int cellIndex(int r, int c) {
+    int i = r * 3 + c;
+    return i < 4 ? i : i - 1;
+}
+
+// 一个字符允许的颜色集合(按 EMPTY/BLACK/WHITE/OFF_BOARD 的位), xColor 为 X 的颜色
+static int allowedColors(char ch, int xColor) {
+    int oColor = xColor == BLACK ? WHITE : BLACK;
+    switch (ch) {
+    case 'X': return 1 << xColor;
+    case 'O': return 1 << oColor;
+    case '.': return 1 << EMPTY;
+    case '#': return 1 << OFF_BOARD;
+    case 'x': return 0xF & ~(1 << xColor);
+    case 'o': return 0xF & ~(1 << oColor);
+    case '?': return 0xF;
+    default: return 0;
+    }
+}
+
+// 逐个邻点枚举允许的颜色, 把匹配的模式码的权重提到 weight
+static void expand(const int allowed[8], int k, int code, int weight) {
+    if (k == 8) {
+        if (weights[code] < weight) weights[code] = (unsigned char)weight;
+        return;
+    }
+    for (int color = 0; color < 4; color++) {
+        if (allowed[k] & (1 << color)) {
+            expand(allowed, k + 1, code | color << (2 * k), weight);
+        }
+    }
+}
+
+// 加入一个模式(9 个字符), 格式不对时返回 0
+int patternAdd(const char* text, int weight) {
+    if (strlen(text) < 9 || text[4] != '.') return 0;
+    if (weight < 1) weight = 1;
+    if (weight > 255) weight = 255;
+
+    for (int t = 0; t < 8; t++) {
+        for (int xColor = BLACK; xColor <= WHITE; xColor++) {
+            int allowed[8];
+            for (int r = 0; r < 3; r++) {
+                for (int c = 0; c < 3; c++) {
+                    if (r == 1 && c == 1) continue;
+                    // 第 t 种对称: 先按需转置, 再按需上下、左右翻转
+                    int tr = (t & 4) ? c : r;
+                    int tc = (t & 4) ? r : c;
+                    if (t & 1) tr = 2 - tr;
+                    if (t & 2) tc = 2 - tc;
+                    allowed[cellIndex(tr, tc)] = allowedColors(text[r * 3 + c], xColor);
+                    if (allowed[cellIndex(tr, tc)] == 0) return 0;
+                }
+            }
+            expand(allowed, 0, 0, weight);
+        }
+    }
+    return 1;
+}
+
+static int loadBuiltin() {
+    int count = 0;
+    for (size_t i = 0; i < sizeof(builtinPatterns) / sizeof(builtinPatterns[0]); i++) {
+        count += patternAdd(builtinPatterns[i], PATTERN_DEFAULT_WEIGHT);
+    }
+    return count;
+}
+
+static int builtinCount = loadBuiltin(); // 程序启动时展开内置模式
+
+// 以模式码为下标的权重表, 0 表示不是好形
+const unsigned char* patternTable() {
+    return weights;
+}
+
+// 从文本文件载入模式, 替换内置表; 每行一个模式和可选的权重, 空行和 // 开头的行跳过
+// 返回载入的模式数, 文件打不开时返回 -1 且内置表不变
+int patternLoad(const char* filename) {
+    FILE* fp = fopen(filename, "r");
+    if (fp == NULL) return -1;
+
+    memset(weights, 0, sizeof(weights));
+    int count = 0;
+    char line[128];
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        char text[16];
+        int weight = PATTERN_DEFAULT_WEIGHT;
+        if (line[0] == '/' || sscanf(line, "%15s %d", text, &weight) < 1) continue;
+        count += patternAdd(text, weight);
+    }
+    fclose(fp);
+    return count;
+}
\ No newline at end of file
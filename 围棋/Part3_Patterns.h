@@ -0,0 +1,26 @@
+/*
+ * 围棋游戏系统 - Part 3: 3x3 模式表
+ * 负责人: 2518801370 李卓洵
+ * 包含: 按 GameState.pattern 的 16 位模式码直接查权重的表, 以及从文本文件载入模式
+ * 说明: 不依赖 EasyX; 内置 MoGo 的挡、断、边上的几类好形, 程序启动时展开成 65536 项的表,
+ *       每个模式都按 8 种对称和黑白互换展开, 模拟中选点只需查一次表
+ */
+
+#ifndef PART3_PATTERNS_H
+#define PART3_PATTERNS_H
+
+#include "Part1_Rules.h"
+
+#define PATTERN_CODES 65536         // 16 位模式码的个数
+#define PATTERN_DEFAULT_WEIGHT 10   // 内置模式的权重
+
+// 模式文本: 9 个字符按行描述 3x3, 中心必须是 '.', 后面可跟一个权重
+//   X 一方棋子  O 另一方棋子  . 空点  # 盘外
+//   x 不是 X    o 不是 O      ? 任意
+// 例如 "XOX...??? 10" 表示: 对方一子夹在两个己方子之间, 下方是空点时挡住(双方都适用)
+
+const unsigned char* patternTable();
+int patternAdd(const char* text, int weight);
+int patternLoad(const char* filename);
+
+#endif // PART3_PATTERNS_H
\ No newline at end of file
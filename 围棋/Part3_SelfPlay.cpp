@@ -0,0 +1,611 @@
+/*
+ * 围棋游戏系统 - Part 3: 自对弈数据生成实现
+ * 负责人: 2518801370 李卓洵
+ * 线程: threads 个工作线程各自领取对局编号, 用自己的搜索树单线程搜索(复用上一手的子树), 下完一局后
+ *       持写入锁把整局追加到当前分片并 fflush; 分片写满后改名为 .bin 并在 index.txt 末尾记一行
+ * 分片: 8 字节文件头(SELFPLAY_MAGIC、SELFPLAY_VERSION), 之后是逐局的记录:
+ *       SELFPLAY_GAME_MAGIC、记录长度、记录的 CRC32(都是小端 uint32), 然后是记录本身:
+ *       varint 编号, u8 路数, float 贴目, u8 胜方, u8 标志, float 黑方目差, varint 局面数, 再逐个局面:
+ *       u8 标志, 棋盘(每点 2 位, 按 x * size + y 排列, 每字节 4 点, 低位在前), varint 劫争禁着点 + 1,
+ *       varint 着法, u8 胜率 * 255, varint 有访问的着法数, 再按点号从小到大逐个: varint 与上一个点号之差 - 1, varint 访问数
+ * 压缩: 棋盘按 2 位打包、访问分布只存非零项并用变长整数, 19 路每个局面约一两百字节, 不依赖压缩库
+ * 续写: 启动时读 index.txt, 再检查下一个编号的分片: .bin 已改名但没记入索引的补记一行,
+ *       .part 中校验通过的对局保留, 中断时写了一半的记录截掉; 新对局的编号从已有的最大编号之后接着取
+ */
+
+#include "Part3_SelfPlay.h"
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#if defined(_WIN32)
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+#define SELFPLAY_HEADER_BYTES 8  // 分片文件头
+#define SELFPLAY_RECORD_HEADER 12 // 每局记录前的 magic、长度、CRC32
+
+typedef std::vector<unsigned char> ByteBuffer;
+
+// ---------------- 编码 ----------------
+
+static void putU8(ByteBuffer* out, unsigned int v) {
+    out->push_back((unsigned char)v);
+}
+
+static void putU32(ByteBuffer* out, unsigned int v) {
+    for (int i = 0; i < 4; i++) out->push_back((unsigned char)(v >> (8 * i)));
+}
+
+static void putFloat(ByteBuffer* out, float f) {
+    unsigned int v;
+    memcpy(&v, &f, sizeof(v));
+    putU32(out, v);
+}
+
+static void putVarint(ByteBuffer* out, unsigned long long v) {
+    while (v >= 0x80) {
+        out->push_back((unsigned char)(v | 0x80));
+        v >>= 7;
+    }
+    out->push_back((unsigned char)v);
+}
+
+static unsigned int getU32(const unsigned char* p) {
+    return (unsigned int)p[0] | ((unsigned int)p[1] << 8) | ((unsigned int)p[2] << 16) | ((unsigned int)p[3] << 24);
+}
+
+// 顺序读取记录, 越界或格式错误时 ok 置 0, 之后读出的都是 0
+typedef struct {
+    const unsigned char* p;
+    const unsigned char* end;
+    int ok;
+} ByteReader;
+
+static unsigned int readU8(ByteReader* r) {
+    if (r->p >= r->end) {
+        r->ok = 0;
+        return 0;
+    }
+    return *r->p++;
+}
+
+static float readFloat(ByteReader* r) {
+    if (r->end - r->p < 4) {
+        r->ok = 0;
+        return 0.0f;
+    }
+    unsigned int v = getU32(r->p);
+    r->p += 4;
+    float f;
+    memcpy(&f, &v, sizeof(f));
+    return f;
+}
+
+static unsigned long long readVarint(ByteReader* r) {
+    unsigned long long v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        unsigned int b = readU8(r);
+        if (!r->ok) return 0;
+        v |= (unsigned long long)(b & 0x7F) << shift;
+        if ((b & 0x80) == 0) return v;
+    }
+    r->ok = 0;
+    return 0;
+}
+
+typedef struct {
+    unsigned int entry[256];
+} CrcTable;
+
+static CrcTable makeCrcTable() {
+    CrcTable table;
+    for (unsigned int i = 0; i < 256; i++) {
+        unsigned int c = i;
+        for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        table.entry[i] = c;
+    }
+    return table;
+}
+
+// 标准 CRC32(与 zlib 相同)
+static unsigned int crc32(const unsigned char* data, size_t bytes) {
+    static const CrcTable table = makeCrcTable();
+    unsigned int c = 0xFFFFFFFFu;
+    for (size_t i = 0; i < bytes; i++) c = table.entry[(c ^ data[i]) & 0xFF] ^ (c >> 8);
+    return c ^ 0xFFFFFFFFu;
+}
+
+// 追加一个局面; move 和 visits 的下标为 x * BOARD_SIZE + y(停一手为 MCTS_PASS), 写入时换成 x * size + y
+static void encodePosition(ByteBuffer* out, const GameState* gs, int full, int move, float winRate, const int* visits) {
+    int n = gs->size;
+    putU8(out, (gs->currentPlayer == WHITE ? SELFPLAY_WHITE_TO_MOVE : 0) | (full ? SELFPLAY_FULL_SEARCH : 0));
+
+    unsigned int packed = 0;
+    for (int p = 0; p < n * n; p++) {
+        packed |= (unsigned int)gs->board[p / n][p % n] << (2 * (p & 3));
+        if ((p & 3) == 3 || p == n * n - 1) {
+            putU8(out, packed);
+            packed = 0;
+        }
+    }
+    putVarint(out, gs->koPoint < 0 ? 0 : gs->koPoint / BOARD_SIZE * n + gs->koPoint % BOARD_SIZE + 1);
+    putVarint(out, move == MCTS_PASS ? n * n : move / BOARD_SIZE * n + move % BOARD_SIZE);
+    float w = winRate < 0.0f ? 0.0f : (winRate > 1.0f ? 1.0f : winRate);
+    putU8(out, (unsigned int)(w * 255.0f + 0.5f));
+
+    int count = visits[MCTS_PASS] > 0;
+    for (int p = 0; p < n * n; p++) count += visits[p / n * BOARD_SIZE + p % n] > 0;
+    putVarint(out, count);
+    int previous = -1;
+    for (int p = 0; p <= n * n; p++) {
+        int v = p == n * n ? visits[MCTS_PASS] : visits[p / n * BOARD_SIZE + p % n];
+        if (v <= 0) continue;
+        putVarint(out, p - previous - 1);
+        putVarint(out, v);
+        previous = p;
+    }
+}
+
+// 解析一局记录(不含前面的 magic、长度和 CRC); fn 非 NULL 时对每个局面调用; 记录完整且恰好读完时返回 1
+int selfPlayReadGame(const unsigned char* data, size_t bytes, SelfPlayGameInfo* info, SelfPlayPositionFn fn, void* context) {
+    ByteReader r = { data, data + bytes, 1 };
+    info->id = (long long)readVarint(&r);
+    info->size = (int)readU8(&r);
+    info->komi = readFloat(&r);
+    info->winner = (int)readU8(&r);
+    info->flags = (int)readU8(&r);
+    info->score = readFloat(&r);
+    info->positionCount = (int)readVarint(&r);
+    int n = info->size;
+    if (!r.ok || n < 2 || n > BOARD_SIZE || info->positionCount < 0 || info->positionCount > MAX_HISTORY * 2) return 0;
+
+    SelfPlayPosition position;
+    for (int i = 0; i < info->positionCount && r.ok; i++) {
+        position.flags = (int)readU8(&r);
+        unsigned int packed = 0;
+        for (int p = 0; p < n * n; p++) {
+            if ((p & 3) == 0) packed = readU8(&r);
+            position.board[p] = (unsigned char)((packed >> (2 * (p & 3))) & 3);
+            if (position.board[p] > WHITE) r.ok = 0;
+        }
+        position.koPoint = (int)readVarint(&r) - 1;
+        position.move = (int)readVarint(&r);
+        position.winRate = readU8(&r) / 255.0f;
+        position.visitCount = (int)readVarint(&r);
+        if (position.koPoint >= n * n || position.move > n * n || position.visitCount > n * n + 1) r.ok = 0;
+        int point = -1;
+        for (int k = 0; k < position.visitCount && r.ok; k++) {
+            point += (int)readVarint(&r) + 1;
+            position.visitMoves[k] = (short)point;
+            position.visits[k] = (int)readVarint(&r);
+            if (point > n * n) r.ok = 0;
+        }
+        if (r.ok && fn != NULL) fn(context, info, &position);
+    }
+    return r.ok && r.p == r.end;
+}
+
+// ---------------- 分片写入 ----------------
+
+typedef struct {
+    std::mutex mutex;
+    std::string dir;
+    FILE* fp;               // 正在写的 .part
+    int shard;              // 正在写的分片编号
+    long long shardLimit;
+    long long shardBytes;
+    long long shardGames;
+    long long shardPositions;
+    long long shardFirst;   // 分片中最小和最大的对局编号
+    long long shardLast;
+    long long nextId;       // 本次运行第一局的编号
+    int failed;             // 写文件出错, 各线程尽快停止
+    SelfPlayStats stats;
+    std::chrono::steady_clock::time_point start;
+} ShardWriter;
+
+static std::string shardPath(const ShardWriter* w, int shard, const char* extension) {
+    char name[32];
+    snprintf(name, sizeof(name), "shard_%05d%s", shard, extension);
+    return w->dir + "/" + name;
+}
+
+static std::string indexPath(const ShardWriter* w) {
+    return w->dir + "/index.txt";
+}
+
+static void noteGame(ShardWriter* w, const SelfPlayGameInfo* info) {
+    if (w->shardGames == 0 || info->id < w->shardFirst) w->shardFirst = info->id;
+    if (w->shardGames == 0 || info->id > w->shardLast) w->shardLast = info->id;
+    w->shardGames++;
+    w->shardPositions += info->positionCount;
+    if (info->id >= w->nextId) w->nextId = info->id + 1;
+}
+
+// 读整个文件
+static int readWholeFile(const std::string& path, ByteBuffer* data) {
+    FILE* fp = fopen(path.c_str(), "rb");
+    if (fp == NULL) return 0;
+    data->clear();
+    unsigned char chunk[65536];
+    size_t got;
+    while ((got = fread(chunk, 1, sizeof(chunk), fp)) > 0) data->insert(data->end(), chunk, chunk + got);
+    fclose(fp);
+    return 1;
+}
+
+// 逐局检查分片, 返回校验通过的前缀的字节数(文件头不对时为 0); 通过的对局计入 w 的当前分片
+// fn 非 NULL 时对其中每个局面调用
+static size_t scanShard(ShardWriter* w, const ByteBuffer& data, SelfPlayPositionFn fn, void* context) {
+    if (data.size() < SELFPLAY_HEADER_BYTES || getU32(&data[0]) != SELFPLAY_MAGIC || getU32(&data[4]) != SELFPLAY_VERSION) {
+        return 0;
+    }
+    size_t offset = SELFPLAY_HEADER_BYTES;
+    while (data.size() - offset >= SELFPLAY_RECORD_HEADER) {
+        const unsigned char* p = &data[offset];
+        unsigned int length = getU32(p + 4);
+        if (getU32(p) != SELFPLAY_GAME_MAGIC || length > data.size() - offset - SELFPLAY_RECORD_HEADER) break;
+        const unsigned char* record = p + SELFPLAY_RECORD_HEADER;
+        if (crc32(record, length) != getU32(p + 8)) break;
+        SelfPlayGameInfo info;
+        if (!selfPlayReadGame(record, length, &info, fn, context)) break;
+        noteGame(w, &info);
+        offset += SELFPLAY_RECORD_HEADER + length;
+    }
+    return offset;
+}
+
+// 把当前分片记入索引
+static int appendIndex(ShardWriter* w, long long bytes) {
+    FILE* fp = fopen(indexPath(w).c_str(), "a");
+    if (fp == NULL) return 0;
+    char name[32];
+    snprintf(name, sizeof(name), "shard_%05d.bin", w->shard);
+    fprintf(fp, "%s %lld %lld %lld %lld %lld\n", name, w->shardGames, w->shardPositions, bytes, w->shardFirst, w->shardLast);
+    int ok = fclose(fp) == 0;
+
+    w->stats.shards++;
+    w->stats.games += w->shardGames;
+    w->stats.positions += w->shardPositions;
+    w->stats.bytes += bytes;
+    w->shard++;
+    w->shardGames = 0;
+    w->shardPositions = 0;
+    w->shardBytes = 0;
+    return ok;
+}
+
+static int openNewShard(ShardWriter* w) {
+    w->fp = fopen(shardPath(w, w->shard, ".part").c_str(), "wb");
+    if (w->fp == NULL) return 0;
+    ByteBuffer header;
+    putU32(&header, SELFPLAY_MAGIC);
+    putU32(&header, SELFPLAY_VERSION);
+    w->shardBytes = SELFPLAY_HEADER_BYTES;
+    return fwrite(header.data(), 1, header.size(), w->fp) == header.size() && fflush(w->fp) == 0;
+}
+
+// 读索引和未写完的分片, 准备接着写; 出错返回 0
+static int openWriter(ShardWriter* w) {
+#if defined(_WIN32)
+    _mkdir(w->dir.c_str());
+#else
+    mkdir(w->dir.c_str(), 0755);
+#endif
+    FILE* index = fopen(indexPath(w).c_str(), "r");
+    if (index != NULL) {
+        char line[256];
+        while (fgets(line, sizeof(line), index) != NULL) {
+            char name[64];
+            long long games, positions, bytes, first, last;
+            if (line[0] == '#') continue;
+            if (sscanf(line, "%63s %lld %lld %lld %lld %lld", name, &games, &positions, &bytes, &first, &last) != 6) continue;
+            w->stats.shards++;
+            w->stats.games += games;
+            w->stats.positions += positions;
+            w->stats.bytes += bytes;
+            if (last >= w->nextId) w->nextId = last + 1;
+        }
+        fclose(index);
+        w->shard = w->stats.shards;
+    }
+    else {
+        index = fopen(indexPath(w).c_str(), "w");
+        if (index == NULL) return 0;
+        fprintf(index, "# file games positions bytes first_id last_id\n");
+        fclose(index);
+    }
+
+    // 改名后没来得及记入索引的分片
+    ByteBuffer data;
+    while (readWholeFile(shardPath(w, w->shard, ".bin"), &data)) {
+        size_t valid = scanShard(w, data, NULL, NULL);
+        if (!appendIndex(w, (long long)valid)) return 0;
+    }
+
+    // 中断时正在写的分片: 保留完整的对局, 截掉写了一半的记录
+    std::string part = shardPath(w, w->shard, ".part");
+    if (readWholeFile(part, &data)) {
+        size_t valid = scanShard(w, data, NULL, NULL);
+        if (valid == 0) return openNewShard(w);
+        if (valid < data.size()) {
+            std::string temp = part + ".tmp";
+            FILE* fp = fopen(temp.c_str(), "wb");
+            if (fp == NULL) return 0;
+            int ok = fwrite(data.data(), 1, valid, fp) == valid;
+            if (fclose(fp) != 0 || !ok) return 0;
+            remove(part.c_str());
+            if (rename(temp.c_str(), part.c_str()) != 0) return 0;
+        }
+        w->fp = fopen(part.c_str(), "ab");
+        w->shardBytes = (long long)valid;
+        return w->fp != NULL;
+    }
+    return openNewShard(w);
+}
+
+// 写完的分片改名并记入索引
+static int finishShard(ShardWriter* w) {
+    int ok = fclose(w->fp) == 0;
+    w->fp = NULL;
+    ok = ok && rename(shardPath(w, w->shard, ".part").c_str(), shardPath(w, w->shard, ".bin").c_str()) == 0;
+    return ok && appendIndex(w, w->shardBytes);
+}
+
+// 追加一局, 当前分片放不下时先换一个新分片
+static void writeGame(ShardWriter* w, const ByteBuffer& record, const SelfPlayGameInfo* info, int resigned,
+    long long fullPositions, SelfPlayProgress progress, void* context) {
+    ByteBuffer header;
+    putU32(&header, SELFPLAY_GAME_MAGIC);
+    putU32(&header, (unsigned int)record.size());
+    putU32(&header, crc32(record.data(), record.size()));
+    long long bytes = (long long)(header.size() + record.size());
+
+    std::lock_guard<std::mutex> lock(w->mutex);
+    if (w->failed) return;
+    if (w->shardGames > 0 && w->shardBytes + bytes > w->shardLimit) {
+        if (!finishShard(w) || !openNewShard(w)) {
+            w->failed = 1;
+            return;
+        }
+    }
+    if (fwrite(header.data(), 1, header.size(), w->fp) != header.size() ||
+        fwrite(record.data(), 1, record.size(), w->fp) != record.size() || fflush(w->fp) != 0) {
+        w->failed = 1;
+        return;
+    }
+    w->shardBytes += bytes;
+    noteGame(w, info);
+    w->stats.fullPositions += fullPositions;
+    w->stats.resigned += resigned;
+
+    if (progress != NULL) {
+        SelfPlayStats current = w->stats;
+        current.games += w->shardGames;
+        current.positions += w->shardPositions;
+        current.bytes += w->shardBytes;
+        current.elapsedSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - w->start).count();
+        progress(context, &current);
+    }
+}
+
+// ---------------- 对局 ----------------
+
+static unsigned int nextRandom(unsigned int* seed) {
+    *seed = *seed * 1103515245u + 12345u;
+    return *seed >> 8;
+}
+
+// [0, 1) 的随机数
+static float randomUnit(unsigned int* seed) {
+    return nextRandom(seed) / 16777216.0f;
+}
+
+// 第 id 局的种子
+static unsigned int gameSeed(unsigned int seed, long long id) {
+    unsigned long long z = (unsigned long long)id * 0x9E3779B97F4A7C15ull + seed;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    unsigned int s = (unsigned int)(z ^ (z >> 31));
+    return s != 0 ? s : 1u;
+}
+
+// 下一局, 整局记录写入 record; 被取消时返回 0
+static int playGame(const SelfPlayParams* params, MctsTree* tree, Position* pos, long long id,
+    ByteBuffer* record, SelfPlayGameInfo* info, long long* fullPositions) {
+    int n = params->size;
+    unsigned int rng = gameSeed(params->seed, id);
+    int allowResign = params->resignThreshold > 0.0f && randomUnit(&rng) >= params->noResignFraction;
+    int maxMoves = n * n * 2 < MAX_HISTORY - 1 ? n * n * 2 : MAX_HISTORY - 1;
+    posInit(pos, n);
+
+    MctsParams search;
+    mctsDefaultParams(&search);
+    search.komi = params->komi;
+    search.usePatterns = params->usePatterns;
+    search.readLadders = params->readLadders;
+    search.network = params->network;
+    search.evalQueue = params->evalQueue;
+    search.rootPosition = pos;
+    search.cancel = params->cancel;
+
+    ByteBuffer body;
+    int positions = 0;
+    int passes = 0;
+    int lowMoves[3] = { 0, 0, 0 }; // 各方连续胜率过低的手数
+    info->winner = SELFPLAY_DRAW;
+    info->flags = 0;
+    info->score = 0.0f;
+    *fullPositions = 0;
+
+    for (int moves = 0; passes < 2; moves++) {
+        if (moves >= maxMoves || pos->historyCount >= MAX_HISTORY - 1) {
+            info->flags |= SELFPLAY_MOVE_CAP;
+            break;
+        }
+        int full = params->fastPlayouts <= 0 || randomUnit(&rng) < params->fullFraction;
+        search.maxPlayouts = full ? params->playouts : params->fastPlayouts;
+        search.seed = nextRandom(&rng) | 1u;
+
+        MctsResult result;
+        mctsSearchTree(tree, &pos->state, &search, &result);
+        if (params->cancel != NULL && params->cancel->load(std::memory_order_relaxed)) return 0;
+
+        int visits[MAX_POINTS + 1];
+        int total = mctsTreeRootVisits(tree, visits);
+        int move = result.bestX < 0 ? MCTS_PASS : result.bestX * BOARD_SIZE + result.bestY;
+        if (moves < params->sampleMoves && total > 0) {
+            // 开局按访问数抽样, 使各局走出不同的变化
+            int r = (int)(nextRandom(&rng) % (unsigned int)total);
+            for (int p = 0; p <= MAX_POINTS; p++) {
+                r -= visits[p];
+                if (r < 0) {
+                    move = p;
+                    break;
+                }
+            }
+        }
+
+        int player = pos->state.currentPlayer;
+        if (allowResign && moves >= params->sampleMoves) {
+            lowMoves[player] = result.winRate < params->resignThreshold ? lowMoves[player] + 1 : 0;
+            if (lowMoves[player] >= SELFPLAY_RESIGN_MOVES) {
+                info->winner = player == BLACK ? SELFPLAY_WHITE_WINS : SELFPLAY_BLACK_WINS;
+                info->flags |= SELFPLAY_RESIGNED;
+                break;
+            }
+        }
+
+        encodePosition(&body, &pos->state, full, move, result.winRate, visits);
+        positions++;
+        *fullPositions += full;
+        if (move != MCTS_PASS && posMakeMove(pos, move / BOARD_SIZE, move % BOARD_SIZE)) {
+            passes = 0;
+        }
+        else {
+            statePass(&pos->state);
+            passes++;
+        }
+    }
+
+    if (!(info->flags & SELFPLAY_RESIGNED)) {
+        info->score = stateAreaScore(&pos->state, params->komi, NULL);
+        info->winner = info->score > 0 ? SELFPLAY_BLACK_WINS : (info->score < 0 ? SELFPLAY_WHITE_WINS : SELFPLAY_DRAW);
+    }
+    info->id = id;
+    info->size = n;
+    info->komi = params->komi;
+    info->positionCount = positions;
+
+    record->clear();
+    putVarint(record, (unsigned long long)id);
+    putU8(record, n);
+    putFloat(record, params->komi);
+    putU8(record, info->winner);
+    putU8(record, info->flags);
+    putFloat(record, info->score);
+    putVarint(record, positions);
+    record->insert(record->end(), body.begin(), body.end());
+    return 1;
+}
+
+// 工作线程: 领取对局编号直到够数、取消或写入出错
+static void selfPlayWorker(const SelfPlayParams* params, ShardWriter* w, std::atomic<long long>* claimed,
+    long long remaining, long long firstId, SelfPlayProgress progress, void* context) {
+    MctsTree* tree = mctsTreeCreate();
+    Position* pos = new Position;
+    ByteBuffer record;
+    for (;;) {
+        if (params->cancel != NULL && params->cancel->load(std::memory_order_relaxed)) break;
+        {
+            std::lock_guard<std::mutex> lock(w->mutex);
+            if (w->failed) break;
+        }
+        long long k = claimed->fetch_add(1);
+        if (k >= remaining) break;
+
+        SelfPlayGameInfo info;
+        long long fullPositions;
+        if (!playGame(params, tree, pos, firstId + k, &record, &info, &fullPositions)) break;
+        writeGame(w, record, &info, (info.flags & SELFPLAY_RESIGNED) != 0, fullPositions, progress, context);
+    }
+    delete pos;
+    mctsTreeDestroy(tree);
+}
+
+// 在 params->outputDir 中生成对局直到总数达到 params->games 或被取消; 正常结束时最后一个分片也记入索引,
+// 被取消时留作 .part 供下次续写; stats 为结束时的统计; 目录或文件无法读写时返回 0
+int selfPlayRun(const SelfPlayParams* params, SelfPlayStats* stats, SelfPlayProgress progress, void* context) {
+    ShardWriter* w = new ShardWriter();
+    w->dir = params->outputDir;
+    w->fp = NULL;
+    w->shard = 0;
+    w->shardLimit = params->shardBytes > 0 ? params->shardBytes : (long long)SELFPLAY_DEFAULT_SHARD_MB << 20;
+    w->shardBytes = 0;
+    w->shardGames = 0;
+    w->shardPositions = 0;
+    w->shardFirst = 0;
+    w->shardLast = 0;
+    w->nextId = 0;
+    w->failed = 0;
+    memset(&w->stats, 0, sizeof(w->stats));
+    w->start = std::chrono::steady_clock::now();
+
+    int ok = openWriter(w);
+    long long done = w->stats.games + w->shardGames;
+    if (ok) {
+        w->stats.resumedGames = done;
+        long long remaining = params->games - done;
+        int threads = params->threads;
+        if (threads <= 0) threads = (int)std::thread::hardware_concurrency();
+        if (threads <= 0) threads = 1;
+        if (remaining < threads) threads = remaining > 0 ? (int)remaining : 0;
+
+        std::atomic<long long> claimed(0);
+        std::vector<std::thread> workers;
+        for (int i = 0; i < threads; i++) {
+            workers.push_back(std::thread(selfPlayWorker, params, w, &claimed, remaining, w->nextId, progress, context));
+        }
+        for (size_t i = 0; i < workers.size(); i++) workers[i].join();
+
+        ok = !w->failed;
+        int cancelled = params->cancel != NULL && params->cancel->load(std::memory_order_relaxed);
+        if (ok && !cancelled && w->shardGames > 0) {
+            ok = finishShard(w);
+        }
+        else if (w->fp != NULL) {
+            if (fclose(w->fp) != 0) ok = 0;
+            w->fp = NULL;
+        }
+    }
+    if (w->fp != NULL) fclose(w->fp);
+
+    *stats = w->stats;
+    stats->games += w->shardGames;
+    stats->positions += w->shardPositions;
+    stats->bytes += w->shardBytes;
+    stats->elapsedSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - w->start).count();
+    delete w;
+    return ok;
+}
+
+// 检查一个分片文件的每局记录, fn 非 NULL 时对每个局面调用; 返回对局数, 文件无法读取或有损坏的记录时返回 -1
+long long selfPlayVerifyShard(const char* filename, long long* positions, SelfPlayPositionFn fn, void* context) {
+    ShardWriter* w = new ShardWriter();
+    w->shardGames = 0;
+    w->shardPositions = 0;
+    w->nextId = 0;
+    ByteBuffer data;
+    long long games = -1;
+    if (readWholeFile(filename, &data)) {
+        size_t valid = scanShard(w, data, fn, context);
+        if (valid > 0 && valid == data.size()) games = w->shardGames;
+    }
+    if (positions != NULL) *positions = w->shardPositions;
+    delete w;
+    return games;
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+/*
+ * 围棋游戏系统 - Part 3: 自对弈数据生成
+ * 负责人: 2518801370 李卓洵
+ * 包含: 多局并行的无界面自对弈, 每个局面记录棋盘、着法、搜索访问分布和终局结果,
+ *       写入大小固定的压缩二进制分片(shard_NNNNN.bin)和文本索引(index.txt)
+ * 说明: 不依赖 EasyX; 每个线程一次只下一局、只持有一局的记录, 内存不随局数增长;
+ *       正在写的分片名为 shard_NNNNN.part, 中断后再次运行同一目录时从索引和该文件中完整的对局接着生成
+ */
+
+#ifndef PART3_SELFPLAY_H
+#define PART3_SELFPLAY_H
+
+#include "Part3_MCTS.h"
+
+#define SELFPLAY_MAGIC 0x50534F47       // 分片文件开头的 "GOSP"
+#define SELFPLAY_GAME_MAGIC 0x454D4147  // 每局记录开头的 "GAME"
+#define SELFPLAY_VERSION 1
+#define SELFPLAY_DEFAULT_SHARD_MB 32    // 分片大小的默认值
+#define SELFPLAY_RESIGN_MOVES 3         // 一方连续这么多手胜率低于阈值时认输
+
+// 对局结果 SelfPlayGameInfo.winner
+#define SELFPLAY_DRAW 0
+#define SELFPLAY_BLACK_WINS 1
+#define SELFPLAY_WHITE_WINS 2
+
+// SelfPlayGameInfo.flags
+#define SELFPLAY_RESIGNED 1   // 以认输结束, score 为 0
+#define SELFPLAY_MOVE_CAP 2   // 手数到上限后直接数子
+
+// SelfPlayPosition.flags
+#define SELFPLAY_WHITE_TO_MOVE 1
+#define SELFPLAY_FULL_SEARCH 2 // 完整搜索的局面, 访问分布可作训练目标; 否则是快速搜索, 只有棋盘和着法可靠
+
+typedef struct {
+    const char* outputDir;
+    long long games;       // 目录中总共要有的对局数(含之前运行完成的)
+    int threads;           // 同时进行的对局数, 0 表示按CPU核数
+    int size;
+    float komi;
+    int playouts;          // 完整搜索每步的模拟次数
+    int fastPlayouts;      // 快速搜索每步的模拟次数, 0 表示每步都完整搜索
+    float fullFraction;    // 有快速搜索时, 每步做完整搜索的概率
+    int sampleMoves;       // 开局这么多手按访问数抽样落子, 之后取访问最多的着法
+    float resignThreshold; // 胜率低于此值时考虑认输, 0 表示不认输
+    float noResignFraction; // 这么多比例的对局不认输, 用来检查认输是否过早
+    int usePatterns;
+    int readLadders;
+    const Network* network;
+    EvalQueue* evalQueue;  // 非 NULL 时各对局的网络估值在队列里合批计算
+    long long shardBytes;  // 分片大小上限, 一局不跨两个分片
+    unsigned int seed;     // 第 id 局用 seed 和 id 算出的种子, 同一种子和参数生成相同的对局
+    const std::atomic<int>* cancel; // 非 NULL 且变为非 0 时放弃正在下的对局并返回
+} SelfPlayParams;
+
+typedef struct {
+    long long games;        // 目录中已完成的对局数
+    long long positions;
+    long long fullPositions;
+    long long bytes;        // 全部分片的字节数
+    long long resumedGames; // 本次运行开始时已有的对局数
+    long long resigned;
+    int shards;             // 已写完并记入索引的分片数
+    double elapsedSec;      // 本次运行的时间
+} SelfPlayStats;
+
+// 每写完一局在写入线程中调用(持有写入锁, 不要耗时)
+typedef void (*SelfPlayProgress)(void* context, const SelfPlayStats* stats);
+
+// 读取记录时的一局信息
+typedef struct {
+    long long id;
+    int size;
+    float komi;
+    int winner;    // SELFPLAY_*_WINS 或 SELFPLAY_DRAW
+    int flags;
+    float score;   // 黑方数子的目差(已减贴目)
+    int positionCount;
+} SelfPlayGameInfo;
+
+// 读取记录时的一个局面, 点的下标为 x * size + y
+typedef struct {
+    int flags;
+    unsigned char board[MAX_POINTS]; // EMPTY/BLACK/WHITE
+    int koPoint;      // -1 表示没有
+    int move;         // size * size 表示停一手
+    float winRate;    // 搜索给出的走子方胜率
+    int visitCount;   // 有访问的着法数
+    short visitMoves[MAX_POINTS + 1];
+    int visits[MAX_POINTS + 1];
+} SelfPlayPosition;
+
+typedef void (*SelfPlayPositionFn)(void* context, const SelfPlayGameInfo* info, const SelfPlayPosition* position);
+
+int selfPlayRun(const SelfPlayParams* params, SelfPlayStats* stats, SelfPlayProgress progress, void* context);
+int selfPlayReadGame(const unsigned char* data, size_t bytes, SelfPlayGameInfo* info, SelfPlayPositionFn fn, void* context);
+long long selfPlayVerifyShard(const char* filename, long long* positions, SelfPlayPositionFn fn, void* context);
+
+#endif // PART3_SELFPLAY_H
\ No newline at end of file
@@ -0,0 +1,243 @@
+/*
+ * 围棋游戏系统 - Part 3: 无界面自对弈数据生成程序
+ * 负责人: 2518801370 李卓洵
+ * 用法: go_selfplay --out 目录 [--games 总局数] [--threads 同时对局数] [--config 配置文件] [--size 路数]
+ *                   [--playouts 每步模拟次数] [--fast 快速搜索模拟次数 完整搜索比例] [--sample-moves 手数]
+ *                   [--resign 胜率阈值] [--shard-mb 分片大小] [--seed 种子] [--network 权重文件] [--report 每几局打印]
+ *       go_selfplay --verify 目录
+ * 路数、贴目、模拟次数(AIPlayouts, 为 0 时按 AIDifficulty)、网络和估值队列的设置取自配置文件(默认 config.txt),
+ * 命令行给出的优先; 每局单线程搜索, 多局同时进行; 用了网络时各局的估值经同一个批量队列合批计算
+ * Ctrl+C 时放弃正在下的对局并退出, 用同样的参数再次运行即从中断处接着生成
+ * --verify 逐局校验目录中的全部分片, 与索引核对对局数, 打印局面数和胜负统计; 有损坏或不一致时以 1 退出
+ */
+
+#include "Part3_SelfPlay.h"
+#include <csignal>
+#include <string>
+
+static std::atomic<int> stopRequested(0);
+
+static void onSignal(int) {
+    stopRequested.store(1);
+}
+
+// 配置文件中自对弈用到的各项; 文件中的其他项和不认识的行跳过
+typedef struct {
+    int boardSize;
+    float komi;
+    int aiDifficulty;
+    int aiPlayouts;
+    int evalBatchSize;
+    int evalMaxWaitUs;
+    int evalCacheEntries;
+    char networkFile[260];
+} SelfPlayConfig;
+
+static void readConfig(const char* filename, SelfPlayConfig* cfg) {
+    cfg->boardSize = BOARD_SIZE;
+    cfg->komi = 7.5f;
+    cfg->aiDifficulty = 2;
+    cfg->aiPlayouts = 0;
+    cfg->evalBatchSize = EVAL_DEFAULT_BATCH;
+    cfg->evalMaxWaitUs = EVAL_DEFAULT_WAIT_US;
+    cfg->evalCacheEntries = EVAL_DEFAULT_CACHE;
+    cfg->networkFile[0] = '\0';
+
+    FILE* fp = fopen(filename, "r");
+    if (fp == NULL) return;
+    char line[512];
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (sscanf(line, "BoardSize=%d", &cfg->boardSize) == 1) continue;
+        if (sscanf(line, "Komi=%f", &cfg->komi) == 1) continue;
+        if (sscanf(line, "AIDifficulty=%d", &cfg->aiDifficulty) == 1) continue;
+        if (sscanf(line, "AIPlayouts=%d", &cfg->aiPlayouts) == 1) continue;
+        if (sscanf(line, "EvalBatchSize=%d", &cfg->evalBatchSize) == 1) continue;
+        if (sscanf(line, "EvalMaxWaitUs=%d", &cfg->evalMaxWaitUs) == 1) continue;
+        if (sscanf(line, "EvalCacheEntries=%d", &cfg->evalCacheEntries) == 1) continue;
+        if (strncmp(line, "NetworkFile=", 12) == 0) {
+            strncpy(cfg->networkFile, line + 12, sizeof(cfg->networkFile) - 1);
+            cfg->networkFile[sizeof(cfg->networkFile) - 1] = '\0';
+        }
+    }
+    fclose(fp);
+}
+
+typedef struct {
+    int every;
+    long long lastPrinted;
+} ProgressState;
+
+static void printProgress(void* context, const SelfPlayStats* stats) {
+    ProgressState* state = (ProgressState*)context;
+    long long played = stats->games - stats->resumedGames;
+    if (played - state->lastPrinted < state->every) return;
+    state->lastPrinted = played;
+    printf("games %8lld (%lld this run)  positions %10lld  resigned %5.1f%%  %8.0f games/h  %8.1f MB  %d shards\n",
+        stats->games, played, stats->positions, played > 0 ? stats->resigned * 100.0 / played : 0.0,
+        stats->elapsedSec > 0.0 ? played * 3600.0 / stats->elapsedSec : 0.0, stats->bytes / 1048576.0, stats->shards);
+    fflush(stdout);
+}
+
+// --verify 的统计
+typedef struct {
+    long long fullPositions;
+    long long visits;
+    long long wins[3];     // 按 SelfPlayGameInfo.winner
+    long long lastGame;
+} VerifyTotals;
+
+static void countPosition(void* context, const SelfPlayGameInfo* info, const SelfPlayPosition* position) {
+    VerifyTotals* totals = (VerifyTotals*)context;
+    if (info->id != totals->lastGame) {
+        totals->lastGame = info->id;
+        if (info->winner >= 0 && info->winner <= 2) totals->wins[info->winner]++;
+    }
+    if (position->flags & SELFPLAY_FULL_SEARCH) totals->fullPositions++;
+    for (int k = 0; k < position->visitCount; k++) totals->visits += position->visits[k];
+}
+
+static int verifyDirectory(const char* dir) {
+    std::string indexFile = std::string(dir) + "/index.txt";
+    FILE* index = fopen(indexFile.c_str(), "r");
+    if (index == NULL) {
+        printf("cannot open %s\n", indexFile.c_str());
+        return 1;
+    }
+    VerifyTotals totals;
+    memset(&totals, 0, sizeof(totals));
+    totals.lastGame = -1;
+    long long games = 0, positions = 0;
+    int shards = 0, bad = 0;
+    char line[256];
+    while (fgets(line, sizeof(line), index) != NULL) {
+        char name[64];
+        long long indexGames, indexPositions, bytes, first, last;
+        if (line[0] == '#') continue;
+        if (sscanf(line, "%63s %lld %lld %lld %lld %lld", name, &indexGames, &indexPositions, &bytes, &first, &last) != 6) continue;
+        long long shardPositions = 0;
+        long long shardGames = selfPlayVerifyShard((std::string(dir) + "/" + name).c_str(), &shardPositions, countPosition, &totals);
+        int ok = shardGames == indexGames && shardPositions == indexPositions;
+        printf("%s  %6lld games  %9lld positions%s\n", name, shardGames, shardPositions, ok ? "" : "  MISMATCH");
+        bad += !ok;
+        shards++;
+        games += shardGames > 0 ? shardGames : 0;
+        positions += shardPositions;
+    }
+    fclose(index);
+
+    printf("%d shards, %lld games, %lld positions (%.1f per game), %.1f%% full searches, %.0f visits per position\n",
+        shards, games, positions, games > 0 ? (double)positions / games : 0.0,
+        positions > 0 ? totals.fullPositions * 100.0 / positions : 0.0, positions > 0 ? (double)totals.visits / positions : 0.0);
+    printf("black wins %lld, white wins %lld, draws %lld\n", totals.wins[SELFPLAY_BLACK_WINS],
+        totals.wins[SELFPLAY_WHITE_WINS], totals.wins[SELFPLAY_DRAW]);
+    return bad > 0 ? 1 : 0;
+}
+
+int main(int argc, char* argv[]) {
+    const char* outputDir = NULL;
+    const char* configFile = "config.txt";
+    const char* networkFile = NULL;
+    long long games = 1000;
+    int threads = 0;
+    int size = 0;
+    int playouts = 0;
+    int fastPlayouts = 0;
+    float fullFraction = 0.25f;
+    int sampleMoves = -1;
+    float resign = 0.05f;
+    double shardMb = SELFPLAY_DEFAULT_SHARD_MB;
+    unsigned int seed = 20240601u;
+    int report = 10;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--verify") == 0 && i + 1 < argc) return verifyDirectory(argv[i + 1]);
+        else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) outputDir = argv[++i];
+        else if (strcmp(argv[i], "--games") == 0 && i + 1 < argc) games = atoll(argv[++i]);
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--config") == 0 && i + 1 < argc) configFile = argv[++i];
+        else if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) size = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--playouts") == 0 && i + 1 < argc) playouts = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--fast") == 0 && i + 2 < argc) {
+            fastPlayouts = atoi(argv[++i]);
+            fullFraction = (float)atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--sample-moves") == 0 && i + 1 < argc) sampleMoves = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--resign") == 0 && i + 1 < argc) resign = (float)atof(argv[++i]);
+        else if (strcmp(argv[i], "--shard-mb") == 0 && i + 1 < argc) shardMb = atof(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) seed = (unsigned int)strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--network") == 0 && i + 1 < argc) networkFile = argv[++i];
+        else if (strcmp(argv[i], "--report") == 0 && i + 1 < argc) report = atoi(argv[++i]);
+        else {
+            outputDir = NULL;
+            break;
+        }
+    }
+    if (outputDir == NULL) {
+        printf("usage: go_selfplay --out DIR [--games N] [--threads N] [--config FILE] [--size N] [--playouts N]\n"
+            "                   [--fast PLAYOUTS FRACTION] [--sample-moves N] [--resign WINRATE] [--shard-mb N]\n"
+            "                   [--seed N] [--network FILE] [--report N]\n"
+            "       go_selfplay --verify DIR\n");
+        return 1;
+    }
+
+    SelfPlayConfig cfg;
+    readConfig(configFile, &cfg);
+    if (size == 0) size = cfg.boardSize;
+    if (size != 9 && size != 13 && size != 19) {
+        printf("unsupported board size %d\n", size);
+        return 1;
+    }
+    if (playouts <= 0) playouts = cfg.aiPlayouts > 0 ? cfg.aiPlayouts : mctsLevelPlayouts(cfg.aiDifficulty);
+    if (networkFile == NULL && cfg.networkFile[0] != '\0') networkFile = cfg.networkFile;
+
+    Network* network = NULL;
+    EvalQueue* evalQueue = NULL;
+    if (networkFile != NULL) {
+        network = networkLoad(networkFile);
+        if (network == NULL || network->size != size) {
+            printf("cannot load %dx%d network from %s\n", size, size, networkFile);
+            return 1;
+        }
+        evalQueue = evalQueueCreate(network, cfg.evalBatchSize, cfg.evalMaxWaitUs, cfg.evalCacheEntries);
+    }
+
+    SelfPlayParams params;
+    params.outputDir = outputDir;
+    params.games = games;
+    params.threads = threads;
+    params.size = size;
+    params.komi = cfg.komi;
+    params.playouts = playouts;
+    params.fastPlayouts = fastPlayouts;
+    params.fullFraction = fullFraction;
+    params.sampleMoves = sampleMoves >= 0 ? sampleMoves : size * size / 12; // 19 路 30 手, 9 路 6 手
+    params.resignThreshold = resign;
+    params.noResignFraction = 0.1f;
+    params.usePatterns = 1;
+    params.readLadders = 0;
+    params.network = network;
+    params.evalQueue = evalQueue;
+    params.shardBytes = (long long)(shardMb * 1048576.0);
+    params.seed = seed;
+    params.cancel = &stopRequested;
+
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+    printf("self-play %dx%d, komi %.1f, %d playouts", size, size, params.komi, playouts);
+    if (fastPlayouts > 0) printf(" (%d on %.0f%% of moves)", fastPlayouts, (1.0f - fullFraction) * 100.0f);
+    printf(", %s, %lld games into %s\n", network != NULL ? "network" : "random playouts", games, outputDir);
+
+    ProgressState progress = { report > 0 ? report : 1, 0 };
+    SelfPlayStats stats;
+    int ok = selfPlayRun(&params, &stats, printProgress, &progress);
+    long long played = stats.games - stats.resumedGames;
+    printf("%s: %lld games in %s (%lld this run, %lld resumed), %lld positions, %.1f MB in %d finished shards, "
+        "%.0f games/h\n", ok ? (stopRequested.load() ? "interrupted" : "done") : "write error", stats.games, outputDir,
+        played, stats.resumedGames, stats.positions, stats.bytes / 1048576.0, stats.shards,
+        stats.elapsedSec > 0.0 ? played * 3600.0 / stats.elapsedSec : 0.0);
+
+    evalQueueDestroy(evalQueue);
+    if (network != NULL) networkDestroy(network);
+    return ok ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,307 @@
+/*
+ * 围棋游戏系统 - Part 3: 征子与对杀读秒实现
+ * 负责人: 2518801370 李卓洵
+ * 实现: 攻方只走紧气(第一手两口气时加上枷), 守方只走长气和提掉叫吃自己的子;
+ *       守方走完后气数达到 TACTICS_MAX_LIBS 即算逃出, 因此征子每层只有两三个分支
+ * 读到局面数上限或最大深度时按"吃不掉"处理, 这种不确定的结果不进缓存
+ */
+
+#include "Part3_Tactics.h"
+#include "Part1_BoardTables.h"
+
+#define TACTICS_MAX_CANDIDATES 16
+#define TACTICS_QUERY_CAPTURE 1
+#define TACTICS_QUERY_RESCUE 2
+
+// 一手棋的撤销信息
+typedef struct {
+    int x;
+    int y;
+    int koPoint;
+    int captured;
+    short removed[MAX_POINTS];
+} TacticsMove;
+
+// 一次查询的局面计数
+typedef struct {
+    int nodes;
+    int limit;
+    int aborted; // 读到上限或最大深度, 结果不确定
+} TacticsReader;
+
+// 缓存项: 局面哈希、走子方、打劫点、目标棋子和查询类型合成的键
+typedef struct {
+    unsigned long long key;
+    short move;  // 普通下标, -1 表示不需要落子
+    unsigned char result;
+    unsigned char used;
+} TacticsEntry;
+
+static thread_local TacticsEntry cache[1 << TACTICS_CACHE_BITS];
+
+static unsigned long long cacheKey(const GameState* gs, int p, int query) {
+    unsigned long long k = gs->hash;
+    k ^= (unsigned long long)(gs->koPoint + 1) << 40;
+    k ^= (unsigned long long)p << 16;
+    k ^= (unsigned long long)(query * 4 + gs->currentPlayer);
+    k ^= k >> 31;
+    k *= 0x9E3779B97F4A7C15ULL;
+    return k ^ (k >> 29);
+}
+
+// p 所在棋串的气(带边框下标), 最多取 max + 1 口, 返回值大于 max 时只说明气数超过 max
+static int chainLiberties(const GameState* gs, int p, int* libs, int max) {
+    int count = 0;
+    int head = gs->chainHead[p];
+    int q = head;
+    do {
+        for (int i = 0; i < 4; i++) {
+            int n = q + neighborOffset[i];
+            if (gs->cells[n] != EMPTY) continue;
+            int k = 0;
+            while (k < count && libs[k] != n) k++;
+            if (k < count) continue;
+            libs[count++] = n;
+            if (count > max) return count;
+        }
+        q = gs->chainNext[q];
+    } while (q != head);
+    return count;
+}
+
+static void addCandidate(int* candidates, int* count, int p) {
+    for (int i = 0; i < *count; i++) {
+        if (candidates[i] == p) return;
+    }
+    if (*count < TACTICS_MAX_CANDIDATES) candidates[(*count)++] = p;
+}
+
+// 候选的一段按下标排序: 撤销后串内链表的顺序会变, 排序后同一局面总是同样的读法和结果
+static void sortCandidates(int* candidates, int from, int to) {
+    for (int i = from + 1; i < to; i++) {
+        int p = candidates[i];
+        int k = i;
+        while (k > from && candidates[k - 1] > p) {
+            candidates[k] = candidates[k - 1];
+            k--;
+        }
+        candidates[k] = p;
+    }
+}
+
+// 当前一方在带边框下标 p 落子, 不合法时返回 0
+static int playMove(GameState* gs, int p, TacticsMove* m) {
+    int d = boardTables.denseOf[p];
+    m->x = d / BOARD_SIZE;
+    m->y = d % BOARD_SIZE;
+    if (!stateIsLegal(gs, m->x, m->y)) return 0;
+    m->koPoint = gs->koPoint;
+    m->captured = statePlay(gs, m->x, m->y, m->removed);
+    return 1;
+}
+
+static void undoMove(GameState* gs, const TacticsMove* m) {
+    stateUnplay(gs, m->x, m->y, m->removed, m->captured, m->koPoint);
+}
+
+static int defend(TacticsReader* r, GameState* gs, int target, int depth, int* move);
+
+// 攻方(当前走子方)先走, 能否提掉 target 所在的棋串; 能时 move 为第一手(带边框下标)
+static int attack(TacticsReader* r, GameState* gs, int target, int depth, int* move) {
+    if (++r->nodes > r->limit) {
+        r->aborted = 1;
+        return 0;
+    }
+
+    int libs[TACTICS_MAX_LIBS + 1];
+    int maxLibs = depth == 0 ? TACTICS_MAX_LIBS : TACTICS_MAX_LIBS - 1;
+    int n = chainLiberties(gs, target, libs, maxLibs);
+    if (n > maxLibs) return 0;
+    if (n == 1) {
+        int d = boardTables.denseOf[libs[0]];
+        if (!stateIsLegal(gs, d / BOARD_SIZE, d % BOARD_SIZE)) return 0; // 提不了(打劫), 不再往下读
+        *move = libs[0];
+        return 1;
+    }
+    if (depth >= TACTICS_MAX_DEPTH) {
+        r->aborted = 1;
+        return 0;
+    }
+
+    // 候选: 紧气; 第一手两口气时再加上气的邻点(枷)
+    int candidates[TACTICS_MAX_CANDIDATES];
+    int count = 0;
+    for (int i = 0; i < n; i++) {
+        addCandidate(candidates, &count, libs[i]);
+    }
+    sortCandidates(candidates, 0, count);
+    if (depth == 0 && n == 2) {
+        int libCount = count;
+        for (int i = 0; i < n; i++) {
+            for (int k = 0; k < 4; k++) {
+                int q = libs[i] + neighborOffset[k];
+                if (gs->cells[q] == EMPTY) addCandidate(candidates, &count, q);
+            }
+        }
+        sortCandidates(candidates, libCount, count);
+    }
+
+    TacticsMove m;
+    for (int i = 0; i < count; i++) {
+        if (!playMove(gs, candidates[i], &m)) continue;
+        int reply;
+        int lives = defend(r, gs, target, depth + 1, &reply);
+        undoMove(gs, &m);
+        if (!lives) {
+            *move = candidates[i];
+            return 1;
+        }
+        if (r->aborted) return 0;
+    }
+    return 0;
+}
+
+// 守方(当前走子方)先走, target 所在的棋串能否不被提掉; 能时 move 为救棋的一手, -1 表示不用走
+static int defend(TacticsReader* r, GameState* gs, int target, int depth, int* move) {
+    *move = -1;
+    if (++r->nodes > r->limit) {
+        r->aborted = 1;
+        return 1;
+    }
+
+    int libs[TACTICS_MAX_LIBS + 1];
+    int n = chainLiberties(gs, target, libs, TACTICS_MAX_LIBS);
+    if (depth > 0 && n >= TACTICS_MAX_LIBS) return 1;
+    if (depth >= TACTICS_MAX_DEPTH) {
+        r->aborted = 1;
+        return 1;
+    }
+
+    // 候选: 长气, 以及提掉相邻的被叫吃的对方棋串
+    int candidates[TACTICS_MAX_CANDIDATES];
+    int count = 0;
+    for (int i = 0; i < n && i < TACTICS_MAX_LIBS; i++) {
+        addCandidate(candidates, &count, libs[i]);
+    }
+    sortCandidates(candidates, 0, count);
+    int libCount = count;
+    int color = gs->cells[target];
+    int head = gs->chainHead[target];
+    int q = head;
+    do {
+        for (int i = 0; i < 4; i++) {
+            int e = q + neighborOffset[i];
+            int c = gs->cells[e];
+            if (c == EMPTY || c == OFF_BOARD || c == color) continue;
+            int d = boardTables.denseOf[e];
+            int lib = stateAtariLiberty(gs, d / BOARD_SIZE, d % BOARD_SIZE);
+            if (lib >= 0) addCandidate(candidates, &count, PAD_INDEX(lib / BOARD_SIZE, lib % BOARD_SIZE));
+        }
+        q = gs->chainNext[q];
+    } while (q != head);
+    sortCandidates(candidates, libCount, count);
+
+    TacticsMove m;
+    for (int i = 0; i < count; i++) {
+        if (!playMove(gs, candidates[i], &m)) continue;
+        int reply;
+        int captured = attack(r, gs, target, depth + 1, &reply);
+        undoMove(gs, &m);
+        if (!captured || r->aborted) {
+            *move = candidates[i];
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// 当前走子方能否提掉(x, y)处的对方棋串(不超过 TACTICS_MAX_LIBS 口气)
+// 能时返回 1, move 为第一手(x * BOARD_SIZE + y); 吃不掉或读不清时返回 0
+int tacticsCapture(GameState* gs, int x, int y, int nodeLimit, int* move) {
+    *move = -1;
+    if (x < 0 || x >= gs->size || y < 0 || y >= gs->size) return 0;
+    int p = PAD_INDEX(x, y);
+    int color = gs->cells[p];
+    if ((color != BLACK && color != WHITE) || color == gs->currentPlayer) return 0;
+
+    unsigned long long key = cacheKey(gs, p, TACTICS_QUERY_CAPTURE);
+    TacticsEntry* entry = &cache[key & ((1 << TACTICS_CACHE_BITS) - 1)];
+    if (entry->used && entry->key == key) {
+        *move = entry->move;
+        return entry->result;
+    }
+
+    TacticsReader reader = { 0, nodeLimit, 0 };
+    int lastCaptureCount = gs->lastCaptureCount;
+    int first;
+    int result = attack(&reader, gs, p, 0, &first);
+    gs->lastCaptureCount = lastCaptureCount;
+    if (result) *move = boardTables.denseOf[first];
+
+    if (!reader.aborted) {
+        entry->key = key;
+        entry->move = (short)*move;
+        entry->result = (unsigned char)result;
+        entry->used = 1;
+    }
+    return result;
+}
+
+// (x, y)处走子方的棋串能否救活: 对方先走也提不掉时返回 1 且 move 为 -1;
+// 需要走一手时返回 1, move 为救棋的一手; 怎么走都会被提掉时返回 0; 不是走子方的棋子时返回 1
+int tacticsRescue(GameState* gs, int x, int y, int nodeLimit, int* move) {
+    *move = -1;
+    if (x < 0 || x >= gs->size || y < 0 || y >= gs->size) return 1;
+    int p = PAD_INDEX(x, y);
+    int color = gs->cells[p];
+    if (color != gs->currentPlayer) return 1;
+
+    unsigned long long key = cacheKey(gs, p, TACTICS_QUERY_RESCUE);
+    TacticsEntry* entry = &cache[key & ((1 << TACTICS_CACHE_BITS) - 1)];
+    if (entry->used && entry->key == key) {
+        *move = entry->move;
+        return entry->result;
+    }
+
+    TacticsReader reader = { 0, nodeLimit, 0 };
+    int lastCaptureCount = gs->lastCaptureCount;
+    int koPoint = gs->koPoint;
+
+    // 先让对方先走: 提不掉就不用救
+    gs->currentPlayer = (color == BLACK) ? WHITE : BLACK;
+    gs->koPoint = -1;
+    int first;
+    int threatened = attack(&reader, gs, p, 0, &first);
+    gs->currentPlayer = color;
+    gs->koPoint = koPoint;
+
+    int result = 1;
+    if (threatened) {
+        int save;
+        result = defend(&reader, gs, p, 0, &save);
+        if (result && save >= 0) *move = boardTables.denseOf[save];
+    }
+    gs->lastCaptureCount = lastCaptureCount;
+
+    if (!reader.aborted) {
+        entry->key = key;
+        entry->move = (short)*move;
+        entry->result = (unsigned char)result;
+        entry->used = 1;
+    }
+    return result;
+}
+
+// (x, y)处棋串的气数, 超过 max 时只返回 max + 1; 比 stateLiberties 快, 用于挑出需要读秒的棋串
+int tacticsLiberties(const GameState* gs, int x, int y, int max) {
+    int p = PAD_INDEX(x, y);
+    if (gs->cells[p] != BLACK && gs->cells[p] != WHITE) return 0;
+    int libs[TACTICS_MAX_LIBS + 1];
+    if (max > TACTICS_MAX_LIBS) max = TACTICS_MAX_LIBS;
+    return chainLiberties(gs, p, libs, max);
+}
+
+// 清空本线程的缓存(测速用)
+void tacticsClearCache() {
+    memset(cache, 0, sizeof(cache));
+}
\ No newline at end of file
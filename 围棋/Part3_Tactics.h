@@ -0,0 +1,25 @@
+/*
+ * 围棋游戏系统 - Part 3: 征子与对杀读秒
+ * 负责人: 2518801370 李卓洵
+ * 包含: 有限深度的吃子/逃子搜索(征子、枷吃、两三口气的对杀), 结果按局面哈希缓存
+ * 说明: 不依赖 EasyX; 直接在传入的局面上落子、撤销, 返回时局面与调用前相同, 不复制局面;
+ *       缓存每个线程各一份, 启发式评分、模拟的走子策略和提示都可以调用
+ */
+
+#ifndef PART3_TACTICS_H
+#define PART3_TACTICS_H
+
+#include "Part1_Rules.h"
+
+#define TACTICS_MAX_LIBS 3         // 只读不超过这么多口气的棋串; 逃子方长出后气数达到此值就算逃出
+#define TACTICS_MAX_DEPTH 80       // 最多读多少手, 足够一条征子从一角走到另一角
+#define TACTICS_CACHE_BITS 14      // 缓存 2^14 项, 直接映射
+#define TACTICS_DEFAULT_NODES 2000 // 提示和启发式评分每次读的局面数上限
+#define TACTICS_PLAYOUT_NODES 100  // 随机对局中每次读的局面数上限
+
+int tacticsCapture(GameState* gs, int x, int y, int nodeLimit, int* move);
+int tacticsRescue(GameState* gs, int x, int y, int nodeLimit, int* move);
+int tacticsLiberties(const GameState* gs, int x, int y, int max);
+void tacticsClearCache();
+
+#endif // PART3_TACTICS_H
\ No newline at end of file
@@ -0,0 +1,482 @@
+/*
+ * 围棋游戏系统 - Part 4: 规则与 AI 性能测试程序
+ * 负责人: 251880107 马耀宗
+ * 用法: go_bench [--reps 轮数] [--ai-playouts 每步模拟次数] [--only 项目名] [--json 输出文件] [--size 棋盘路数]
+ * 在固定的局面集上测量界面各操作背后的引擎函数, 每项打印每次操作的纳秒数(中位数、99 分位、平均、最小):
+ *   is_valid_move        isValidMove: 中盘和对杀局面的全部交叉点
+ *   place_stone          placeStone: 随机整局从头重放
+ *   place_stone_capture  placeStone: 对杀局面中所有提子的着法, 以及重放中提了子的着法
+ *   undo_move            undoMove: 把重放的整局逐手悔回
+ *   count_territory      逐块调用 stateCountTerritory 数子数地(原 calculateScore 的做法)
+ *   score_area           stateAreaScore: calculateScore 和模拟终局共用的 Tromp-Taylor 数子
+ *   hint_move            getHintMove: 被围住的棋块的死活急所和整盘启发式选点
+ *   ladder_read          tacticsCapture/tacticsRescue: 两类局面中气不多于两口的每个棋串, 清空缓存后读一次
+ *   feature_encode       featuresEncode: 两类局面各按 8 种对称变换编码网络输入, 每次操作为一次编码
+ *   get_ai_move          getAIMove: 单线程树搜索(固定种子)
+ *   ownership_update     每手之后刷新形势判断: 保留上一手的样本, 单线程再做 BENCH_OWNERSHIP_PLAYOUTS 次模拟
+ * 局面集由固定种子生成, 每次运行都相同; 第一轮只热身不计入; 小棋盘的取样手数按面积缩小
+ */
+
+#include "Part3_MCTS.h"
+#include "Part3_Heuristic.h"
+#include "Part3_Features.h"
+#include "Part3_Ownership.h"
+#include "Part3_Tactics.h"
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#define BENCH_GAMES 8          // 随机整局数
+#define BENCH_SEEDS 4          // 每类局面用几个种子
+#define BENCH_SNAPSHOTS 3      // 每局取几个局面
+#define BENCH_POSITIONS (BENCH_SEEDS * BENCH_SNAPSHOTS)
+#define BENCH_OWNERSHIP_PLAYOUTS 200
+
+static const int midGameMoves[BENCH_SNAPSHOTS] = { 60, 100, 140 };
+static const int captureMoves[BENCH_SNAPSHOTS] = { 80, 120, 160 };
+
+// 固定的测试数据
+static Position midGame[BENCH_POSITIONS];
+static Position captureHeavy[BENCH_POSITIONS];
+static short gameMoves[BENCH_GAMES][MAX_HISTORY];
+static int gameLength[BENCH_GAMES];
+
+// 一项测试的全部样本(每个样本是一次或一批操作的平均纳秒数)
+typedef struct {
+    const char* name;
+    std::vector<double> samples;
+    long long ops;
+} BenchResult;
+
+static int boardSize = BOARD_SIZE;  // 局面集的棋盘路数
+static double timerOverhead = 0.0; // 一对 now() 本身的耗时, 逐次计时的样本中扣除
+static volatile long long sink;    // 防止结果被优化掉
+
+static unsigned int nextRandom(unsigned int* seed) {
+    *seed = *seed * 1103515245u + 12345u;
+    return *seed >> 8;
+}
+
+static double elapsedNs(std::chrono::steady_clock::time_point t0, std::chrono::steady_clock::time_point t1) {
+    return std::chrono::duration<double, std::nano>(t1 - t0).count();
+}
+
+// 四周都是己方棋子(或棋盘边)的空点, 随机对局中不填
+static int isOwnEye(const GameState* gs, int x, int y, int color) {
+    static const int dx[4] = { -1, 1, 0, 0 };
+    static const int dy[4] = { 0, 0, -1, 1 };
+    for (int d = 0; d < 4; d++) {
+        int nx = x + dx[d], ny = y + dy[d];
+        if (nx < 0 || nx >= boardSize || ny < 0 || ny >= boardSize) continue;
+        if (gs->board[nx][ny] != color) return 0;
+    }
+    return 1;
+}
+
+// 紧挨着气不多于两口的对方棋串(对杀中的着法)
+static int touchesWeakChain(const GameState* gs, int x, int y, int color) {
+    static const int dx[4] = { -1, 1, 0, 0 };
+    static const int dy[4] = { 0, 0, -1, 1 };
+    int opponent = color == BLACK ? WHITE : BLACK;
+    for (int d = 0; d < 4; d++) {
+        int nx = x + dx[d], ny = y + dy[d];
+        if (nx < 0 || nx >= boardSize || ny < 0 || ny >= boardSize) continue;
+        if (gs->board[nx][ny] == opponent && stateLiberties(gs, nx, ny) <= 2) return 1;
+    }
+    return 0;
+}
+
+// 选一手: fight 非 0 时优先提子, 其次走在对方弱棋旁边; 没有可下的点返回 -1
+static int chooseMove(const Position* pos, unsigned int* seed, int fight) {
+    const GameState* gs = &pos->state;
+    int legal[MAX_POINTS], captures[MAX_POINTS], attacks[MAX_POINTS];
+    int legalCount = 0, captureCount = 0, attackCount = 0;
+
+    for (int p = 0; p < MAX_POINTS; p++) {
+        int x = p / BOARD_SIZE, y = p % BOARD_SIZE;
+        if (x >= boardSize || y >= boardSize) continue;
+        if (gs->board[x][y] != EMPTY || isOwnEye(gs, x, y, gs->currentPlayer)) continue;
+        if (!posIsLegal(pos, x, y)) continue;
+        legal[legalCount++] = p;
+        if (!fight) continue;
+        if (stateCaptureSize(gs, x, y, gs->currentPlayer) > 0) captures[captureCount++] = p;
+        else if (touchesWeakChain(gs, x, y, gs->currentPlayer)) attacks[attackCount++] = p;
+    }
+    if (legalCount == 0) return -1;
+
+    unsigned int r = nextRandom(seed);
+    if (captureCount > 0 && r % 10 < 9) return captures[nextRandom(seed) % captureCount];
+    if (attackCount > 0 && r % 10 < 6) return attacks[nextRandom(seed) % attackCount];
+    return legal[nextRandom(seed) % legalCount];
+}
+
+// 生成局面集和整局棋谱
+static void buildCorpus() {
+    for (int s = 0; s < BENCH_SEEDS; s++) {
+        Position pos;
+        unsigned int seed = 1000u + s * 7919u;
+        posInit(&pos, boardSize);
+        for (int k = 0; k < BENCH_SNAPSHOTS; k++) {
+            while (pos.historyCount < midGameMoves[k] * boardSize * boardSize / MAX_POINTS) {
+                int p = chooseMove(&pos, &seed, 0);
+                if (p < 0) break;
+                posMakeMove(&pos, p / BOARD_SIZE, p % BOARD_SIZE);
+            }
+            midGame[s * BENCH_SNAPSHOTS + k] = pos;
+        }
+
+        seed = 5000u + s * 104729u;
+        posInit(&pos, boardSize);
+        for (int k = 0; k < BENCH_SNAPSHOTS; k++) {
+            while (pos.historyCount < captureMoves[k] * boardSize * boardSize / MAX_POINTS) {
+                int p = chooseMove(&pos, &seed, 1);
+                if (p < 0) break;
+                posMakeMove(&pos, p / BOARD_SIZE, p % BOARD_SIZE);
+            }
+            captureHeavy[s * BENCH_SNAPSHOTS + k] = pos;
+        }
+    }
+
+    for (int g = 0; g < BENCH_GAMES; g++) {
+        Position pos;
+        unsigned int seed = 90000u + g * 31337u;
+        posInit(&pos, boardSize);
+        gameLength[g] = 0;
+        while (pos.historyCount < MAX_HISTORY - 1) {
+            int p = chooseMove(&pos, &seed, g % 2);
+            if (p < 0) break;
+            posMakeMove(&pos, p / BOARD_SIZE, p % BOARD_SIZE);
+            gameMoves[g][gameLength[g]++] = (short)p;
+        }
+    }
+}
+
+// 一对 now() 的耗时取中位数
+static void calibrateTimer() {
+    std::vector<double> pairs;
+    for (int i = 0; i < 10000; i++) {
+        auto t0 = std::chrono::steady_clock::now();
+        auto t1 = std::chrono::steady_clock::now();
+        pairs.push_back(elapsedNs(t0, t1));
+    }
+    std::sort(pairs.begin(), pairs.end());
+    timerOverhead = pairs[pairs.size() / 2];
+}
+
+// 记一个样本: elapsed 为 ops 次操作的总耗时, timedOnce 表示这一次计时只包了一次操作
+static void addSample(BenchResult* result, double elapsed, int ops, int timedOnce) {
+    if (timedOnce) elapsed -= timerOverhead;
+    if (elapsed < 0.0) elapsed = 0.0;
+    result->samples.push_back(elapsed / ops);
+    result->ops += ops;
+}
+
+// is_valid_move: 每个局面检查全部交叉点算一个样本
+static void benchIsValidMove(BenchResult* result, int record) {
+    const Position* sets[2] = { midGame, captureHeavy };
+    for (int k = 0; k < 2; k++) {
+        for (int i = 0; i < BENCH_POSITIONS; i++) {
+            const Position* pos = &sets[k][i];
+            long long legal = 0;
+            auto t0 = std::chrono::steady_clock::now();
+            for (int x = 0; x < boardSize; x++) {
+                for (int y = 0; y < boardSize; y++) legal += posIsLegal(pos, x, y);
+            }
+            auto t1 = std::chrono::steady_clock::now();
+            sink += legal;
+            if (record) addSample(result, elapsedNs(t0, t1), boardSize * boardSize, 0);
+        }
+    }
+}
+
+// place_stone 和 undo_move: 整局逐手重放再逐手悔回, 每手单独计时; 提了子的着法同时计入 place_stone_capture
+static void benchReplay(BenchResult* place, BenchResult* capture, BenchResult* undo, int record) {
+    static Position pos;
+    for (int g = 0; g < BENCH_GAMES; g++) {
+        posInit(&pos, boardSize);
+        for (int i = 0; i < gameLength[g]; i++) {
+            int p = gameMoves[g][i];
+            auto t0 = std::chrono::steady_clock::now();
+            int ok = posMakeMove(&pos, p / BOARD_SIZE, p % BOARD_SIZE);
+            auto t1 = std::chrono::steady_clock::now();
+            sink += ok;
+            if (!record) continue;
+            addSample(place, elapsedNs(t0, t1), 1, 1);
+            if (ok && pos.history[pos.historyCount - 1].capturedStones > 0) {
+                addSample(capture, elapsedNs(t0, t1), 1, 1);
+            }
+        }
+        while (pos.historyCount > 0) {
+            auto t0 = std::chrono::steady_clock::now();
+            int ok = posUnmakeMove(&pos);
+            auto t1 = std::chrono::steady_clock::now();
+            sink += ok;
+            if (record) addSample(undo, elapsedNs(t0, t1), 1, 1);
+        }
+    }
+}
+
+// place_stone_capture: 对杀局面中每个提子着法落下(计时)再悔回(不计时)
+static void benchCaptures(BenchResult* result, int record) {
+    static Position pos;
+    for (int i = 0; i < BENCH_POSITIONS; i++) {
+        pos = captureHeavy[i];
+        const GameState* gs = &pos.state;
+        for (int p = 0; p < MAX_POINTS; p++) {
+            int x = p / BOARD_SIZE, y = p % BOARD_SIZE;
+            if (gs->board[x][y] != EMPTY || !posIsLegal(&pos, x, y)) continue;
+            if (stateCaptureSize(gs, x, y, gs->currentPlayer) == 0) continue;
+
+            auto t0 = std::chrono::steady_clock::now();
+            int ok = posMakeMove(&pos, x, y);
+            auto t1 = std::chrono::steady_clock::now();
+            if (record) addSample(result, elapsedNs(t0, t1), 1, 1);
+            if (ok) posUnmakeMove(&pos);
+        }
+    }
+}
+
+// count_territory: 逐块洪泛的数子数地, 与 score_area 对照
+static int countScore(const GameState* gs) {
+    int blackStones = 0, whiteStones = 0;
+    int blackTerritory = 0, whiteTerritory = 0;
+    int visited[BOARD_SIZE][BOARD_SIZE] = { 0 };
+
+    for (int i = 0; i < gs->size; i++) {
+        for (int j = 0; j < gs->size; j++) {
+            if (gs->board[i][j] == BLACK) blackStones++;
+            else if (gs->board[i][j] == WHITE) whiteStones++;
+        }
+    }
+    for (int i = 0; i < gs->size; i++) {
+        for (int j = 0; j < gs->size; j++) {
+            if (gs->board[i][j] == EMPTY && !visited[i][j]) {
+                int owner = EMPTY;
+                int territory = stateCountTerritory(gs, i, j, &owner, visited);
+                if (owner == BLACK) blackTerritory += territory;
+                else if (owner == WHITE) whiteTerritory += territory;
+            }
+        }
+    }
+    return blackStones + blackTerritory - whiteStones - whiteTerritory;
+}
+
+// 按局面计时的几项: count_territory、score_area、hint_move
+static void benchPerPosition(BenchResult* territory, BenchResult* area, BenchResult* hint, int record) {
+    const Position* sets[2] = { midGame, captureHeavy };
+    for (int k = 0; k < 2; k++) {
+        for (int i = 0; i < BENCH_POSITIONS; i++) {
+            const Position* pos = &sets[k][i];
+            int x, y;
+
+            auto t0 = std::chrono::steady_clock::now();
+            sink += countScore(&pos->state);
+            auto t1 = std::chrono::steady_clock::now();
+            sink += (long long)stateAreaScore(&pos->state, 7.5f, NULL);
+            auto t2 = std::chrono::steady_clock::now();
+            heuristicBestMove(pos, 2, &x, &y);
+            auto t3 = std::chrono::steady_clock::now();
+            sink += x * BOARD_SIZE + y;
+
+            if (record) {
+                addSample(territory, elapsedNs(t0, t1), 1, 1);
+                addSample(area, elapsedNs(t1, t2), 1, 1);
+                addSample(hint, elapsedNs(t2, t3), 1, 1);
+            }
+        }
+    }
+}
+
+// ladder_read: 对方的棋串读能否吃掉, 己方的读能否救出; 每次先清空缓存, 量的是真正读秒的时间
+static void benchLadders(BenchResult* result, int record) {
+    const Position* sets[2] = { midGame, captureHeavy };
+    for (int k = 0; k < 2; k++) {
+        for (int i = 0; i < BENCH_POSITIONS; i++) {
+            GameState gs = sets[k][i].state;
+            for (int x = 0; x < boardSize; x++) {
+                for (int y = 0; y < boardSize; y++) {
+                    int p = PAD_INDEX(x, y);
+                    if (gs.board[x][y] == EMPTY || gs.chainHead[p] != p) continue;
+                    if (tacticsLiberties(&gs, x, y, 2) > 2) continue;
+
+                    int move;
+                    tacticsClearCache();
+                    auto t0 = std::chrono::steady_clock::now();
+                    if (gs.board[x][y] == gs.currentPlayer) sink += tacticsRescue(&gs, x, y, TACTICS_DEFAULT_NODES, &move);
+                    else sink += tacticsCapture(&gs, x, y, TACTICS_DEFAULT_NODES, &move);
+                    auto t1 = std::chrono::steady_clock::now();
+                    sink += move;
+                    if (record) addSample(result, elapsedNs(t0, t1), 1, 1);
+                }
+            }
+        }
+    }
+}
+
+// feature_encode: 每个局面连续编码 8 种对称变换算一个样本, 与自对弈数据增强时的用法相同
+static void benchFeatures(BenchResult* result, int record) {
+    const Position* sets[2] = { midGame, captureHeavy };
+    float* planes = featuresAlloc(FEATURE_SYMMETRIES, boardSize);
+    size_t stride = (size_t)FEATURE_PLANES * boardSize * boardSize;
+    for (int k = 0; k < 2; k++) {
+        for (int i = 0; i < BENCH_POSITIONS; i++) {
+            short recent[FEATURE_HISTORY];
+            featuresRecentMoves(&sets[k][i], recent);
+            auto t0 = std::chrono::steady_clock::now();
+            for (int sym = 0; sym < FEATURE_SYMMETRIES; sym++) {
+                featuresEncode(&sets[k][i].state, recent, sym, planes + sym * stride);
+            }
+            auto t1 = std::chrono::steady_clock::now();
+            sink += (long long)planes[stride - 1];
+            if (record) addSample(result, elapsedNs(t0, t1), FEATURE_SYMMETRIES, 0);
+        }
+    }
+    featuresFree(planes);
+}
+
+// get_ai_move: 中盘局面上单线程、固定种子的树搜索
+static void benchAIMove(BenchResult* result, int playouts, int record) {
+    for (int i = 0; i < BENCH_POSITIONS; i++) {
+        MctsParams params;
+        mctsDefaultParams(&params);
+        params.maxPlayouts = playouts;
+        params.seed = 777u + i;
+        params.rootPosition = &midGame[i];
+
+        MctsResult search;
+        auto t0 = std::chrono::steady_clock::now();
+        mctsSearch(&midGame[i].state, &params, &search);
+        auto t1 = std::chrono::steady_clock::now();
+        sink += search.bestX;
+        if (record) addSample(result, elapsedNs(t0, t1), 1, 1);
+    }
+}
+
+// ownership_update: 中盘局面先估计一次, 再下一手后刷新, 只计刷新的时间
+static void benchOwnership(BenchResult* result, int record) {
+    static OwnershipMap map;
+    for (int i = 0; i < BENCH_POSITIONS; i++) {
+        Position pos = midGame[i];
+        unsigned int seed = 4321u + i;
+        ownershipReset(&map);
+        ownershipUpdate(&map, &pos.state, 7.5f, BENCH_OWNERSHIP_PLAYOUTS, 1, seed);
+
+        int p = chooseMove(&pos, &seed, 0);
+        if (p < 0) continue;
+        posMakeMove(&pos, p / BOARD_SIZE, p % BOARD_SIZE);
+        auto t0 = std::chrono::steady_clock::now();
+        ownershipUpdate(&map, &pos.state, 7.5f, BENCH_OWNERSHIP_PLAYOUTS, 1, seed);
+        auto t1 = std::chrono::steady_clock::now();
+        sink += map.deadBlack + map.reused;
+        if (record) addSample(result, elapsedNs(t0, t1), 1, 1);
+    }
+}
+
+static double percentile(const std::vector<double>& sorted, int pct) {
+    size_t index = sorted.size() * pct / 100;
+    if (index >= sorted.size()) index = sorted.size() - 1;
+    return sorted[index];
+}
+
+int main(int argc, char* argv[]) {
+    int reps = 5;
+    int aiPlayouts = 1000;
+    const char* only = NULL;
+    const char* jsonFile = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--reps") == 0 && i + 1 < argc) reps = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--ai-playouts") == 0 && i + 1 < argc) aiPlayouts = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--only") == 0 && i + 1 < argc) only = argv[++i];
+        else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) jsonFile = argv[++i];
+        else if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) boardSize = atoi(argv[++i]);
+        else {
+            printf("usage: go_bench [--reps N] [--ai-playouts N] [--only NAME] [--json FILE] [--size 9|13|19]\n");
+            return 1;
+        }
+    }
+    if (reps < 1) reps = 1;
+    if (boardSize != 9 && boardSize != 13 && boardSize != 19) {
+        printf("unsupported board size %d\n", boardSize);
+        return 1;
+    }
+
+    buildCorpus();
+    calibrateTimer();
+
+    enum { IS_VALID, PLACE, PLACE_CAPTURE, UNDO, TERRITORY, AREA, HINT, LADDER, FEATURES, AI_MOVE, OWNERSHIP, BENCH_COUNT };
+    BenchResult results[BENCH_COUNT];
+    const char* names[BENCH_COUNT] = {
+        "is_valid_move", "place_stone", "place_stone_capture", "undo_move",
+        "count_territory", "score_area", "hint_move", "ladder_read", "feature_encode", "get_ai_move", "ownership_update"
+    };
+    for (int i = 0; i < BENCH_COUNT; i++) {
+        results[i].name = names[i];
+        results[i].ops = 0;
+    }
+    #define BENCH_SELECTED(name) (only == NULL || strcmp(only, name) == 0)
+
+    // 第 0 轮热身, 不记样本; 树搜索和形势判断很慢, 只跑一轮
+    for (int round = 0; round <= reps; round++) {
+        int record = round > 0;
+        if (BENCH_SELECTED("is_valid_move")) benchIsValidMove(&results[IS_VALID], record);
+        if (BENCH_SELECTED("place_stone") || BENCH_SELECTED("place_stone_capture") || BENCH_SELECTED("undo_move")) {
+            benchReplay(&results[PLACE], &results[PLACE_CAPTURE], &results[UNDO], record);
+        }
+        if (BENCH_SELECTED("place_stone_capture")) benchCaptures(&results[PLACE_CAPTURE], record);
+        if (BENCH_SELECTED("count_territory") || BENCH_SELECTED("score_area") || BENCH_SELECTED("hint_move")) {
+            benchPerPosition(&results[TERRITORY], &results[AREA], &results[HINT], record);
+        }
+        if (BENCH_SELECTED("ladder_read")) benchLadders(&results[LADDER], record);
+        if (BENCH_SELECTED("feature_encode")) benchFeatures(&results[FEATURES], record);
+    }
+    if (aiPlayouts > 0 && BENCH_SELECTED("get_ai_move")) benchAIMove(&results[AI_MOVE], aiPlayouts, 1);
+    if (BENCH_SELECTED("ownership_update")) benchOwnership(&results[OWNERSHIP], 1);
+
+    int totalMoves = 0;
+    for (int g = 0; g < BENCH_GAMES; g++) totalMoves += gameLength[g];
+    printf("corpus: %dx%d, %d mid-game + %d capture-heavy positions, %d games (%d moves); %d rounds, timer overhead %.0f ns\n",
+        boardSize, boardSize, BENCH_POSITIONS, BENCH_POSITIONS, BENCH_GAMES, totalMoves, reps, timerOverhead);
+    printf("%-20s %9s %12s %12s %12s %12s\n", "benchmark", "samples", "median ns", "p99 ns", "mean ns", "min ns");
+
+    FILE* json = NULL;
+    if (jsonFile != NULL) {
+        json = fopen(jsonFile, "w");
+        if (json == NULL) {
+            printf("cannot write %s\n", jsonFile);
+            return 1;
+        }
+        fprintf(json, "{\n  \"benchmark\": \"go_bench\",\n  \"version\": 1,\n");
+        fprintf(json, "  \"board_size\": %d,\n", boardSize);
+        fprintf(json, "  \"reps\": %d,\n  \"ai_playouts\": %d,\n  \"timer_overhead_ns\": %.1f,\n", reps, aiPlayouts, timerOverhead);
+        fprintf(json, "  \"corpus\": { \"mid_game\": %d, \"capture_heavy\": %d, \"games\": %d, \"game_moves\": %d },\n",
+            BENCH_POSITIONS, BENCH_POSITIONS, BENCH_GAMES, totalMoves);
+        fprintf(json, "  \"results\": [");
+    }
+
+    int written = 0;
+    for (int i = 0; i < BENCH_COUNT; i++) {
+        std::vector<double>& samples = results[i].samples;
+        if (samples.empty() || !BENCH_SELECTED(results[i].name)) continue;
+        std::sort(samples.begin(), samples.end());
+        double total = 0.0;
+        for (size_t k = 0; k < samples.size(); k++) total += samples[k];
+        double median = percentile(samples, 50);
+        double p99 = percentile(samples, 99);
+        double mean = total / samples.size();
+
+        printf("%-20s %9zu %12.1f %12.1f %12.1f %12.1f\n", results[i].name, samples.size(), median, p99, mean, samples[0]);
+        if (json != NULL) {
+            fprintf(json, "%s\n    { \"name\": \"%s\", \"unit\": \"ns/op\", \"samples\": %zu, \"ops\": %lld, "
+                "\"median\": %.1f, \"p99\": %.1f, \"mean\": %.1f, \"min\": %.1f }",
+                written > 0 ? "," : "", results[i].name, samples.size(), results[i].ops, median, p99, mean, samples[0]);
+        }
+        written++;
+    }
+
+    if (json != NULL) {
+        fprintf(json, "\n  ]\n}\n");
+        fclose(json);
+    }
+    return 0;
+}
\ No newline at end of file